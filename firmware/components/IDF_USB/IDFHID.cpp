@@ -15,8 +15,22 @@
 
 
 #include "IDFHID.h"
+#include <atomic>
+
+static const char* TAG = "IDFHID";
+
+// One transmit FIFO per HID interface. Whoever holds `busy` owns the endpoint: it is
+// set when a report is handed to TinyUSB and cleared by the report-complete callback.
+typedef struct {
+  QueueHandle_t queue;
+  std::atomic<bool> busy;
+  bool haveHead;                // head was dequeued but the endpoint refused it
+  hid_queued_report_t head;
+  std::atomic<uint32_t> dropped;
+} hid_report_fifo_t;
+
+static hid_report_fifo_t report_fifos[IDFHID_MAX_INTERFACES];
 
-SemaphoreHandle_t IDFHID::tinyusb_hid_device_input_sem = nullptr;
 static hid_interface_protocol_enum_t tinyusb_interface_protocol = HID_ITF_PROTOCOL_NONE;
 #if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
 static const char *tinyusb_hid_device_report_types[4] = {"INVALID", "INPUT", "OUTPUT", "FEATURE"};
@@ -31,27 +45,18 @@ IDFHID::IDFHID(uint8_t itf) {
   }
 }
 
-bool IDFHID::lock(){
-  while(!ready() && (xSemaphoreTake(tinyusb_hid_device_input_sem, pdMS_TO_TICKS(5) != pdTRUE))){
-    tud_task();
-  }
-  return true;
-}
-
-bool IDFHID::unlock(){
-  return xSemaphoreGive(tinyusb_hid_device_input_sem);
-}
-
 void IDFHID::begin() {
-  if (tinyusb_hid_device_input_sem == NULL) {
-    tinyusb_hid_device_input_sem = xSemaphoreCreateBinary();
+  if (itf < IDFHID_MAX_INTERFACES && report_fifos[itf].queue == NULL) {
+    report_fifos[itf].queue = xQueueCreate(IDFHID_FIFO_DEPTH, sizeof(hid_queued_report_t));
   }
 }
 
 void IDFHID::end() {
-  if (tinyusb_hid_device_input_sem != NULL) {
-    vSemaphoreDelete(tinyusb_hid_device_input_sem);
-    tinyusb_hid_device_input_sem = NULL;
+  if (itf < IDFHID_MAX_INTERFACES && report_fifos[itf].queue != NULL) {
+    vQueueDelete(report_fifos[itf].queue);
+    report_fifos[itf].queue = NULL;
+    report_fifos[itf].haveHead = false;
+    report_fifos[itf].busy = false;
   }
 }
 
@@ -59,16 +64,89 @@ bool IDFHID::ready() {
   return tud_hid_n_ready(itf);
 }
 
+size_t IDFHID::pending() {
+  if (itf >= IDFHID_MAX_INTERFACES || report_fifos[itf].queue == NULL) return 0;
+  return uxQueueMessagesWaiting(report_fifos[itf].queue) + (report_fifos[itf].haveHead ? 1 : 0);
+}
+
+uint32_t IDFHID::dropped() {
+  return (itf < IDFHID_MAX_INTERFACES) ? report_fifos[itf].dropped.load() : 0;
+}
+
+bool IDFHID::waitSent(uint32_t timeout_ms) {
+  if (itf >= IDFHID_MAX_INTERFACES || report_fifos[itf].queue == NULL) return true;
+  TickType_t start = xTaskGetTickCount();
+  while (pending() > 0 || report_fifos[itf].busy) {
+    if (!tud_mounted() || (xTaskGetTickCount() - start) >= pdMS_TO_TICKS(timeout_ms)) return false;
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+void IDFHID::pump(uint8_t itf) {
+  if (itf >= IDFHID_MAX_INTERFACES) return;
+  hid_report_fifo_t& fifo = report_fifos[itf];
+  if (fifo.queue == NULL) return;
+
+  // Two passes close the window where a report lands just after we release `busy`
+  for (int pass = 0; pass < 2; pass++) {
+    bool idle = false;
+    if (!fifo.busy.compare_exchange_strong(idle, true)) return; // In flight; the completion pumps
+
+    if (!fifo.haveHead) {
+      fifo.haveHead = (xQueueReceive(fifo.queue, &fifo.head, 0) == pdTRUE);
+    }
+    if (fifo.haveHead && tud_hid_n_ready(itf) && tud_hid_n_report(itf, fifo.head.id, fifo.head.data, fifo.head.len)) {
+      fifo.haveHead = false;
+      return; // Stays busy until tud_hid_report_complete_cb
+    }
+
+    fifo.busy = false;
+    if (!tud_hid_n_ready(itf) || (!fifo.haveHead && uxQueueMessagesWaiting(fifo.queue) == 0)) return;
+  }
+}
+
+bool IDFHID::SendReport(uint8_t id, const void *data, size_t len, uint32_t timeout_ms) {
+  if (itf >= IDFHID_MAX_INTERFACES || report_fifos[itf].queue == NULL || len > IDFHID_REPORT_MAX) return false;
+  hid_report_fifo_t& fifo = report_fifos[itf];
+
+  // Nobody is polling: drop rather than replay stale input when the host appears
+  if (!tud_mounted() || tud_suspended()) {
+    fifo.dropped++;
+    return false;
+  }
 
-bool IDFHID::SendReport(uint8_t id, const void *data, size_t len, uint32_t timeout_ms) {  
   // If we're configured to support boot protocol, and the host has requested boot protocol, prevent
   // sending of report ID, by passing report ID of 0 to tud_hid_n_report().
-  lock();
   // TODO: effective_id is computed but never forwarded — tud_hid_n_report always
   // receives 0 here. Boot-protocol ID suppression is currently a no-op.
   uint8_t effective_id = ((tinyusb_interface_protocol != HID_ITF_PROTOCOL_NONE) && (tud_hid_n_get_protocol(itf) == HID_PROTOCOL_BOOT)) ? 0 : id;
   (void)effective_id;
 
-  return tud_hid_n_report(itf, 0, data, len);
+  hid_queued_report_t report;
+  report.id = 0;
+  report.len = (uint8_t)len;
+  memcpy(report.data, data, len);
+
+  // Bounded wait: retry in 1 ms slices (the interface's bInterval), kicking the FIFO each
+  // time in case the endpoint went idle while it was full
+  TickType_t start = xTaskGetTickCount();
+  while (xQueueSend(fifo.queue, &report, pdMS_TO_TICKS(1)) != pdTRUE) {
+    pump(itf);
+    if ((xTaskGetTickCount() - start) >= pdMS_TO_TICKS(timeout_ms)) {
+      uint32_t total = ++fifo.dropped;
+      ESP_LOGW(TAG, "Interface %u FIFO full for %lu ms, dropping report (%lu dropped)", itf, timeout_ms, total);
+      return false;
+    }
+  }
 
-}
\ No newline at end of file
+  pump(itf);
+  return true;
+}
+
+// Callback triggered by TinyUSB once the host has read the current report on `instance`
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len) {
+  if (instance >= IDFHID_MAX_INTERFACES) return;
+  report_fifos[instance].busy = false;
+  IDFHID::pump(instance);
+}
@@ -33,6 +33,18 @@ enum {
   HID_REPORT_ID_VENDOR
 };
 
+// Per-interface transmit FIFO. SendReport() queues; the next report goes out from
+// tud_hid_report_complete_cb() once the host has taken the previous one.
+#define IDFHID_MAX_INTERFACES   4
+#define IDFHID_FIFO_DEPTH       16
+#define IDFHID_REPORT_MAX       64
+
+typedef struct {
+  uint8_t id;
+  uint8_t len;
+  uint8_t data[IDFHID_REPORT_MAX];
+} hid_queued_report_t;
+
 typedef struct {
   uint8_t instance;
   union {
@@ -46,18 +58,33 @@ typedef struct {
 } arduino_usb_hid_event_data_t;
 
 // Base class for all HID device types.
-// Provides USB transport (begin/end/lock/unlock/SendReport) and virtual hooks
-// for TinyUSB descriptor and feature callbacks. Subclass and override as needed.
+// Provides USB transport (begin/end/SendReport) and virtual hooks for TinyUSB
+// descriptor and feature callbacks. Subclass and override as needed.
 class IDFHID {
 public:
   IDFHID(uint8_t itf = 0);
   void begin(void);
   void end(void);
-  bool lock();
-  bool unlock();
   bool ready(void);
+  uint8_t interface(void) const { return itf; }
+
+  // Queue a report for this interface. Returns immediately while the FIFO has room;
+  // otherwise waits up to timeout_ms for the host to drain it, then drops the report.
+  // Reports are also dropped while the device is not mounted.
   bool SendReport(uint8_t report_id, const void *data, size_t len, uint32_t timeout_ms = 100);
 
+  // Reports currently waiting in this interface's FIFO, and reports dropped so far
+  size_t pending(void);
+  uint32_t dropped(void);
+
+  // Block until the host has read every report queued on this interface, polling once
+  // per tick. Returns false on timeout.
+  bool waitSent(uint32_t timeout_ms = 100);
+
+  // Start the next queued report if the interface is idle. Called from SendReport()
+  // and from tud_hid_report_complete_cb() on the TinyUSB task.
+  static void pump(uint8_t itf);
+
   virtual uint16_t _onGetDescriptor(uint8_t *buffer) { return 0; }
   virtual uint16_t _onGetFeature(uint8_t report_id, uint8_t *buffer, uint16_t len) { return 0; }
   virtual void _onSetFeature(uint8_t report_id, const uint8_t *buffer, uint16_t len) {}
@@ -65,9 +92,6 @@ public:
 
 protected:
   uint8_t itf;
-
-private:
-  static SemaphoreHandle_t tinyusb_hid_device_input_sem;
 };
 
 // Legacy pure-virtual interface retained for USBHIDGamepad and USBHIDVendor which
@@ -25,13 +25,22 @@
 
 const uint8_t report_descriptor[] = {TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(HID_REPORT_ID_KEYBOARD))};
 
-IDFHIDKeyboard::IDFHIDKeyboard(uint8_t itf) : IDFHID(itf), _asciimap(KeyboardLayout_en_US), shiftKeyReports(false) {}
+IDFHIDKeyboard::IDFHIDKeyboard(uint8_t itf) : IDFHID(itf), shiftKeyReports(false) {
+  setLayout(KeyboardLayout_en_US);
+}
 
 void IDFHIDKeyboard::begin(const uint8_t *layout) {
-  _asciimap = layout;
+  setLayout(layout);
   IDFHID::begin();
 }
 
+// Switch layouts. Call from the task that types on this keyboard; the table is
+// rewritten in place.
+void IDFHIDKeyboard::setLayout(const uint8_t *layout) {
+  _asciimap = layout;
+  expandKeyboardLayout(layout, _keymap);
+}
+
 
 void IDFHIDKeyboard::end() {}
 
@@ -107,26 +116,17 @@ size_t IDFHIDKeyboard::press(uint8_t k) {
     _keyReport.modifiers |= (1 << (k - 0x80));
     k = 0;
   } else {  // it's a printing key (k is a ASCII 0..127)
-    k = _asciimap[k];
-    if (!k) {
+    KeymapEntry entry = _keymap[k];
+    if (!entry.usage) {
       return 0;
     }
-    if ((k & SHIFT) == SHIFT) {  // it's a capital letter or other character reached with shift
-      // At boot, some PCs need a separate report with the shift key down like a real keyboard.
-      if (shiftKeyReports) {
-        pressRaw(HID_KEY_SHIFT_LEFT);
-      } else {
-        _keyReport.modifiers |= 0x02;  // the left shift modifier
-      }
-      k &= ~SHIFT;
-    }
-    if ((k & ALT_GR) == ALT_GR) {
-      _keyReport.modifiers |= 0x40;  // AltGr = right Alt
-      k &= ~ALT_GR;
-    }
-    if (k == ISO_REPLACEMENT) {
-      k = ISO_KEY;
+    // At boot, some PCs need a separate report with the shift key down like a real keyboard.
+    if ((entry.modifiers & 0x02) && shiftKeyReports) {
+      pressRaw(HID_KEY_SHIFT_LEFT);
+      entry.modifiers &= ~0x02;
     }
+    _keyReport.modifiers |= entry.modifiers;
+    k = entry.usage;
   }
   return pressRaw(k);
 }
@@ -141,25 +141,17 @@ size_t IDFHIDKeyboard::release(uint8_t k) {
     _keyReport.modifiers &= ~(1 << (k - 0x80));
     k = 0;
   } else {  // it's a printing key
-    k = _asciimap[k];
-    if (!k) {
+    KeymapEntry entry = _keymap[k];
+    if (!entry.usage) {
       return 0;
     }
-    if ((k & SHIFT) == SHIFT) {  // it's a capital letter or other character reached with shift
-      if (shiftKeyReports) {
-        releaseRaw(k & 0x7F);    // Release key without shift modifier
-        k = HID_KEY_SHIFT_LEFT;  // Below, release shift modifier
-      } else {
-        _keyReport.modifiers &= ~(0x02);  // the left shift modifier
-        k &= ~SHIFT;
-      }
-    }
-    if ((k & ALT_GR) == ALT_GR) {
-      _keyReport.modifiers &= ~(0x40);  // AltGr = right Alt
-      k &= ~ALT_GR;
-    }
-    if (k == ISO_REPLACEMENT) {
-      k = ISO_KEY;
+    _keyReport.modifiers &= ~(entry.modifiers & ~0x02);  // AltGr
+    if ((entry.modifiers & 0x02) && shiftKeyReports) {
+      releaseRaw(entry.usage);  // Release key without shift modifier
+      k = HID_KEY_SHIFT_LEFT;   // Below, release shift modifier
+    } else {
+      _keyReport.modifiers &= ~(entry.modifiers & 0x02);  // the left shift modifier
+      k = entry.usage;
     }
   }
   return releaseRaw(k);
@@ -197,6 +189,26 @@ size_t IDFHIDKeyboard::write(const uint8_t *buffer, size_t size) {
   return n;
 }
 
+// Resolve one encoded key (ASCII via the layout, 0x80-0x87 modifier, 0x88+ raw usage + 0x88)
+// to a HID usage and the modifier bits it needs. usage is 0 for a bare modifier.
+bool IDFHIDKeyboard::decodeKey(uint8_t k, uint8_t *usage, uint8_t *modifiers) const {
+  *usage = 0;
+
+  if (k >= 0x88) {  // Non-printing key (not a modifier)
+    *usage = k - 0x88;
+  } else if (k >= 0x80) {  // Modifier key
+    *modifiers |= (1 << (k - 0x80));
+  } else {  // Printing key (ASCII 0..127)
+    const KeymapEntry &entry = _keymap[k];
+    if (!entry.usage) {  // No mapping in this layout
+      return false;
+    }
+    *modifiers |= entry.modifiers;
+    *usage = entry.usage;
+  }
+  return true;
+}
+
 size_t IDFHIDKeyboard::sendKeycode(uint8_t* encodedKeys, uint8_t numKeys) {
   customReport.modifiers = 0;
   customReport.reserved = 0;
@@ -204,35 +216,14 @@ size_t IDFHIDKeyboard::sendKeycode(uint8_t* encodedKeys, uint8_t numKeys) {
   
   uint8_t keyIndex = 0;
   
-  for (uint8_t i = 0; i < 6 && keyIndex < 6; i++) {
-    uint8_t k = encodedKeys[i];
-    
-    if (k >= 0x88) {  // Non-printing key (not a modifier)
-      k = k - 0x88;
-      customReport.keys[keyIndex++] = k;
-    } else if (k >= 0x80) {  // Modifier key
-      customReport.modifiers |= (1 << (k - 0x80));
-      // Don't increment keyIndex - modifiers go in the modifier byte
-    } else {  // Printing key (ASCII 0..127)
-      k = _asciimap[k];
-      if (k) {  // Valid key mapping exists
-        if ((k & SHIFT) == SHIFT) {  // Needs shift
-          customReport.modifiers |= 0x02;  // Left shift modifier
-          k &= ~SHIFT;
-        }
-        if ((k & ALT_GR) == ALT_GR) {  // Needs AltGr
-          customReport.modifiers |= 0x40;  // Right Alt
-          k &= ~ALT_GR;
-        }
-        if (k == ISO_REPLACEMENT) {
-          k = ISO_KEY;
-        }
-        customReport.keys[keyIndex++] = k;
-      }
+  for (uint8_t i = 0; i < numKeys && keyIndex < 6; i++) {
+    uint8_t usage;
+    if (decodeKey(encodedKeys[i], &usage, &customReport.modifiers) && usage != 0) {
+      customReport.keys[keyIndex++] = usage;
     }
   }
   
   sendReport(&customReport);
-  return 0;
+  return keyIndex;
 }
 
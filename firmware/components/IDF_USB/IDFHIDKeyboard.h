@@ -23,6 +23,7 @@
 
 #include "Print.h"
 #include "IDFHID.h"
+#include "KeyboardKeymap.h"
 
 typedef union {
   struct {
@@ -139,20 +140,25 @@ private:
   KeyReport _keyReport;
   KeyReport customReport;
   const uint8_t *_asciimap;
+  KeymapEntry _keymap[KEYMAP_SIZE];  // _asciimap expanded, rebuilt by setLayout()
   bool shiftKeyReports;
 
 public:
   IDFHIDKeyboard(uint8_t itf = 0);
   void begin(const uint8_t *layout = KeyboardLayout_en_US);
+  void setLayout(const uint8_t *layout);
   void end(void);
   size_t write(uint8_t k);
   size_t write(const uint8_t *buffer, size_t size);
   size_t press(uint8_t k);
   size_t release(uint8_t k);
   size_t sendKeycode(uint8_t* encodedKeys, uint8_t numKeys);
+  bool decodeKey(uint8_t encoded, uint8_t *usage, uint8_t *modifiers) const;
   void releaseAll(void);
   void sendReport(KeyReport *keys);
   void setShiftKeyReports(bool set);
+  const uint8_t *layout(void) const { return _asciimap; }
+  const KeymapEntry *keymap(void) const { return _keymap; }
 
   //raw functions work with TinyUSB's HID_KEY_* macros
   size_t pressRaw(uint8_t k);
@@ -0,0 +1,29 @@
+#include "IDFHIDNkroKeyboard.h"
+
+IDFHIDNkroKeyboard::IDFHIDNkroKeyboard(uint8_t itf) : IDFHID(itf) {}
+
+void IDFHIDNkroKeyboard::end() {}
+
+size_t IDFHIDNkroKeyboard::sendKeys(uint8_t modifiers, const uint8_t *usages, size_t count) {
+  hid_nkro_keyboard_report_t report = {};
+  report.modifiers = modifiers;
+
+  size_t held = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint8_t usage = usages[i];
+    if (usage == 0 || usage >= NKRO_KEY_BITS) continue;
+    uint8_t bit = 1 << (usage & 7);
+    if (!(report.keys[usage >> 3] & bit)) {
+      report.keys[usage >> 3] |= bit;
+      held++;
+    }
+  }
+
+  SendReport(0, &report, sizeof(report));
+  return held;
+}
+
+void IDFHIDNkroKeyboard::releaseAll() {
+  hid_nkro_keyboard_report_t report = {};
+  SendReport(0, &report, sizeof(report));
+}
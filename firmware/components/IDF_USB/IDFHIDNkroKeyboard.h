@@ -0,0 +1,49 @@
+#pragma once
+#include "IDFHID.h"
+
+// Key usages 0x00..0xA7 as one bit each: every key the boot keyboard can send, F13-F24 included
+#define NKRO_KEY_BITS   168
+#define NKRO_KEY_BYTES  (NKRO_KEY_BITS / 8)
+
+typedef struct TU_ATTR_PACKED {
+  uint8_t modifiers;
+  uint8_t keys[NKRO_KEY_BYTES];
+} hid_nkro_keyboard_report_t;
+
+// N-key-rollover keyboard: modifier byte followed by a key bitmap. Report protocol only;
+// hosts in boot protocol (BIOS, some KVMs) never read this interface.
+#define TUD_HID_REPORT_DESC_NKRO_KEYBOARD(...) \
+  HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                    ,\
+  HID_USAGE      ( HID_USAGE_DESKTOP_KEYBOARD )                    ,\
+  HID_COLLECTION ( HID_COLLECTION_APPLICATION )                    ,\
+    __VA_ARGS__ \
+    /* 8 bits Modifier Keys (Shift, Control, Alt) */ \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_KEYBOARD )                     ,\
+      HID_USAGE_MIN    ( 224                                    )  ,\
+      HID_USAGE_MAX    ( 231                                    )  ,\
+      HID_LOGICAL_MIN  ( 0                                      )  ,\
+      HID_LOGICAL_MAX  ( 1                                      )  ,\
+      HID_REPORT_COUNT ( 8                                      )  ,\
+      HID_REPORT_SIZE  ( 1                                      )  ,\
+      HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE )  ,\
+    /* One bit per key usage */ \
+      HID_USAGE_MIN    ( 0                                      )  ,\
+      HID_USAGE_MAX    ( NKRO_KEY_BITS - 1                      )  ,\
+      HID_LOGICAL_MIN  ( 0                                      )  ,\
+      HID_LOGICAL_MAX  ( 1                                      )  ,\
+      HID_REPORT_COUNT ( NKRO_KEY_BITS                          )  ,\
+      HID_REPORT_SIZE  ( 1                                      )  ,\
+      HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE )  ,\
+  HID_COLLECTION_END \
+
+// Bitmap keyboard for chords and rollover beyond the boot keyboard's 6 keys
+class IDFHIDNkroKeyboard : public IDFHID {
+public:
+  IDFHIDNkroKeyboard(uint8_t itf);
+  void end(void);
+
+  // Send one report with `modifiers` and every usage in `usages` held down.
+  // Usages outside the bitmap are ignored; returns how many were set.
+  size_t sendKeys(uint8_t modifiers, const uint8_t *usages, size_t count);
+  void releaseAll(void);
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+// Characters a layout table covers (ASCII NUL..DEL)
+#define KEYMAP_SIZE 128
+
+// One layout table entry expanded to report terms, so typing a character is a single
+// load instead of decoding SHIFT / ALT_GR / ISO_REPLACEMENT every time
+typedef struct {
+  uint8_t modifiers;    // Left Shift and/or AltGr
+  uint8_t usage;        // HID usage, 0 = not in this layout
+} KeymapEntry;
+
+// Decode one KeyboardLayout.h-encoded entry
+KeymapEntry keymapEntry(uint8_t encoded);
+
+// Expand a 128-entry layout table into keymap[KEYMAP_SIZE]
+void expandKeyboardLayout(const uint8_t* layout, KeymapEntry* keymap);
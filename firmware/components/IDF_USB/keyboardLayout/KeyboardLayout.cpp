@@ -0,0 +1,134 @@
+/*
+ * Helpers shared by the layout tables: expansion into report terms,
+ * dead key compositions and the lookup from an ASCII table to its extras.
+ */
+
+#include "KeyboardLayout.h"
+#include "KeyboardKeymap.h"
+
+extern const uint8_t KeyboardLayout_de_DE[];
+extern const uint8_t KeyboardLayout_es_ES[];
+extern const uint8_t KeyboardLayout_fr_FR[];
+extern const uint8_t KeyboardLayout_it_IT[];
+extern const uint8_t KeyboardLayout_pt_PT[];
+extern const uint8_t KeyboardLayout_sv_SE[];
+extern const uint8_t KeyboardLayout_da_DK[];
+extern const uint8_t KeyboardLayout_hu_HU[];
+extern const uint8_t KeyboardLayout_pt_BR[];
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_de_DE;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_es_ES;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_fr_FR;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_it_IT;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_pt_PT;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_sv_SE;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_da_DK;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_hu_HU;
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_pt_BR;
+
+KeymapEntry keymapEntry(uint8_t k)
+{
+  KeymapEntry entry = {0, 0};
+  if ((k & SHIFT) == SHIFT) {
+    entry.modifiers |= 0x02;  // Left Shift
+    k &= ~SHIFT;
+  }
+  if ((k & ALT_GR) == ALT_GR) {
+    entry.modifiers |= 0x40;  // AltGr = right Alt
+    k &= ~ALT_GR;
+  }
+  if (k == ISO_REPLACEMENT) {
+    k = ISO_KEY;
+  }
+  entry.usage = k;
+  return entry;
+}
+
+void expandKeyboardLayout(const uint8_t* layout, KeymapEntry* keymap)
+{
+  for (size_t c = 0; c < KEYMAP_SIZE; c++) {
+    keymap[c] = keymapEntry(layout[c]);
+  }
+}
+
+extern const KeyboardComposition KeyboardCompositions[] = {
+  {ACCENT_ACUTE,      ' ', 0x00b4},  // ´
+  {ACCENT_ACUTE,      'a', 0x00e1},  // á
+  {ACCENT_ACUTE,      'e', 0x00e9},  // é
+  {ACCENT_ACUTE,      'i', 0x00ed},  // í
+  {ACCENT_ACUTE,      'o', 0x00f3},  // ó
+  {ACCENT_ACUTE,      'u', 0x00fa},  // ú
+  {ACCENT_ACUTE,      'y', 0x00fd},  // ý
+  {ACCENT_ACUTE,      'A', 0x00c1},  // Á
+  {ACCENT_ACUTE,      'E', 0x00c9},  // É
+  {ACCENT_ACUTE,      'I', 0x00cd},  // Í
+  {ACCENT_ACUTE,      'O', 0x00d3},  // Ó
+  {ACCENT_ACUTE,      'U', 0x00da},  // Ú
+  {ACCENT_ACUTE,      'Y', 0x00dd},  // Ý
+  {ACCENT_GRAVE,      ' ', 0x0060},  // `
+  {ACCENT_GRAVE,      'a', 0x00e0},  // à
+  {ACCENT_GRAVE,      'e', 0x00e8},  // è
+  {ACCENT_GRAVE,      'i', 0x00ec},  // ì
+  {ACCENT_GRAVE,      'o', 0x00f2},  // ò
+  {ACCENT_GRAVE,      'u', 0x00f9},  // ù
+  {ACCENT_GRAVE,      'A', 0x00c0},  // À
+  {ACCENT_GRAVE,      'E', 0x00c8},  // È
+  {ACCENT_GRAVE,      'I', 0x00cc},  // Ì
+  {ACCENT_GRAVE,      'O', 0x00d2},  // Ò
+  {ACCENT_GRAVE,      'U', 0x00d9},  // Ù
+  {ACCENT_CIRCUMFLEX, ' ', 0x005e},  // ^
+  {ACCENT_CIRCUMFLEX, 'a', 0x00e2},  // â
+  {ACCENT_CIRCUMFLEX, 'e', 0x00ea},  // ê
+  {ACCENT_CIRCUMFLEX, 'i', 0x00ee},  // î
+  {ACCENT_CIRCUMFLEX, 'o', 0x00f4},  // ô
+  {ACCENT_CIRCUMFLEX, 'u', 0x00fb},  // û
+  {ACCENT_CIRCUMFLEX, 'A', 0x00c2},  // Â
+  {ACCENT_CIRCUMFLEX, 'E', 0x00ca},  // Ê
+  {ACCENT_CIRCUMFLEX, 'I', 0x00ce},  // Î
+  {ACCENT_CIRCUMFLEX, 'O', 0x00d4},  // Ô
+  {ACCENT_CIRCUMFLEX, 'U', 0x00db},  // Û
+  {ACCENT_DIAERESIS,  ' ', 0x00a8},  // ¨
+  {ACCENT_DIAERESIS,  'a', 0x00e4},  // ä
+  {ACCENT_DIAERESIS,  'e', 0x00eb},  // ë
+  {ACCENT_DIAERESIS,  'i', 0x00ef},  // ï
+  {ACCENT_DIAERESIS,  'o', 0x00f6},  // ö
+  {ACCENT_DIAERESIS,  'u', 0x00fc},  // ü
+  {ACCENT_DIAERESIS,  'y', 0x00ff},  // ÿ
+  {ACCENT_DIAERESIS,  'A', 0x00c4},  // Ä
+  {ACCENT_DIAERESIS,  'E', 0x00cb},  // Ë
+  {ACCENT_DIAERESIS,  'I', 0x00cf},  // Ï
+  {ACCENT_DIAERESIS,  'O', 0x00d6},  // Ö
+  {ACCENT_DIAERESIS,  'U', 0x00dc},  // Ü
+  {ACCENT_TILDE,      ' ', 0x007e},  // ~
+  {ACCENT_TILDE,      'a', 0x00e3},  // ã
+  {ACCENT_TILDE,      'n', 0x00f1},  // ñ
+  {ACCENT_TILDE,      'o', 0x00f5},  // õ
+  {ACCENT_TILDE,      'A', 0x00c3},  // Ã
+  {ACCENT_TILDE,      'N', 0x00d1},  // Ñ
+  {ACCENT_TILDE,      'O', 0x00d5},  // Õ
+};
+
+extern const size_t KeyboardCompositionCount = sizeof(KeyboardCompositions) / sizeof(KeyboardCompositions[0]);
+
+static const struct {
+  const uint8_t*              layout;
+  const KeyboardLayoutExtras* extras;
+} layoutExtras[] = {
+  {KeyboardLayout_de_DE, &KeyboardLayoutExtras_de_DE},
+  {KeyboardLayout_es_ES, &KeyboardLayoutExtras_es_ES},
+  {KeyboardLayout_fr_FR, &KeyboardLayoutExtras_fr_FR},
+  {KeyboardLayout_it_IT, &KeyboardLayoutExtras_it_IT},
+  {KeyboardLayout_pt_PT, &KeyboardLayoutExtras_pt_PT},
+  {KeyboardLayout_sv_SE, &KeyboardLayoutExtras_sv_SE},
+  {KeyboardLayout_da_DK, &KeyboardLayoutExtras_da_DK},
+  {KeyboardLayout_hu_HU, &KeyboardLayoutExtras_hu_HU},
+  {KeyboardLayout_pt_BR, &KeyboardLayoutExtras_pt_BR},
+};
+
+const KeyboardLayoutExtras* keyboardLayoutExtras(const uint8_t* layout)
+{
+  for (size_t i = 0; i < sizeof(layoutExtras) / sizeof(layoutExtras[0]); i++) {
+    if (layoutExtras[i].layout == layout) return layoutExtras[i].extras;
+  }
+  return nullptr;
+}
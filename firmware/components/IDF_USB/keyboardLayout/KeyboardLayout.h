@@ -5,8 +5,9 @@
   only in Keyboard.cpp and the keyboard layout files. Layout files map
   ASCII character codes to keyboard scan codes (technically, to USB HID
   Usage codes), possibly altered by the SHIFT or ALT_GR modifiers.
-  Non-ASCII characters (anything outside the 7-bit range NUL..DEL) are
-  not supported.
+  Non-ASCII characters (anything outside the 7-bit range NUL..DEL) go
+  in a separate, optional extras table described at the end of this
+  comment.
 
   == Creating your own layout ==
 
@@ -57,6 +58,16 @@
   0x64, the key next next to Left Shift on the ISO layout (and absent
   from the ANSI layout). We handle it by replacing its value by 0x32 in
   the layout arrays.
+
+  == Non-ASCII characters ==
+
+  A layout may also export a KeyboardLayoutExtras table listing the
+  characters it types with a single key (German ä on 0x34, French é on
+  0x1f) and its dead keys, tagged with the accent they add. Characters
+  made from a dead key and an ASCII base letter come from the shared
+  KeyboardCompositions table, so a layout only lists the dead key once.
+  Both tables use the encoding above. Register the extras in
+  KeyboardLayout.cpp next to the ASCII table they belong to.
 */
 
 #include <Arduino.h>
@@ -66,3 +77,42 @@
 #define ALT_GR          0x40
 #define ISO_KEY         0x64
 #define ISO_REPLACEMENT 0x32
+
+// Accent a dead key puts on the next character
+enum KeyboardAccent : uint8_t {
+  ACCENT_ACUTE,
+  ACCENT_GRAVE,
+  ACCENT_CIRCUMFLEX,
+  ACCENT_DIAERESIS,
+  ACCENT_TILDE,
+};
+
+typedef struct {
+  uint16_t codepoint;     // Unicode BMP code point
+  uint8_t  key;           // Encoded like the ASCII table
+} KeyboardLayoutChar;
+
+typedef struct {
+  uint8_t accent;         // KeyboardAccent
+  uint8_t key;
+} KeyboardLayoutDeadKey;
+
+typedef struct {
+  const KeyboardLayoutChar*    chars;
+  uint8_t                      charCount;
+  const KeyboardLayoutDeadKey* deadKeys;
+  uint8_t                      deadKeyCount;
+} KeyboardLayoutExtras;
+
+// Dead key + base character -> code point. Space gives the bare accent.
+typedef struct {
+  uint8_t  accent;
+  char     base;
+  uint16_t codepoint;
+} KeyboardComposition;
+
+extern const KeyboardComposition KeyboardCompositions[];
+extern const size_t KeyboardCompositionCount;
+
+// Extras for an ASCII layout table, nullptr if it has none
+const KeyboardLayoutExtras* keyboardLayoutExtras(const uint8_t* layout);
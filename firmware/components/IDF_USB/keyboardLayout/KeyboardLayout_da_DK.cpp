@@ -135,3 +135,31 @@ extern const uint8_t KeyboardLayout_da_DK[128] = {
   0x00,           // ~  not supported (requires dead key + space)
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00a3, 0x20 | ALT_GR},   // £
+  {0x00a4, 0x21 | SHIFT},    // ¤
+  {0x00a7, 0x35 | SHIFT},    // §
+  {0x00b5, 0x10 | ALT_GR},   // µ
+  {0x00bd, 0x35},            // ½
+  {0x00c5, 0x2f | SHIFT},    // Å
+  {0x00c6, 0x33 | SHIFT},    // Æ
+  {0x00d8, 0x34 | SHIFT},    // Ø
+  {0x00e5, 0x2f},            // å
+  {0x00e6, 0x33},            // æ
+  {0x00f8, 0x34},            // ø
+  {0x20ac, 0x22 | ALT_GR},   // €
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_ACUTE,       0x2e},
+  {ACCENT_GRAVE,       0x2e | SHIFT},
+  {ACCENT_DIAERESIS,   0x30},
+  {ACCENT_CIRCUMFLEX,  0x30 | SHIFT},
+  {ACCENT_TILDE,       0x30 | ALT_GR},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_da_DK = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
@@ -135,3 +135,30 @@ extern const uint8_t KeyboardLayout_de_DE[128] PROGMEM = {
   0x30 | ALT_GR,  // ~
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00df, 0x2d},            // ß
+  {0x00e4, 0x34},            // ä
+  {0x00c4, 0x34 | SHIFT},    // Ä
+  {0x00f6, 0x33},            // ö
+  {0x00d6, 0x33 | SHIFT},    // Ö
+  {0x00fc, 0x2f},            // ü
+  {0x00dc, 0x2f | SHIFT},    // Ü
+  {0x00a7, 0x20 | SHIFT},    // §
+  {0x00b0, 0x35 | SHIFT},    // °
+  {0x00b2, 0x1f | ALT_GR},   // ²
+  {0x00b3, 0x20 | ALT_GR},   // ³
+  {0x00b5, 0x10 | ALT_GR},   // µ
+  {0x20ac, 0x08 | ALT_GR},   // €
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_ACUTE,       0x2e},
+  {ACCENT_GRAVE,       0x2e | SHIFT},
+  {ACCENT_CIRCUMFLEX,  0x35},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_de_DE = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
@@ -135,3 +135,29 @@ extern const uint8_t KeyboardLayout_es_ES[128] PROGMEM = {
   0x00,           // ~  not supported (requires dead key + space)
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00a1, 0x2e},            // ¡
+  {0x00aa, 0x35 | SHIFT},    // ª
+  {0x00ac, 0x23 | ALT_GR},   // ¬
+  {0x00b7, 0x20 | SHIFT},    // ·
+  {0x00ba, 0x35},            // º
+  {0x00bf, 0x2e | SHIFT},    // ¿
+  {0x00c7, 0x31 | SHIFT},    // Ç
+  {0x00d1, 0x33 | SHIFT},    // Ñ
+  {0x00e7, 0x31},            // ç
+  {0x00f1, 0x33},            // ñ
+  {0x20ac, 0x08 | ALT_GR},   // €
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_ACUTE,       0x34},
+  {ACCENT_GRAVE,       0x2f},
+  {ACCENT_CIRCUMFLEX,  0x2f | SHIFT},
+  {ACCENT_DIAERESIS,   0x34 | SHIFT},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_es_ES = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
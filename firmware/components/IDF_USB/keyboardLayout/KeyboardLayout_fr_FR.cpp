@@ -135,3 +135,28 @@ extern const uint8_t KeyboardLayout_fr_FR[128] PROGMEM = {
   0x1f | ALT_GR,  // ~
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00a3, 0x30 | SHIFT},    // £
+  {0x00a4, 0x30 | ALT_GR},   // ¤
+  {0x00a7, 0x38 | SHIFT},    // §
+  {0x00b0, 0x2d | SHIFT},    // °
+  {0x00b2, 0x35},            // ²
+  {0x00b5, 0x31 | SHIFT},    // µ
+  {0x00e0, 0x27},            // à
+  {0x00e7, 0x26},            // ç
+  {0x00e8, 0x24},            // è
+  {0x00e9, 0x1f},            // é
+  {0x00f9, 0x34},            // ù
+  {0x20ac, 0x08 | ALT_GR},   // €
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_CIRCUMFLEX,  0x2f},
+  {ACCENT_DIAERESIS,   0x2f | SHIFT},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_fr_FR = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
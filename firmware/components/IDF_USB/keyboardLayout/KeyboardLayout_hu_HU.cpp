@@ -141,3 +141,29 @@ extern const uint8_t KeyboardLayout_hu_HU[128] PROGMEM = {
   0x1e | ALT_GR,  // ~
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00c1, 0x34 | SHIFT},    // Á
+  {0x00c9, 0x33 | SHIFT},    // É
+  {0x00cd, 0x32 | SHIFT},    // Í
+  {0x00d3, 0x2e | SHIFT},    // Ó
+  {0x00d6, 0x27 | SHIFT},    // Ö
+  {0x00da, 0x30 | SHIFT},    // Ú
+  {0x00dc, 0x2d | SHIFT},    // Ü
+  {0x00e1, 0x34},            // á
+  {0x00e9, 0x33},            // é
+  {0x00ed, 0x32},            // í
+  {0x00f3, 0x2e},            // ó
+  {0x00f6, 0x27},            // ö
+  {0x00fa, 0x30},            // ú
+  {0x00fc, 0x2d},            // ü
+  {0x0150, 0x2f | SHIFT},    // Ő
+  {0x0151, 0x2f},            // ő
+  {0x0170, 0x31 | SHIFT},    // Ű
+  {0x0171, 0x31},            // ű
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_hu_HU = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  nullptr, 0,
+};
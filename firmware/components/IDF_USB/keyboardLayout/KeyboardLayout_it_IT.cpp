@@ -135,3 +135,22 @@ extern const uint8_t KeyboardLayout_it_IT[128] PROGMEM = {
   0x00,           // ~  not in this layout
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00a3, 0x20 | SHIFT},    // £
+  {0x00a7, 0x31 | SHIFT},    // §
+  {0x00b0, 0x34 | SHIFT},    // °
+  {0x00e0, 0x34},            // à
+  {0x00e7, 0x33 | SHIFT},    // ç
+  {0x00e8, 0x2f},            // è
+  {0x00e9, 0x2f | SHIFT},    // é
+  {0x00ec, 0x2e},            // ì
+  {0x00f2, 0x33},            // ò
+  {0x00f9, 0x31},            // ù
+  {0x20ac, 0x08 | ALT_GR},   // €
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_it_IT = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  nullptr, 0,
+};
@@ -139,3 +139,19 @@ extern const uint8_t KeyboardLayout_pt_BR[128] PROGMEM = {
   0x34,           // ~
   0x4c            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00c7, 0x33 | SHIFT},    // Ç
+  {0x00e7, 0x33},            // ç
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_ACUTE,       0x2f},
+  {ACCENT_CIRCUMFLEX,  0x34 | SHIFT},
+  {ACCENT_DIAERESIS,   0x23 | SHIFT},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_pt_BR = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
@@ -135,3 +135,27 @@ extern const uint8_t KeyboardLayout_pt_PT[128] PROGMEM = {
   0x00,           // ~  not supported (requires dead key + space)
   0x00            // DEL
 };
+
+static const KeyboardLayoutChar extraChars[] = {
+  {0x00a3, 0x20 | ALT_GR},   // £
+  {0x00a7, 0x21 | ALT_GR},   // §
+  {0x00aa, 0x34 | SHIFT},    // ª
+  {0x00ab, 0x2e},            // «
+  {0x00ba, 0x34},            // º
+  {0x00bb, 0x2e | SHIFT},    // »
+  {0x00c7, 0x33 | SHIFT},    // Ç
+  {0x00e7, 0x33},            // ç
+  {0x20ac, 0x08 | ALT_GR},   // €
+};
+
+static const KeyboardLayoutDeadKey deadKeys[] = {
+  {ACCENT_ACUTE,       0x30},
+  {ACCENT_GRAVE,       0x30 | SHIFT},
+  {ACCENT_TILDE,       0x31},
+  {ACCENT_CIRCUMFLEX,  0x31 | SHIFT},
+};
+
+extern const KeyboardLayoutExtras KeyboardLayoutExtras_pt_PT = {
+  extraChars, sizeof(extraChars) / sizeof(extraChars[0]),
+  deadKeys, sizeof(deadKeys) / sizeof(deadKeys[0]),
+};
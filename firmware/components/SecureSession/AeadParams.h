@@ -0,0 +1,9 @@
+#pragma once
+#include <stddef.h>
+
+// Sizes shared by every packet AEAD backend (AES-256-GCM, 96-bit IV, full tag)
+struct AeadParams {
+    static constexpr size_t KEY_SIZE = 32;
+    static constexpr size_t IV_SIZE  = 12;
+    static constexpr size_t TAG_SIZE = 16;
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// On-device AES-GCM microbenchmark (enabled with CONFIG_TOOTHPASTE_CRYPTO_BENCHMARK).
+// Compares the old per-packet init/setkey/free decrypt against the persistent
+// mbedtls GCM and PSA AEAD session ciphers across typical DataPacket payload sizes
+// and logs us and CPU cycles per packet. Uses a throwaway random key; never touches
+// the live session.
+void runCipherBenchmark();
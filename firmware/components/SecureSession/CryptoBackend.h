@@ -0,0 +1,33 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief Handshake crypto that CryptoWorker runs off the packet path, one call per AUTH packet.
+/// @details SessionCryptoBackend does the real ECDH / ATECC work through SecureSession.
+/// MockCryptoBackend only waits, so handshake latency and its overlap with ingest can be
+/// studied without a secure element. Plain C++ with no ESP-IDF dependency, so the host
+/// tests drive CryptoWorker through the mock.
+class CryptoBackend {
+public:
+    static constexpr size_t SALT_SIZE = 32;
+
+    virtual ~CryptoBackend() {}
+
+    // Pairing: ECDH with the pairing keypair, enroll the peer and derive the session key
+    virtual bool pair(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) = 0;
+
+    // Reconnect: key the session from the peer's resumption ticket, false if it does not match
+    virtual bool resume(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen) = 0;
+
+    // Reconnect: ECDH with the keypair the peer enrolled with
+    virtual bool reconnect(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) = 0;
+
+    // Store a resumption ticket derived from the session keyed last
+    virtual bool issueTicket(const char* base64pubKey) = 0;
+
+    // HKDF salt of the session keyed last, sent to the client in CHALLENGE
+    virtual void sessionSalt(uint8_t out[SALT_SIZE]) = 0;
+
+    // Write what a handshake left in RAM to flash (the peer's LRU position); runs after CHALLENGE
+    virtual void persist() = 0;
+};
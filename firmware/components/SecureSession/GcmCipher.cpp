@@ -0,0 +1,69 @@
+#include "GcmCipher.h"
+
+GcmCipher::GcmCipher() : keyed(false)
+{
+    mbedtls_gcm_init(&gcm);
+}
+
+GcmCipher::~GcmCipher()
+{
+    end();
+}
+
+// Expand the AES key schedule and GHASH table once per session key
+int GcmCipher::begin(const uint8_t key[KEY_SIZE])
+{
+    end();
+
+    int ret = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, KEY_SIZE * 8);
+    if (ret != 0) {
+        end();
+        return ret;
+    }
+
+    keyed = true;
+    return 0;
+}
+
+// Free (and zeroize) the expanded key, then leave the context ready for the next begin()
+void GcmCipher::end()
+{
+    mbedtls_gcm_free(&gcm);
+    mbedtls_gcm_init(&gcm);
+    keyed = false;
+}
+
+int GcmCipher::encrypt(const uint8_t iv[IV_SIZE], const uint8_t* plaintext, size_t len,
+                           uint8_t* ciphertext, uint8_t tag[TAG_SIZE])
+{
+    if (!keyed) return -1;
+
+    return mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT,
+        len,
+        iv, IV_SIZE,
+        nullptr, 0, // no additional data
+        plaintext,
+        ciphertext,
+        TAG_SIZE,
+        tag);
+}
+
+int GcmCipher::decrypt(const uint8_t iv[IV_SIZE], const uint8_t* ciphertext, size_t len,
+                           const uint8_t tag[TAG_SIZE], uint8_t* plaintext_out)
+{
+    if (!keyed) return -1;
+
+    return mbedtls_gcm_auth_decrypt(&gcm,
+        len,
+        iv, IV_SIZE,
+        nullptr, 0,
+        tag, TAG_SIZE,
+        ciphertext,
+        plaintext_out);
+}
+
+// GCM is a stream mode, so mbedtls allows the output buffer to be the input buffer
+int GcmCipher::decryptInPlace(const uint8_t iv[IV_SIZE], uint8_t* buf, size_t len, const uint8_t tag[TAG_SIZE])
+{
+    return decrypt(iv, buf, len, tag, buf);
+}
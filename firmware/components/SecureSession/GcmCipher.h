@@ -0,0 +1,38 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <mbedtls/gcm.h>
+#include "AeadParams.h"
+
+/// @brief AES-256-GCM through the mbedtls_gcm API.
+/// @details The AES key schedule and GHASH H-table are expanded once in begin() and
+/// reused for every packet until end() wipes them (disconnect or rekey). Depends on
+/// nothing but mbedtls so it also builds on the host.
+class GcmCipher : public AeadParams {
+public:
+    GcmCipher();
+    ~GcmCipher();
+
+    // Expand the key schedule for a new session key. Any previous key is wiped first.
+    int begin(const uint8_t key[KEY_SIZE]);
+
+    // Wipe the expanded key material. Safe to call when not keyed.
+    void end();
+
+    bool ready() const { return keyed; }
+
+    // Encrypt plaintext into ciphertext (may alias) and produce the auth tag
+    int encrypt(const uint8_t iv[IV_SIZE], const uint8_t* plaintext, size_t len,
+                uint8_t* ciphertext, uint8_t tag[TAG_SIZE]);
+
+    // Authenticate and decrypt ciphertext into plaintext_out (may alias)
+    int decrypt(const uint8_t iv[IV_SIZE], const uint8_t* ciphertext, size_t len,
+                const uint8_t tag[TAG_SIZE], uint8_t* plaintext_out);
+
+    // Authenticate and decrypt buf in place; buf is zeroed if authentication fails
+    int decryptInPlace(const uint8_t iv[IV_SIZE], uint8_t* buf, size_t len, const uint8_t tag[TAG_SIZE]);
+
+private:
+    mbedtls_gcm_context gcm;
+    bool keyed;
+};
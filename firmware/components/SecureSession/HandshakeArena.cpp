@@ -0,0 +1,78 @@
+#include "HandshakeArena.h"
+#include <string.h>
+
+static_assert(sizeof(uint32_t) * 2 == HandshakeArena::ALIGN, "block header keeps payloads aligned");
+
+HandshakeArena::HandshakeArena(void* buffer, size_t size)
+    : base_(nullptr), size_(0), used_(0), peak_(0)
+{
+    uintptr_t start = ((uintptr_t)buffer + ALIGN - 1) & ~(uintptr_t)(ALIGN - 1);
+    size_t lost = start - (uintptr_t)buffer;
+    if (buffer == nullptr || size < lost + sizeof(Header) + ALIGN) return;
+
+    base_ = (uint8_t*)start;
+    size_ = (size - lost) & ~(ALIGN - 1);
+    if (size_ > UINT32_MAX) size_ = UINT32_MAX & ~(ALIGN - 1);
+
+    Header* first = (Header*)base_;
+    first->size = (uint32_t)size_;
+    first->free = 1;
+}
+
+void* HandshakeArena::allocate(size_t count, size_t size)
+{
+    if (base_ == nullptr || (size != 0 && count > SIZE_MAX / size)) return nullptr;
+    size_t bytes = count * size;
+    if (bytes > size_) return nullptr;
+    if (bytes == 0) bytes = 1;  // calloc(0) still returns a unique pointer
+    size_t need = sizeof(Header) + ((bytes + ALIGN - 1) & ~(ALIGN - 1));
+
+    for (size_t pos = 0; pos < size_; ) {
+        Header* block = (Header*)(base_ + pos);
+        if (block->free) {
+            // Merge the free blocks that follow, so freed runs are reused whole
+            size_t next = pos + block->size;
+            while (next < size_ && ((Header*)(base_ + next))->free) {
+                block->size += ((Header*)(base_ + next))->size;
+                next = pos + block->size;
+            }
+
+            if (block->size >= need) {
+                // Split off the rest when it can hold a block of its own
+                if (block->size - need >= sizeof(Header) + ALIGN) {
+                    Header* rest = (Header*)(base_ + pos + need);
+                    rest->size = block->size - (uint32_t)need;
+                    rest->free = 1;
+                    block->size = (uint32_t)need;
+                }
+                block->free = 0;
+                used_ += block->size;
+                if (used_ > peak_) peak_ = used_;
+
+                void* payload = block + 1;
+                memset(payload, 0, block->size - sizeof(Header));
+                return payload;
+            }
+        }
+        pos += block->size;
+    }
+    return nullptr;
+}
+
+bool HandshakeArena::release(void* ptr)
+{
+    if (!owns(ptr)) return false;
+
+    Header* block = (Header*)ptr - 1;
+    if (!block->free) {
+        block->free = 1;
+        used_ -= block->size;
+    }
+    return true;
+}
+
+bool HandshakeArena::owns(const void* ptr) const
+{
+    const uint8_t* p = (const uint8_t*)ptr;
+    return base_ != nullptr && p >= base_ + sizeof(Header) && p < base_ + size_;
+}
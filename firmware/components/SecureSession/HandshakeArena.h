@@ -0,0 +1,41 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief First-fit allocator over a fixed buffer, so handshake crypto never touches the heap.
+/// @details SecureSession points mbedTLS / PSA calloc and free at it for the crypto worker
+/// task: ECDH bignums, imported PSA keys and the session cipher's context all come from
+/// here. Each block carries an 8-byte header; free neighbours are merged as allocate()
+/// walks past them. Not thread-safe: the caller serializes allocate() and release(), which
+/// may come from different tasks. Plain C++ with no ESP-IDF dependency, so it is tested on
+/// the host.
+class HandshakeArena {
+public:
+    static constexpr size_t ALIGN = 8;
+
+    HandshakeArena(void* buffer, size_t size);
+
+    // calloc(): zeroed, ALIGN-aligned memory, or nullptr when nothing fits (or count * size overflows)
+    void* allocate(size_t count, size_t size);
+
+    // free(): false when ptr did not come from this arena, so the caller can hand it to the heap
+    bool release(void* ptr);
+
+    bool owns(const void* ptr) const;
+
+    size_t capacity() const { return size_; }
+    size_t used() const { return used_; }    // Bytes held by live blocks, headers included
+    size_t peak() const { return peak_; }
+    void resetPeak() { peak_ = used_; }   // Start measuring the next handshake's high-water mark
+
+private:
+    struct Header {
+        uint32_t size;  // Whole block, header included; a multiple of ALIGN
+        uint32_t free;
+    };
+
+    uint8_t* base_;
+    size_t   size_;
+    size_t   used_;
+    size_t   peak_;
+};
@@ -0,0 +1,60 @@
+#include "MockCryptoBackend.h"
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+MockCryptoBackend::MockCryptoBackend(uint32_t ecdhLatencyUs, uint32_t hkdfLatencyUs)
+    : ecdhLatencyUs_(ecdhLatencyUs), hkdfLatencyUs_(hkdfLatencyUs), accept_(true), ticketed_(false),
+      calls_(0), persists_(0), session_(0)
+{
+}
+
+void MockCryptoBackend::setLatency(uint32_t ecdhLatencyUs, uint32_t hkdfLatencyUs)
+{
+    ecdhLatencyUs_ = ecdhLatencyUs;
+    hkdfLatencyUs_ = hkdfLatencyUs;
+}
+
+// Stand in for the work of one call, then report the configured outcome
+bool MockCryptoBackend::keySession(uint32_t latencyUs)
+{
+    calls_++;
+    if (latencyUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(latencyUs));
+    }
+    if (!accept_) return false;
+    session_++;
+    return true;
+}
+
+bool MockCryptoBackend::pair(const uint8_t*, size_t, const char*)
+{
+    return keySession(ecdhLatencyUs_);
+}
+
+bool MockCryptoBackend::resume(const char*, const uint8_t*, size_t ticketIdLen)
+{
+    if (!ticketed_ || ticketIdLen == 0) return false;
+    return keySession(hkdfLatencyUs_);
+}
+
+bool MockCryptoBackend::reconnect(const uint8_t*, size_t, const char*)
+{
+    return keySession(ecdhLatencyUs_);
+}
+
+bool MockCryptoBackend::issueTicket(const char*)
+{
+    calls_++;
+    if (hkdfLatencyUs_ > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(hkdfLatencyUs_));
+    }
+    ticketed_ = true;
+    return true;
+}
+
+void MockCryptoBackend::sessionSalt(uint8_t out[SALT_SIZE])
+{
+    memset(out, 0, SALT_SIZE);
+    memcpy(out, &session_, sizeof(session_));
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include "CryptoBackend.h"
+
+/// @brief CryptoBackend that does no crypto and takes a configurable time per call.
+/// @details pair() and reconnect() wait the ECDH latency, resume() and issueTicket() the
+/// (much shorter) HKDF latency, then report the configured outcome. resume() succeeds once
+/// issueTicket() has been called. Salts are a counter, so each session's salt differs.
+/// No session key is derived: a real client cannot talk to a device running the mock.
+/// Latencies and outcome may be changed from another thread while calls are running.
+class MockCryptoBackend : public CryptoBackend {
+public:
+    explicit MockCryptoBackend(uint32_t ecdhLatencyUs = 0, uint32_t hkdfLatencyUs = 0);
+
+    void setLatency(uint32_t ecdhLatencyUs, uint32_t hkdfLatencyUs);
+    void setAccept(bool accept) { accept_ = accept; }   // false: every handshake fails
+
+    uint32_t calls() const { return calls_; }
+    uint32_t persists() const { return persists_; }
+    bool ticketed() const { return ticketed_; }
+
+    bool pair(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) override;
+    bool resume(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen) override;
+    bool reconnect(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) override;
+    bool issueTicket(const char* base64pubKey) override;
+    void sessionSalt(uint8_t out[SALT_SIZE]) override;
+    void persist() override { persists_++; }
+
+private:
+    bool keySession(uint32_t latencyUs);
+
+    std::atomic<uint32_t> ecdhLatencyUs_;
+    std::atomic<uint32_t> hkdfLatencyUs_;
+    std::atomic<bool>     accept_;
+    std::atomic<bool>     ticketed_;
+    std::atomic<uint32_t> calls_;
+    std::atomic<uint32_t> persists_;
+    uint32_t              session_;   // Bumped per keyed session, fills the salt
+};
@@ -0,0 +1,94 @@
+#include "PsaAeadCipher.h"
+#include <string.h>
+
+PsaAeadCipher::PsaAeadCipher() : keyId(0)
+{
+}
+
+PsaAeadCipher::~PsaAeadCipher()
+{
+    end();
+}
+
+// Import the session key once; PSA keeps the expanded schedule with the key slot
+int PsaAeadCipher::begin(const uint8_t key[KEY_SIZE])
+{
+    end();
+
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_AES);
+    psa_set_key_bits(&attributes, KEY_SIZE * 8);
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_algorithm(&attributes, PSA_ALG_GCM);
+
+    psa_status_t status = psa_import_key(&attributes, key, KEY_SIZE, &keyId);
+    psa_reset_key_attributes(&attributes);
+    if (status != PSA_SUCCESS) {
+        keyId = 0;
+        return status;
+    }
+
+    return 0;
+}
+
+// Destroying the key wipes it from the PSA key store
+void PsaAeadCipher::end()
+{
+    if (keyId != 0) {
+        psa_destroy_key(keyId);
+        keyId = 0;
+    }
+}
+
+int PsaAeadCipher::encrypt(const uint8_t iv[IV_SIZE], const uint8_t* plaintext, size_t len,
+                           uint8_t* ciphertext, uint8_t tag[TAG_SIZE])
+{
+    if (keyId == 0) return -1;
+
+    psa_aead_operation_t op = PSA_AEAD_OPERATION_INIT;
+    size_t outLen = 0;
+    size_t finLen = 0;
+    size_t tagLen = 0;
+
+    psa_status_t status = psa_aead_encrypt_setup(&op, keyId, PSA_ALG_GCM);
+    if (status == PSA_SUCCESS) status = psa_aead_set_nonce(&op, iv, IV_SIZE);
+    if (status == PSA_SUCCESS) status = psa_aead_update(&op, plaintext, len, ciphertext, len, &outLen);
+    if (status == PSA_SUCCESS) status = psa_aead_finish(&op, ciphertext + outLen, len - outLen, &finLen,
+                                                        tag, TAG_SIZE, &tagLen);
+    if (status != PSA_SUCCESS) {
+        psa_aead_abort(&op);
+        return status;
+    }
+
+    return 0;
+}
+
+int PsaAeadCipher::decrypt(const uint8_t iv[IV_SIZE], const uint8_t* ciphertext, size_t len,
+                           const uint8_t tag[TAG_SIZE], uint8_t* plaintext_out)
+{
+    if (keyId == 0) return -1;
+
+    psa_aead_operation_t op = PSA_AEAD_OPERATION_INIT;
+    size_t outLen = 0;
+    size_t finLen = 0;
+
+    psa_status_t status = psa_aead_decrypt_setup(&op, keyId, PSA_ALG_GCM);
+    if (status == PSA_SUCCESS) status = psa_aead_set_nonce(&op, iv, IV_SIZE);
+    if (status == PSA_SUCCESS) status = psa_aead_update(&op, ciphertext, len, plaintext_out, len, &outLen);
+    if (status == PSA_SUCCESS) status = psa_aead_verify(&op, plaintext_out + outLen, len - outLen, &finLen,
+                                                        tag, TAG_SIZE);
+    if (status != PSA_SUCCESS) {
+        // update() has already released unauthenticated plaintext; don't leave it behind
+        psa_aead_abort(&op);
+        memset(plaintext_out, 0, len);
+        return status;
+    }
+
+    return 0;
+}
+
+// PSA copies caller buffers internally, so input and output may be the same buffer
+int PsaAeadCipher::decryptInPlace(const uint8_t iv[IV_SIZE], uint8_t* buf, size_t len, const uint8_t tag[TAG_SIZE])
+{
+    return decrypt(iv, buf, len, tag, buf);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <psa/crypto.h>
+#include "AeadParams.h"
+
+/// @brief AES-256-GCM through the PSA AEAD API.
+/// @details The session key is imported once as a volatile PSA key in begin() so each
+/// packet only pays for setup/nonce/update/verify through whichever PSA driver the
+/// build provides (the ESP AES accelerator when CONFIG_MBEDTLS_HARDWARE_AES is set).
+/// Uses the multi-part API because the packet tag is not stored after the ciphertext.
+/// psa_crypto_init() must have run (SecureSession::init()).
+class PsaAeadCipher : public AeadParams {
+public:
+    PsaAeadCipher();
+    ~PsaAeadCipher();
+
+    // Import a new session key. Any previous key is destroyed first.
+    int begin(const uint8_t key[KEY_SIZE]);
+
+    // Destroy the imported key. Safe to call when not keyed.
+    void end();
+
+    bool ready() const { return keyId != 0; }
+
+    // Encrypt plaintext into ciphertext (may alias) and produce the auth tag
+    int encrypt(const uint8_t iv[IV_SIZE], const uint8_t* plaintext, size_t len,
+                uint8_t* ciphertext, uint8_t tag[TAG_SIZE]);
+
+    // Authenticate and decrypt ciphertext into plaintext_out (may alias)
+    int decrypt(const uint8_t iv[IV_SIZE], const uint8_t* ciphertext, size_t len,
+                const uint8_t tag[TAG_SIZE], uint8_t* plaintext_out);
+
+    // Authenticate and decrypt buf in place; buf is zeroed if authentication fails
+    int decryptInPlace(const uint8_t iv[IV_SIZE], uint8_t* buf, size_t len, const uint8_t tag[TAG_SIZE]);
+
+private:
+    psa_key_id_t keyId;
+};
@@ -2,12 +2,15 @@
 #include <nvs_flash.h>
 #include <psa/crypto.h>
 #include <esp_timer.h>
+#include <mbedtls/constant_time.h>
+#include <mbedtls/platform.h>
 
 #include "esp_log.h"
 #include "SecureSession.h"
 #include "StateManager.h"
 #include "NeoPixelRMT.h"
 #include "espHID.h"
+#include "HandshakeArena.h"
 
 // USE_SOFTWARE_CRYPTO is injected by CMakeLists.txt based on CONFIG_TOOTHPASTE_SOFTWARE_CRYPTO
 static const char* TAG = "SESSION";
@@ -15,12 +18,110 @@ static const char* TAG = "SESSION";
 psa_key_id_t private_key_id = 0;  // Stores the ECDH private key ID
 Preferences preferences; // Preferences for storing data
 
+// Namespaces the handshake path reads and writes, opened once in init() so a handshake never
+// opens NVS (which allocates a handle)
+static Preferences ticketStore;   // "resume": resumption tickets
+#ifdef USE_SOFTWARE_CRYPTO
+static Preferences swKeyStore;    // "swpkeys": private keys per peer
+#endif
+
+// Resumption ticket derivation; must match the client. Tickets live in NVS namespace "resume"
+// under the peer's label.
+static const uint8_t TICKET_INFO[] = "toothpaste-resume";
+static const uint8_t TICKET_ID_INFO[] = "toothpaste-ticket-id";
+static const uint8_t TICKET_SALT[32] = {0};
+
+// Resumptions a ticket chain allows before the peer has to go through ECDH again. A stored
+// ticket is its secret followed by the count of resumptions that led to it.
+#ifdef CONFIG_TOOTHPASTE_RESUME_TICKET_USES
+#define TICKET_MAX_RESUMES CONFIG_TOOTHPASTE_RESUME_TICKET_USES
+#else
+#define TICKET_MAX_RESUMES 0
+#endif
+#define TICKET_RECORD_SIZE (SecureSession::ENC_KEYSIZE + 1)
+
+// mbedTLS / PSA allocations on the bound handshake task come from a static arena, so a
+// reconnect makes no heap allocations; other tasks keep ESP-IDF's allocator. Blocks may be
+// freed from any task (endSession() frees the session cipher from the BLE host task).
+#ifdef CONFIG_TOOTHPASTE_HANDSHAKE_ARENA_SIZE
+#define HANDSHAKE_ARENA_SIZE CONFIG_TOOTHPASTE_HANDSHAKE_ARENA_SIZE
+#else
+#define HANDSHAKE_ARENA_SIZE 8192
+#endif
+extern "C" void* esp_mbedtls_mem_calloc(size_t n, size_t size);
+extern "C" void esp_mbedtls_mem_free(void* ptr);
+
+alignas(HandshakeArena::ALIGN) static uint8_t handshakeArenaBuffer[HANDSHAKE_ARENA_SIZE];
+static HandshakeArena handshakeArena(handshakeArenaBuffer, sizeof(handshakeArenaBuffer));
+static portMUX_TYPE handshakeArenaLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t volatile handshakeTask = nullptr;
+static volatile uint32_t handshakeSpills = 0;   // Allocations a full arena passed to the heap
+
+static void* handshakeCalloc(size_t n, size_t size)
+{
+    if (handshakeTask != nullptr && xTaskGetCurrentTaskHandle() == handshakeTask) {
+        portENTER_CRITICAL(&handshakeArenaLock);
+        void* p = handshakeArena.allocate(n, size);
+        portEXIT_CRITICAL(&handshakeArenaLock);
+        if (p != nullptr) return p;
+        handshakeSpills++;
+    }
+    return esp_mbedtls_mem_calloc(n, size);
+}
+
+static void handshakeFree(void* ptr)
+{
+    if (ptr == nullptr) return;
+    if (handshakeArena.owns(ptr)) {
+        portENTER_CRITICAL(&handshakeArenaLock);
+        handshakeArena.release(ptr);
+        portEXIT_CRITICAL(&handshakeArenaLock);
+        return;
+    }
+    esp_mbedtls_mem_free(ptr);
+}
+
+// Log how much of the arena the last handshake used, and warn if it spilled to the heap
+static void reportHandshakeArena()
+{
+    if (handshakeTask == nullptr) return;
+
+    portENTER_CRITICAL(&handshakeArenaLock);
+    size_t peak = handshakeArena.peak();
+    handshakeArena.resetPeak();
+    uint32_t spills = handshakeSpills;
+    handshakeSpills = 0;
+    portEXIT_CRITICAL(&handshakeArenaLock);
+
+    if (spills > 0) {
+        ESP_LOGW(TAG, "Handshake arena full: %lu allocations went to the heap (peak %u/%u B), "
+                 "raise CONFIG_TOOTHPASTE_HANDSHAKE_ARENA_SIZE", (unsigned long)spills,
+                 (unsigned)peak, (unsigned)handshakeArena.capacity());
+    } else {
+        ESP_LOGD(TAG, "Handshake arena peak %u/%u B", (unsigned)peak, (unsigned)handshakeArena.capacity());
+    }
+}
+
+// Keypair pool worker: below the BLE and HID tasks so it only uses idle time
+#define KEYPAIR_TASK_PRIORITY   (tskIDLE_PRIORITY + 1)
+#define KEYPAIR_TASK_STACK      6144
+
 // Class constructor
-SecureSession::SecureSession() : sharedReady(false), aesKeyReady(false)
+SecureSession::SecureSession() : hmacReady(false), sharedReady(false), aesKeyReady(false), sessionResumes(0), keypairTask(nullptr)
 {
     // PSA Crypto initialization handled in init() method
     private_key_id = 0;
-    mbedtls_gcm_init(&gcm);
+    cipherLock = xSemaphoreCreateMutex();
+    keyLock = xSemaphoreCreateMutex();
+    digestLock = xSemaphoreCreateMutex();
+    mbedtls_md_init(&hmac);
+    labelPeerKey[0] = '\0';
+    labelCache[0] = '\0';
+#ifdef USE_SOFTWARE_CRYPTO
+    keypairPoolCount = 0;
+#else
+    preparedSlot = SlotManager::INVALID_SLOT;
+#endif
     memset(sharedSecret, 0, ENC_KEYSIZE);
     memset(aesKey, 0, ENC_KEYSIZE);
 }
@@ -28,18 +129,44 @@ SecureSession::SecureSession() : sharedReady(false), aesKeyReady(false)
 // Class destructor
 SecureSession::~SecureSession()
 {
+    if (keypairTask != nullptr) {
+        vTaskDelete(keypairTask);
+        keypairTask = nullptr;
+    }
+
     // Destroy the PSA key if it exists
     if (private_key_id != 0) {
         psa_destroy_key(private_key_id);
         private_key_id = 0;
     }
 
+#ifdef USE_SOFTWARE_CRYPTO
+    // Destroy keypairs that were never used for pairing
+    while (keypairPoolCount > 0) {
+        psa_destroy_key(keypairPool[--keypairPoolCount].id);
+    }
+#endif
+
     // Clear secrets from RAM
     memset(sharedSecret, 0, ENC_KEYSIZE);
     memset(aesKey, 0, ENC_KEYSIZE);
     aesKeyReady = false;
 
-    mbedtls_gcm_free(&gcm);
+    cipher.end();
+    if (cipherLock != nullptr) {
+        vSemaphoreDelete(cipherLock);
+        cipherLock = nullptr;
+    }
+    if (keyLock != nullptr) {
+        vSemaphoreDelete(keyLock);
+        keyLock = nullptr;
+    }
+
+    mbedtls_md_free(&hmac);
+    if (digestLock != nullptr) {
+        vSemaphoreDelete(digestLock);
+        digestLock = nullptr;
+    }
 }
 
 // Initialize PSA Crypto subsystem
@@ -76,17 +203,47 @@ int SecureSession::init()
     // Initialize the LRU slot manager (used by both hardware and software paths)
     slotManager_.load();
 
+    // Everything the handshake path needs from the heap is set up here, once
+    ticketStore.begin("resume", false);
+#ifdef USE_SOFTWARE_CRYPTO
+    swKeyStore.begin("swpkeys", false);
+#endif
+    if (mbedtls_md_setup(&hmac, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 1) != 0) {
+        ESP_LOGE(TAG, "HMAC context setup failed");
+        return -1;
+    }
+    hmacReady = true;
+
 #ifdef USE_SOFTWARE_CRYPTO
     ESP_LOGI(TAG, "Crypto mode: SOFTWARE (mbedtls/PSA)");
 #else
     ESP_LOGI(TAG, "Crypto mode: HARDWARE (ATECC608B)");
 #endif
     ESP_LOGI(TAG, "PSA Crypto initialized");
+
+    // Keep a pairing keypair ready from here on
+    if (keypairTask == nullptr) {
+        xTaskCreate(keypairPoolTask, "KeypairPool", KEYPAIR_TASK_STACK, this, KEYPAIR_TASK_PRIORITY, &keypairTask);
+    }
     return 0;
 }
 
 int SecureSession::generateKeypair(uint8_t outPublicKey[PUBKEY_SIZE], size_t& outPubLen)
 {
+    int64_t t0 = esp_timer_get_time();
+    bool pooled = false;
+    int ret = 0;
+
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+
+    // Reserve a slot now; label is unknown until peer public key arrives.
+    // If key exchange fails, call slotManager_.release() to free it.
+    uint8_t slot = slotManager_.reserve();
+    if (slot == SlotManager::INVALID_SLOT) {
+        ESP_LOGE(TAG, "No slot available for keypair");
+        ret = -1;
+    }
+
 #ifdef USE_SOFTWARE_CRYPTO
     // Destroy any existing PSA key
     if (private_key_id != 0) {
@@ -94,58 +251,92 @@ int SecureSession::generateKeypair(uint8_t outPublicKey[PUBKEY_SIZE], size_t& ou
         private_key_id = 0;
     }
 
-    // Reserve LRU slot now; label is unknown until peer public key arrives
-    uint8_t slot = slotManager_.reserve();
-    if (slot == SlotManager::INVALID_SLOT) {
-        ESP_LOGE(TAG, "No LRU slot available for keypair");
-        return -1;
+    if (ret == 0 && keypairPoolCount > 0) {
+        // Take a keypair the pool task generated ahead of time
+        PooledKeypair& kp = keypairPool[--keypairPoolCount];
+        private_key_id = kp.id;
+        memcpy(outPublicKey, kp.publicKey, PUBKEY_SIZE);
+        memset(&kp, 0, sizeof(kp));
+        pooled = true;
+    }
+    else if (ret == 0) {
+        ret = generatePsaKeypair(&private_key_id, outPublicKey);
+        if (ret != 0) slotManager_.release();
+    }
+
+#else
+    if (ret == 0 && slot == preparedSlot) {
+        // The reserved slot is the free one the pool task already generated a key into
+        memcpy(outPublicKey, preparedPublicKey, PUBKEY_SIZE);
+        preparedSlot = SlotManager::INVALID_SLOT;
+        pooled = true;
+    }
+    else if (ret == 0) {
+        ESP_LOGD(TAG, "Reserved ATECC slot %u for keypair generation", slot);
+        ret = generateSlotKeypair(slot, outPublicKey);
+        if (ret != 0) slotManager_.release();
     }
+#endif
+
+    xSemaphoreGive(keyLock);
 
-    // Generate ECDH keypair via PSA with export flag so private key can be persisted to NVS
+    if (ret != 0) {
+        return ret;
+    }
+    outPubLen = PUBKEY_SIZE;
+
+#ifdef USE_SOFTWARE_CRYPTO
+    // Replace the pooled keypair in the background
+    if (keypairTask != nullptr) {
+        xTaskNotifyGive(keypairTask);
+    }
+#endif
+
+    ESP_LOGI(TAG, "Keypair %s in %lld us", pooled ? "taken from pool" : "generated", esp_timer_get_time() - t0);
+    return 0;
+}
+
+#ifdef USE_SOFTWARE_CRYPTO
+// Generate an ECDH keypair via PSA with export flag so the private key can be persisted to NVS
+int SecureSession::generatePsaKeypair(psa_key_id_t* keyId, uint8_t outPublicKey[PUBKEY_SIZE])
+{
     psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
     psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
     psa_set_key_bits(&attributes, 256);
     psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_DERIVE | PSA_KEY_USAGE_EXPORT);
     psa_set_key_algorithm(&attributes, PSA_ALG_ECDH);
-    psa_status_t status = psa_generate_key(&attributes, &private_key_id);
+    psa_status_t status = psa_generate_key(&attributes, keyId);
     if (status != PSA_SUCCESS) {
         ESP_LOGE(TAG, "PSA key generation failed: %ld", (long)status);
-        slotManager_.release();
-        private_key_id = 0;
+        *keyId = 0;
         return -1;
     }
 
     // Export uncompressed public key (65 bytes: 0x04 || X || Y), then compress to 33 bytes
     uint8_t public_key_uncompressed[65];
     size_t public_key_len = 0;
-    status = psa_export_public_key(private_key_id, public_key_uncompressed, 65, &public_key_len);
+    status = psa_export_public_key(*keyId, public_key_uncompressed, 65, &public_key_len);
     if (status != PSA_SUCCESS || public_key_len != 65) {
         ESP_LOGE(TAG, "PSA public key export failed: %ld", (long)status);
-        slotManager_.release();
+        psa_destroy_key(*keyId);
+        *keyId = 0;
         return -1;
     }
 
     outPublicKey[0] = (public_key_uncompressed[64] & 0x01) ? 0x03 : 0x02;
     memcpy(&outPublicKey[1], &public_key_uncompressed[1], 32);
-    outPubLen = PUBKEY_SIZE;
+    return 0;
+}
 
 #else
-    // Reserve an ATECC slot now; label is unknown until peer public key arrives.
-    // If key exchange fails, call slotManager_.release() to free it.
-    uint8_t slot = slotManager_.reserve();
-    if (slot == SlotManager::INVALID_SLOT) {
-        ESP_LOGE(TAG, "No ATECC slot available for keypair");
-        return -1;
-    }
-    ESP_LOGD(TAG, "Reserved ATECC slot %u for keypair generation", slot);
-
-    // Generate the keypair
+// Generate a keypair in an ATECC slot; the private key never leaves the chip
+int SecureSession::generateSlotKeypair(uint8_t slot, uint8_t outPublicKey[PUBKEY_SIZE])
+{
     uint8_t public_key_uncompressed[64];
 
     int ret = atcab_genkey(slot, public_key_uncompressed);
     if (ret != 0) {
         ESP_LOGE(TAG, "ATECC key generation failed: %d", ret);
-        slotManager_.release();
         return -1;
     }
     printBase64(public_key_uncompressed, sizeof(public_key_uncompressed));
@@ -153,11 +344,69 @@ int SecureSession::generateKeypair(uint8_t outPublicKey[PUBKEY_SIZE], size_t& ou
     // Compress the public key: take prefix byte and X coordinate
     outPublicKey[0] = (public_key_uncompressed[63] & 0x01) ? 0x03 : 0x02;  // 0x03 if Y is odd, 0x02 if even
     memcpy(&outPublicKey[1], &public_key_uncompressed[0], 32);  // Copy X coordinate
-    outPubLen = PUBKEY_SIZE;  // 33 bytes
+    return 0;
+}
 #endif
 
-    ESP_LOGI(TAG, "Keypair generated");
-    return 0;
+// Generate keypairs until the pool is full (software) or a free slot holds a fresh key (ATECC)
+void SecureSession::refillKeypairPool()
+{
+#ifdef USE_SOFTWARE_CRYPTO
+    while (true) {
+        xSemaphoreTake(keyLock, portMAX_DELAY);
+        bool full = keypairPoolCount >= CONFIG_TOOTHPASTE_KEYPAIR_POOL_SIZE;
+        xSemaphoreGive(keyLock);
+        if (full) return;
+
+        // Generate outside the lock so a pairing or reconnect never waits behind the pool
+        int64_t t0 = esp_timer_get_time();
+        PooledKeypair kp;
+        if (generatePsaKeypair(&kp.id, kp.publicKey) != 0) return;
+
+        xSemaphoreTake(keyLock, portMAX_DELAY);
+        bool stored = keypairPoolCount < CONFIG_TOOTHPASTE_KEYPAIR_POOL_SIZE;
+        if (stored) {
+            keypairPool[keypairPoolCount++] = kp;
+        }
+        size_t count = keypairPoolCount;
+        xSemaphoreGive(keyLock);
+
+        if (!stored) {
+            psa_destroy_key(kp.id);
+            return;
+        }
+        ESP_LOGI(TAG, "Pairing keypair ready (%u/%u) in %lld us", (unsigned)count,
+                 (unsigned)CONFIG_TOOTHPASTE_KEYPAIR_POOL_SIZE, esp_timer_get_time() - t0);
+    }
+
+#else
+    // The ATECC runs one command at a time, so generate under the lock
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+    if (preparedSlot == SlotManager::INVALID_SLOT) {
+        // Only a free slot: generating into the LRU slot would evict its peer before anyone pairs
+        uint8_t slot = slotManager_.reserveFree();
+        if (slot != SlotManager::INVALID_SLOT) {
+            int64_t t0 = esp_timer_get_time();
+            if (generateSlotKeypair(slot, preparedPublicKey) == 0) {
+                preparedSlot = slot;
+                ESP_LOGI(TAG, "Pairing keypair ready in ATECC slot %u in %lld us", slot, esp_timer_get_time() - t0);
+            } else {
+                slotManager_.release();
+            }
+        }
+    }
+    xSemaphoreGive(keyLock);
+#endif
+}
+
+// Low-priority worker that keeps a pairing keypair ready; woken whenever one is used
+void SecureSession::keypairPoolTask(void* arg)
+{
+    SecureSession* session = static_cast<SecureSession*>(arg);
+    while (true) {
+        session->refillKeypairPool();
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
 }
 
 // Send the public key over HID and wait for the peer public key
@@ -166,6 +415,8 @@ static void sendPublicKey(void* arg) {
   ESP_LOGI("SESSION", "Sending public key: %s", session->base64pubKey);
   sendString(session->base64pubKey); // Send the public key to the client over HID
   sendString("\n");
+  endStringJob(LANE_INTERACTIVE, session->pairingStartUs); // Logged once typed: hold-to-typed time
+  ESP_LOGI("SESSION", "Public key queued %lld us after pairing hold", esp_timer_get_time() - session->pairingStartUs);
   led.blinkEnd(); // Stop blinking
 
   // Finish the handshake here
@@ -173,15 +424,16 @@ static void sendPublicKey(void* arg) {
   //enablePairingMode(); // Set ble to interpret the next write as a peer public key
 }
 
-// Enter pairing mode, generate a keypair, and send the public key to the transmitter
+// Enter pairing mode, take a keypair, and send the public key to the transmitter
 void SecureSession::enterPairingMode() {
+  pairingStartUs = esp_timer_get_time();
   ESP_LOGI(TAG, "Entering pairing mode");
   stateManager->setState(PAIRING);
 
   uint8_t pubKey[PUBKEY_SIZE];
   size_t pubLen;
 
-  int ret = generateKeypair(pubKey, pubLen); // Generate the compressed public key in pairing mode
+  int ret = generateKeypair(pubKey, pubLen); // Compressed public key, usually from the pool
 
   // Successful keygen returns 0
   if (!ret) {
@@ -193,7 +445,8 @@ void SecureSession::enterPairingMode() {
     // Print Public Key to Serial
     ESP_LOGI(TAG, "Public key generated: %s", base64pubKey);
 
-    // Create a one-shot timer to send the public key after 5 seconds
+#if CONFIG_TOOTHPASTE_PAIRING_KEY_DELAY_MS > 0
+    // Create a one-shot timer to send the public key after the configured delay
     esp_timer_create_args_t timer_args = {
       .callback = &sendPublicKey,
       .arg = this,
@@ -202,7 +455,10 @@ void SecureSession::enterPairingMode() {
     };
     esp_timer_handle_t oneShotTimer;
     esp_timer_create(&timer_args, &oneShotTimer);
-    esp_timer_start_once(oneShotTimer, 5000000); // 5 seconds
+    esp_timer_start_once(oneShotTimer, CONFIG_TOOTHPASTE_PAIRING_KEY_DELAY_MS * 1000);
+#else
+    sendPublicKey(this); // Key is ready, type it now
+#endif
   }
 
   else {
@@ -217,6 +473,27 @@ void SecureSession::enterPairingMode() {
 // Compute shared secret given the peer's public key.
 // Stores the peer key mapping to NVS and derives the session AES key.
 int SecureSession::computeSharedSecret(const uint8_t peerPublicKey[PUBKEY_SIZE * 2], size_t peerPubLen, const char* base64pubKey)
+{
+    // Held from ECDH through key derivation: on the ATECC the secret waits in TempKey in between
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+    int ret = computeSharedSecretLocked(peerPublicKey, peerPubLen, base64pubKey);
+#ifndef USE_SOFTWARE_CRYPTO
+    // A failed pairing hands its slot back; the key in it was typed out, so have the pool
+    // task generate a fresh one there instead of waiting for the next successful pairing
+    if (ret != 0) slotManager_.release();
+#endif
+    xSemaphoreGive(keyLock);
+
+#ifndef USE_SOFTWARE_CRYPTO
+    if (ret != 0 && keypairTask != nullptr) {
+        xTaskNotifyGive(keypairTask);
+    }
+#endif
+    reportHandshakeArena();
+    return ret;
+}
+
+int SecureSession::computeSharedSecretLocked(const uint8_t peerPublicKey[PUBKEY_SIZE * 2], size_t peerPubLen, const char* base64pubKey)
 {
     ESP_LOGD(TAG, "Computing shared secret, peer key len=%u", (unsigned)peerPubLen);
 
@@ -259,8 +536,7 @@ int SecureSession::computeSharedSecret(const uint8_t peerPublicKey[PUBKEY_SIZE *
         current_slot, trimmedKey, nullptr, nullptr);
     if (ecdh_ret != 0) {
         ESP_LOGE(TAG, "ECDH key agreement failed: %d", ecdh_ret);
-        slotManager_.release(); // Free the reserved slot on failure
-        return -1;
+        return -1;  // computeSharedSecret() frees the reserved slot
     }
     ESP_LOGI(TAG, "Shared secret computed");
 #endif
@@ -286,7 +562,7 @@ int SecureSession::computeSharedSecret(const uint8_t peerPublicKey[PUBKEY_SIZE *
 
 // Store peer key mapping to NVS for persistence across reboots.
 // Software mode also persists the raw private key bytes (keyed by peer public key hash).
-int SecureSession::commitPeerKey(std::string base64Input)
+int SecureSession::commitPeerKey(const char* base64Input)
 {
     if (!sharedReady){
         ESP_LOGD(TAG, "commitPeerKey called but shared secret is not ready");
@@ -294,16 +570,17 @@ int SecureSession::commitPeerKey(std::string base64Input)
     }
 
     // Hash the base64-encoded public key to create a fixed-length label for slot management
-    String label = hashKey(base64Input.c_str());
+    char label[SlotManager::LABEL_LEN + 1];
+    peerLabel(base64Input, label);
 
     // Finalize the slot reserved during generateKeypair().
     // Falls back to assign() if no reservation is pending.
     char evicted[SlotManager::LABEL_LEN + 1];
-    uint8_t slot = slotManager_.commit(label.c_str(), evicted);
+    uint8_t slot = slotManager_.commit(label, evicted);
     if (slot == SlotManager::INVALID_SLOT) {
         ESP_LOGW(TAG, "No pending reservation; falling back to assign()");
         bool is_new = false;
-        slot = slotManager_.assign(label.c_str(), &is_new, evicted);
+        slot = slotManager_.assign(label, &is_new, evicted);
     }
 
     if (slot == SlotManager::INVALID_SLOT) {
@@ -311,13 +588,16 @@ int SecureSession::commitPeerKey(std::string base64Input)
         return -1;
     }
 
+    // An evicted peer's resumption ticket goes with its slot
+    if (evicted[0] != '\0') {
+        ticketStore.remove(evicted);
+    }
+
 #ifdef USE_SOFTWARE_CRYPTO
     // Remove evicted peer's private key from NVS before storing the new one
     if (evicted[0] != '\0') {
         ESP_LOGW(TAG, "Removing stale private key for evicted label: %s", evicted);
-        preferences.begin("swpkeys", false);
-        preferences.remove(evicted);
-        preferences.end();
+        swKeyStore.remove(evicted);
     }
 
     // Export raw private key scalar (32 bytes) and persist to NVS keyed by peer's public key hash
@@ -328,9 +608,7 @@ int SecureSession::commitPeerKey(std::string base64Input)
         ESP_LOGE(TAG, "Failed to export private key for NVS storage: %ld", (long)status);
         return -1;
     }
-    preferences.begin("swpkeys", false);
-    preferences.putBytes(label.c_str(), privKeyBytes, privKeyLen);
-    preferences.end();
+    swKeyStore.putBytes(label, privKeyBytes, privKeyLen);
     memset(privKeyBytes, 0, sizeof(privKeyBytes));
 
 #else
@@ -339,6 +617,11 @@ int SecureSession::commitPeerKey(std::string base64Input)
         ESP_LOGW(TAG, "Removing stale secret for evicted label: %s", evicted);
         preferences.remove(evicted);
     }
+
+    // The reservation is spent; prepare a key in the next free slot
+    if (keypairTask != nullptr) {
+        xTaskNotifyGive(keypairTask);
+    }
 #endif
 
     return 0;
@@ -347,34 +630,11 @@ int SecureSession::commitPeerKey(std::string base64Input)
 // Derive AES key from the session's shared secret
 int SecureSession::deriveAESKeyFromSecret(const char* base64pubKey)
 {
+    sessionResumes = 0;  // A full handshake starts a new ticket chain
+
 #ifdef USE_SOFTWARE_CRYPTO
     // Software: HKDF-SHA256 from sharedSecret held in RAM
-    const uint8_t info[] = "aes-gcm-256"; // Must match peer implementation
-    size_t info_len = sizeof(info) - 1;
-
-    psa_status_t status = psa_generate_random(sessionSalt, sizeof(sessionSalt));
-    if (status != PSA_SUCCESS) {
-        ESP_LOGE(TAG, "Failed to generate HKDF salt: %ld", (long)status);
-        return -1;
-    }
-
-    ESP_LOGD(TAG, "Session salt:");
-    printBase64(sessionSalt, sizeof(sessionSalt));
-
-    int ret = hkdf_sha256(
-        sessionSalt, sizeof(sessionSalt),        // random salt for this session
-        sharedSecret, sizeof(sharedSecret),      // session's shared secret
-        info, info_len,                          // context info
-        aesKey, ENC_KEYSIZE                      // output directly to member variable
-    );
-
-    if (ret == 0) {
-        ESP_LOGI(TAG, "AES key derived");
-        aesKeyReady = true;
-    } else {
-        ESP_LOGE(TAG, "AES key derivation failed: %d", ret);
-    }
-    return ret;
+    return deriveSessionKey(sharedSecret);
 
 #else
     // ATECC: HKDF via on-chip KDF; shared secret stays in TempKey, never touches RAM
@@ -413,18 +673,75 @@ int SecureSession::deriveAESKeyFromSecret(const char* base64pubKey)
         aesKey,
         nullptr);
 
-    if (ret == 0) {
-        ESP_LOGI(TAG, "AES key derived");
-        aesKeyReady = true;
-    } else {
+    if (ret != 0) {
         ESP_LOGE(TAG, "HKDF Expand failed: %d", ret);
+        return ret;
     }
 
-    return ret;
+    ESP_LOGI(TAG, "AES key derived");
+    return keySessionCipher();
 #endif
 }
 
-// Encrypt a given text string using gcm
+// HKDF-SHA256 the session key from ikm (shared secret or resumption ticket) with a fresh salt
+int SecureSession::deriveSessionKey(const uint8_t ikm[ENC_KEYSIZE])
+{
+    const uint8_t info[] = "aes-gcm-256"; // Must match peer implementation
+    size_t info_len = sizeof(info) - 1;
+
+    psa_status_t status = psa_generate_random(sessionSalt, sizeof(sessionSalt));
+    if (status != PSA_SUCCESS) {
+        ESP_LOGE(TAG, "Failed to generate HKDF salt: %ld", (long)status);
+        return -1;
+    }
+
+    ESP_LOGD(TAG, "Session salt:");
+    printBase64(sessionSalt, sizeof(sessionSalt));
+
+    int ret = hkdf_sha256(
+        sessionSalt, sizeof(sessionSalt),        // random salt for this session
+        ikm, ENC_KEYSIZE,                        // shared secret or ticket secret
+        info, info_len,                          // context info
+        aesKey, ENC_KEYSIZE                      // output directly to member variable
+    );
+
+    if (ret != 0) {
+        ESP_LOGE(TAG, "AES key derivation failed: %d", ret);
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "AES key derived");
+    return keySessionCipher();
+}
+
+// Expand the freshly derived session key into the persistent GCM context.
+// Replaces any previous session's key schedule (rekey).
+int SecureSession::keySessionCipher()
+{
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    int ret = cipher.begin(aesKey);
+    aesKeyReady = (ret == 0);
+    xSemaphoreGive(cipherLock);
+
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Session cipher setup failed: %d", ret);
+    }
+    return ret;
+}
+
+// Tear down the session key on disconnect so a stale key can never decrypt a new link
+void SecureSession::endSession()
+{
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    cipher.end();
+    memset(aesKey, 0, ENC_KEYSIZE);
+    aesKeyReady = false;
+    xSemaphoreGive(cipherLock);
+
+    ESP_LOGD(TAG, "Session cipher torn down");
+}
+
+// Encrypt a given text string using the session GCM context
 int SecureSession::encrypt(
     const uint8_t* plaintext, // Text data to be encrypted
     size_t plaintext_len,     // Len of plaintext
@@ -441,22 +758,10 @@ int SecureSession::encrypt(
         return -1;
     }
 
-    // Use the session AES key for encryption
-    mbedtls_gcm_init(&gcm);
-    int ret = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, aesKey, ENC_KEYSIZE * 8);
-    if (ret != 0)
-        return ret;
-
     // Generate ciphertext using GCM to ensure data integrity
-    ret = mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT,
-        plaintext_len,
-        iv, IV_SIZE,
-        nullptr, 0, // no additional data
-        plaintext,
-        ciphertext,
-        TAG_SIZE,
-        tag);
-    mbedtls_gcm_free(&gcm);
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    int ret = cipher.encrypt(iv, plaintext, plaintext_len, ciphertext, tag);
+    xSemaphoreGive(cipherLock);
     return ret;
 }
 
@@ -469,52 +774,43 @@ int SecureSession::decrypt(
     uint8_t* plaintext_out,
     const char* base64pubKey)
 {
-    // Use the session AES key for decryption
-    mbedtls_gcm_init(&gcm);
-    int ret = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, aesKey, ENC_KEYSIZE * 8);
-    if (ret != 0)
-        return ret;
-
-    // Decrypt the ciphertext using the AES key
-    ret = mbedtls_gcm_auth_decrypt(&gcm,
-        ciphertext_len,
-        iv, IV_SIZE,
-        nullptr, 0,
-        tag,
-        TAG_SIZE,
-        ciphertext,
-        plaintext_out
-    );
-    mbedtls_gcm_free(&gcm);
+    // Decrypt the ciphertext using the warm session key schedule
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    int ret = cipher.decrypt(iv, ciphertext, ciphertext_len, tag, plaintext_out);
+    xSemaphoreGive(cipherLock);
 
     plaintext_out[ciphertext_len] = '\0';
     return ret;
 }
 
-// Decrypt a toothPaste_DataPacket and return the plaintext bytes in decrypted_out
-int SecureSession::decrypt(toothpaste_DataPacket* packet, uint8_t* decrypted_out, const char* base64pubKey)
+// Decrypt a ciphertext buffer in place; the caller owns a buffer of at least len bytes
+int SecureSession::decryptInPlace(const uint8_t iv[IV_SIZE], uint8_t* buffer, size_t len, const uint8_t tag[TAG_SIZE])
 {
-    // Decrypt the packet data
-    int ret = decrypt(
-        packet->iv.bytes,
-        packet->encryptedData.size,
-        packet->encryptedData.bytes,
-        packet->tag.bytes,
-        decrypted_out,
-        base64pubKey
-    );
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    int ret = cipher.decryptInPlace(iv, buffer, len, tag);
+    xSemaphoreGive(cipherLock);
     return ret;
 }
 
 // Check if a peer is enrolled and, if so, compute the shared secret on-the-fly using ECDH
 bool SecureSession::loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubLen, const char* base64pubKey)
 {
-    String label = hashKey(base64pubKey);
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+    bool loaded = loadIfEnrolledLocked(peerPublicKey, peerPubLen, base64pubKey);
+    xSemaphoreGive(keyLock);
+    reportHandshakeArena();
+    return loaded;
+}
+
+bool SecureSession::loadIfEnrolledLocked(const uint8_t* peerPublicKey, size_t peerPubLen, const char* base64pubKey)
+{
+    char label[SlotManager::LABEL_LEN + 1];
+    peerLabel(base64pubKey, label);
 
     // Verify enrollment via LRU slot manager (both hardware and software paths)
-    uint8_t slot = slotManager_.lookup(label.c_str());
+    uint8_t slot = slotManager_.lookup(label);
     if (slot == SlotManager::INVALID_SLOT){
-        ESP_LOGE(TAG, "Slot not found for label: %s", label.c_str());
+        ESP_LOGE(TAG, "Slot not found for label: %s", label);
         return false;
     }
 
@@ -531,17 +827,15 @@ bool SecureSession::loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubL
 
 #ifdef USE_SOFTWARE_CRYPTO
     // Software: load stored private key from NVS, import into PSA, compute ECDH into RAM
-    preferences.begin("swpkeys", true);
-    bool exists = preferences.isKey(label.c_str());
-    size_t storedLen = exists ? preferences.getBytesLength(label.c_str()) : 0;
+    bool exists = swKeyStore.isKey(label);
+    size_t storedLen = exists ? swKeyStore.getBytesLength(label) : 0;
     uint8_t privKeyBytes[ENC_KEYSIZE] = {0};
     if (exists && storedLen == ENC_KEYSIZE) {
-        preferences.getBytes(label.c_str(), privKeyBytes, ENC_KEYSIZE);
+        swKeyStore.getBytes(label, privKeyBytes, ENC_KEYSIZE);
     }
-    preferences.end();
 
     if (!exists || storedLen != ENC_KEYSIZE) {
-        ESP_LOGE(TAG, "Private key not found or wrong size for label: %s", label.c_str());
+        ESP_LOGE(TAG, "Private key not found or wrong size for label: %s", label);
         return false;
     }
 
@@ -567,12 +861,16 @@ bool SecureSession::loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubL
     psa_ret = psa_raw_key_agreement(PSA_ALG_ECDH, private_key_id,
                                      peerPublicKey, peerPubLen,
                                      sharedSecret, ENC_KEYSIZE, &output_len);
+
+    // The key is only needed for this agreement; destroying it hands its memory back now
+    psa_destroy_key(private_key_id);
+    private_key_id = 0;
     if (psa_ret != PSA_SUCCESS) {
         ESP_LOGE(TAG, "ECDH key agreement failed: %ld", (long)psa_ret);
         return false;
     }
     sharedReady = true;
-    ESP_LOGD(TAG, "Computed shared secret for label=%s", label.c_str());
+    ESP_LOGD(TAG, "Computed shared secret for label=%s", label);
 
 #else
     // ATECC: compute shared secret — result goes directly to TempKey, never touches RAM
@@ -587,7 +885,7 @@ bool SecureSession::loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubL
         return false;
     }
     sharedReady = true;
-    ESP_LOGD(TAG, "Computed shared secret for label=%s slot=%u", label.c_str(), slot);
+    ESP_LOGD(TAG, "Computed shared secret for label=%s slot=%u", label, slot);
 #endif
 
     // Derive AES key from the computed shared secret
@@ -600,6 +898,126 @@ bool SecureSession::loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubL
     return true;
 }
 
+// Derive a fresh session key from the peer's resumption ticket. The ticket ID the peer sent
+// must match the stored ticket, so a peer whose ticket went stale falls back to ECDH.
+bool SecureSession::resumeIfTicketed(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen)
+{
+    bool resumed = resumeFromTicket(base64pubKey, ticketId, ticketIdLen);
+    reportHandshakeArena();
+    return resumed;
+}
+
+bool SecureSession::resumeFromTicket(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen)
+{
+    if (ticketId == nullptr || ticketIdLen != TICKET_ID_SIZE) return false;
+
+    // Only enrolled peers resume; a hit also keeps the peer's slot recent
+    char label[SlotManager::LABEL_LEN + 1];
+    peerLabel(base64pubKey, label);
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+    uint8_t slot = slotManager_.lookup(label);
+    xSemaphoreGive(keyLock);
+    if (slot == SlotManager::INVALID_SLOT) {
+        ESP_LOGD(TAG, "No slot for label %s, cannot resume", label);
+        return false;
+    }
+
+    uint8_t ticket[TICKET_RECORD_SIZE];
+    bool exists = ticketStore.isKey(label) && ticketStore.getBytesLength(label) == TICKET_RECORD_SIZE;
+    if (exists) {
+        ticketStore.getBytes(label, ticket, TICKET_RECORD_SIZE);
+    }
+
+    if (!exists) {
+        ESP_LOGD(TAG, "No resumption ticket for label %s", label);
+        return false;
+    }
+
+    uint8_t resumes = ticket[ENC_KEYSIZE];
+    if (resumes >= TICKET_MAX_RESUMES) {
+        ESP_LOGI(TAG, "Resumption ticket for label %s expired after %u resumes", label, resumes);
+        memset(ticket, 0, sizeof(ticket));
+        return false;
+    }
+
+    uint8_t storedId[TICKET_ID_SIZE];
+    int ret = hkdf_sha256(TICKET_SALT, sizeof(TICKET_SALT), ticket, ENC_KEYSIZE,
+                          TICKET_ID_INFO, sizeof(TICKET_ID_INFO) - 1, storedId, sizeof(storedId));
+    if (ret != 0 || mbedtls_ct_memcmp(storedId, ticketId, TICKET_ID_SIZE) != 0) {
+        ESP_LOGW(TAG, "Resumption ticket for label %s does not match", label);
+        memset(ticket, 0, sizeof(ticket));
+        return false;
+    }
+
+    ret = deriveSessionKey(ticket);
+    memset(ticket, 0, sizeof(ticket));
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to derive AES key from resumption ticket: %d", ret);
+        return false;
+    }
+    sessionResumes = resumes + 1;
+    return true;
+}
+
+// Derive the peer's next resumption ticket from the current session key and persist it over
+// the last one, so every ticket keys one session. The peer derives the same ticket from its
+// copy of the key. A chain that used up its resumptions is dropped, so the next reconnect
+// runs ECDH and starts a new one.
+int SecureSession::issueResumeTicket(const char* base64pubKey)
+{
+    char label[SlotManager::LABEL_LEN + 1];
+    peerLabel(base64pubKey, label);
+    if (sessionResumes >= TICKET_MAX_RESUMES) {
+        ESP_LOGI(TAG, "Ticket chain for label %s used up, next reconnect runs ECDH", label);
+        ticketStore.remove(label);
+        return 0;
+    }
+
+    uint8_t ticket[TICKET_RECORD_SIZE];
+
+    xSemaphoreTake(cipherLock, portMAX_DELAY);
+    int ret = aesKeyReady ? hkdf_sha256(TICKET_SALT, sizeof(TICKET_SALT), aesKey, ENC_KEYSIZE,
+                                        TICKET_INFO, sizeof(TICKET_INFO) - 1, ticket, ENC_KEYSIZE)
+                          : -1;
+    xSemaphoreGive(cipherLock);
+    ticket[ENC_KEYSIZE] = sessionResumes;
+
+    if (ret == 0 && ticketStore.putBytes(label, ticket, sizeof(ticket)) != sizeof(ticket)) {
+        ret = -1;
+    }
+
+    memset(ticket, 0, sizeof(ticket));
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to issue resumption ticket: %d", ret);
+    }
+    return ret;
+}
+
+// Serve mbedTLS / PSA allocations made on `task` from the handshake arena
+void SecureSession::bindHandshakeTask(TaskHandle_t task)
+{
+#if defined(MBEDTLS_PLATFORM_MEMORY) && !defined(MBEDTLS_PLATFORM_CALLOC_MACRO)
+    static bool installed = false;
+    if (!installed) {
+        mbedtls_platform_set_calloc_free(handshakeCalloc, handshakeFree);
+        installed = true;
+    }
+    handshakeTask = task;
+    ESP_LOGI(TAG, "Handshake crypto allocates from a %u B arena", (unsigned)handshakeArena.capacity());
+#else
+    (void)task;
+    ESP_LOGW(TAG, "mbedTLS allocator is fixed at build time, handshakes use the heap");
+#endif
+}
+
+// Persist the LRU bump a reconnect left in RAM; runs once CHALLENGE is out
+void SecureSession::persistPeerOrder()
+{
+    xSemaphoreTake(keyLock, portMAX_DELAY);
+    slotManager_.flush();
+    xSemaphoreGive(keyLock);
+}
+
 // Debugging helper to print uint8_t arrays as base64 strings via esp_log
 void SecureSession::printBase64(const uint8_t* data, size_t dataLen)
 {
@@ -629,71 +1047,74 @@ int SecureSession::hkdf_sha256(const uint8_t* salt, size_t salt_len,
     const uint8_t* info, size_t info_len,
     uint8_t* okm, size_t okm_len)
 {
-    int ret = 0;
-    uint8_t pre_key[32]; // SHA-256 output size
+    static constexpr size_t HASH_LEN = 32; // SHA-256 output size
+    uint8_t prk[HASH_LEN];
+    uint8_t t[HASH_LEN];
 
-    // Initialize the hashing context for mbedtls - use SHA256
-    const mbedtls_md_info_t* md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
-    if (!md)
+    if (okm_len > 255 * HASH_LEN)
         return -1;
 
-    // IKM = Input Key Material
-    // HKDF-Extract: pre_key = HMAC(salt, IKM) [IKM is shared secret in case of ECDH]
-    if ((ret = mbedtls_md_hmac(md, salt, salt_len, ikm, ikm_len, pre_key)) != 0)
-        return ret;
+    xSemaphoreTake(digestLock, portMAX_DELAY);
+    int ret = hmacReady ? 0 : -1;
 
-    // HKDF-Expand
-    size_t hash_len = 32;
-    size_t n = (okm_len + hash_len - 1) / hash_len;
-
-    uint8_t t[32];
-    size_t t_len = 0;
+    // IKM = Input Key Material
+    // HKDF-Extract: PRK = HMAC(salt, IKM) [IKM is shared secret in case of ECDH]
+    if (ret == 0) ret = mbedtls_md_hmac_starts(&hmac, salt, salt_len);
+    if (ret == 0) ret = mbedtls_md_hmac_update(&hmac, ikm, ikm_len);
+    if (ret == 0) ret = mbedtls_md_hmac_finish(&hmac, prk);
 
+    // HKDF-Expand: T(i) = HMAC(PRK, T(i-1) || info || i), rekeying the same context per block
     uint8_t counter = 1;
-    size_t pos = 0;
-
-    for (size_t i = 0; i < n; i++)
+    for (size_t pos = 0; ret == 0 && pos < okm_len; counter++)
     {
-        // Create a new context instance for each iteration
-        mbedtls_md_context_t ctx;
-        mbedtls_md_init(&ctx);
-        mbedtls_md_setup(&ctx, md, 1); // HMAC
-
-        mbedtls_md_hmac_starts(&ctx, pre_key, hash_len);
-
-        // Update the temp key (t)
-        if (i != 0)
-            mbedtls_md_hmac_update(&ctx, t, t_len);
-
-        mbedtls_md_hmac_update(&ctx, info, info_len);
-        mbedtls_md_hmac_update(&ctx, &counter, 1);
-        mbedtls_md_hmac_finish(&ctx, t);
-        mbedtls_md_free(&ctx);
-
-        size_t to_copy = (pos + hash_len > okm_len) ? (okm_len - pos) : hash_len;
+        ret = mbedtls_md_hmac_starts(&hmac, prk, HASH_LEN);
+        if (ret == 0 && counter > 1) ret = mbedtls_md_hmac_update(&hmac, t, HASH_LEN);
+        if (ret == 0) ret = mbedtls_md_hmac_update(&hmac, info, info_len);
+        if (ret == 0) ret = mbedtls_md_hmac_update(&hmac, &counter, 1);
+        if (ret == 0) ret = mbedtls_md_hmac_finish(&hmac, t);
+        if (ret != 0) break;
+
+        size_t to_copy = (okm_len - pos < HASH_LEN) ? (okm_len - pos) : HASH_LEN;
         memcpy(okm + pos, t, to_copy);
         pos += to_copy;
-        t_len = hash_len;
-        counter++;
     }
+    xSemaphoreGive(digestLock);
 
-    return 0;
+    memset(prk, 0, sizeof(prk));
+    memset(t, 0, sizeof(t));
+    return ret;
 }
 
-// Hash a public key using MD5
-String SecureSession::hashKey(const char* longKey) {
-  const mbedtls_md_info_t* mdInfo = mbedtls_md_info_from_type(MBEDTLS_MD_MD5);
-  if (!mdInfo) return "";
-
-  unsigned char hash[16]; // 128-bit MD5 digest
-  int ret = mbedtls_md(mdInfo, (const unsigned char*)longKey, strlen(longKey), hash);
-  if (ret != 0) return "";
+// Label a peer by the first LABEL_LEN hex digits of the MD5 of its base64 public key
+void SecureSession::peerLabel(const char* base64pubKey, char label[SlotManager::LABEL_LEN + 1])
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    label[0] = '\0';
+
+    xSemaphoreTake(digestLock, portMAX_DELAY);
+    if (labelCache[0] != '\0' && strncmp(labelPeerKey, base64pubKey, sizeof(labelPeerKey)) == 0) {
+        memcpy(label, labelCache, sizeof(labelCache));
+        xSemaphoreGive(digestLock);
+        return;
+    }
 
-  char hex[33]; // 32 hex chars + null terminator
-  for (int i = 0; i < 16; ++i) {
-    sprintf(hex + i * 2, "%02x", hash[i]);
-  }
-  return String(hex).substring(0, 12); // Use 12-char hash for Preferences key
+    unsigned char hash[16]; // 128-bit MD5 digest
+    const mbedtls_md_info_t* mdInfo = mbedtls_md_info_from_type(MBEDTLS_MD_MD5);
+    size_t keyLen = strlen(base64pubKey);
+    if (mdInfo && mbedtls_md(mdInfo, (const unsigned char*)base64pubKey, keyLen, hash) == 0) {
+        for (size_t i = 0; i < SlotManager::LABEL_LEN / 2; ++i) {
+            label[i * 2] = HEX_DIGITS[hash[i] >> 4];
+            label[i * 2 + 1] = HEX_DIGITS[hash[i] & 0x0f];
+        }
+        label[SlotManager::LABEL_LEN] = '\0';
+
+        // Keys too long to cache are still labelled, just not remembered
+        if (keyLen < sizeof(labelPeerKey)) {
+            memcpy(labelPeerKey, base64pubKey, keyLen + 1);
+            memcpy(labelCache, label, sizeof(labelCache));
+        }
+    }
+    xSemaphoreGive(digestLock);
 }
 
 // Get the device name from storage
@@ -6,6 +6,9 @@
 #include <mbedtls/md.h>
 #include <mbedtls/sha256.h>
 #include <mbedtls/base64.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
 #ifndef USE_SOFTWARE_CRYPTO
 #include "cryptoauthlib.h"
@@ -13,6 +16,7 @@
 
 #include "toothpacket.pb.h"
 #include "SlotManager.h"
+#include "SessionCipher.h"
 
 
 #ifndef SECURESESSION_H
@@ -29,6 +33,7 @@ public:
     static constexpr size_t HEADER_SIZE = 4;     // Size of the header  [packetId(0), slowmode(1), packetNumber(2), totalPackets(3)]
     
     static constexpr size_t MAX_PAIRED_DEVICES = 5; // Number of devices that can be registered as 'transmitters' at once
+    static constexpr size_t TICKET_ID_SIZE = 8;  // Resumption ticket ID carried in AUTH packets
 
     SecureSession();
     ~SecureSession();
@@ -36,15 +41,16 @@ public:
 
     unsigned char sessionSalt[32] = {0}; // Salt for the current session
     char base64pubKey[45] = {0};         // Base64-encoded local public key, populated by enterPairingMode()
+    int64_t pairingStartUs = 0;          // esp_timer time of the last pairing hold, for pairing latency
 
 
-    // Initialize PSA Crypto subsystem; must be called before other operations
+    // Initialize PSA Crypto subsystem and start the keypair pool; must be called before other operations
     int init();
 
-    // Generate ECDH keypair, output public key bytes
+    // Take a pairing keypair made ahead of time (or generate one if none is ready), output public key bytes
     int generateKeypair(uint8_t outPublicKey[PUBKEY_SIZE], size_t& outPubLen);
 
-    // Trigger pairing: generate keypair, encode, set device state, and schedule HID transmission
+    // Trigger pairing: take a keypair, encode, set device state, and type the public key over HID
     void enterPairingMode();
 
     // Compute shared secret given peer public key bytes
@@ -67,14 +73,40 @@ public:
         uint8_t* plaintext_out,
         const char* base64pubKey
     );
-    
-    int decrypt(toothpaste_DataPacket* packet, uint8_t* decrypted_out, const char* base64pubKey);
+
+    // Decrypt a ciphertext buffer in place with the warm session cipher
+    int decryptInPlace(const uint8_t IV[IV_SIZE], uint8_t* buffer, size_t len, const uint8_t TAG[TAG_SIZE]);
+
+    // Wipe the session key and expanded cipher state (disconnect / before rekey)
+    void endSession();
 
     bool isSharedSecretReady() const { return sharedReady; }
+    bool isSessionKeyReady() const { return aesKeyReady; }
 
     // Check if an AUTH packet is known and compute shared secret on-the-fly
     bool loadIfEnrolled(const uint8_t* peerPublicKey, size_t peerPubLen, const char* base64pubKey);
 
+    // Resumption tickets: after every handshake both sides derive a ticket secret from the
+    // session key. A returning peer names its ticket by ID and the next session key comes
+    // from the ticket secret through HKDF alone, skipping ECDH. Each session replaces the
+    // ticket, and after CONFIG_TOOTHPASTE_RESUME_TICKET_USES resumes in a row the peer goes
+    // through ECDH again.
+
+    // Key the session from the peer's stored ticket. False when the peer is not enrolled,
+    // holds no ticket, or names a different one; fall back to loadIfEnrolled() then.
+    bool resumeIfTicketed(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen);
+
+    // Store a ticket derived from the current session key, replacing the peer's last one;
+    // call after every successful handshake
+    int issueResumeTicket(const char* base64pubKey);
+
+    // Write the peer order a reconnect bumped in RAM to NVS; call after the handshake is answered
+    void persistPeerOrder();
+
+    // Serve mbedTLS / PSA allocations made on this task (the crypto worker) from a static
+    // arena, so handshakes make no heap allocations. Other tasks keep the heap.
+    static void bindHandshakeTask(TaskHandle_t task);
+
     // Device name functions 
     bool getDeviceName(String &deviceName);
     bool setDeviceName(const char* deviceName);
@@ -84,33 +116,88 @@ public:
 
 private:
 
-    // The gcm context 
-    mbedtls_gcm_context gcm;
+    // Session AEAD context, keyed once per session in deriveAESKeyFromSecret()
+    SessionCipher cipher;
+    SemaphoreHandle_t cipherLock;  // Serializes packet crypto against endSession() from the BLE host task
+    SemaphoreHandle_t keyLock;     // Serializes keypair generation, slot bookkeeping and ECDH (ATECC commands share TempKey)
     uint8_t sharedSecret[ENC_KEYSIZE]; // Shared secret buffer (RAM in software mode; stays in ATECC TempKey on hardware)
 
 #ifndef USE_SOFTWARE_CRYPTO
     ATCAIfaceCfg cfg;
 #endif
 
+    // Label for a peer's slot and NVS entries: the first LABEL_LEN hex digits of MD5(base64 key).
+    // One handshake asks several times, so the last peer's label is cached. Empty on failure.
+    void peerLabel(const char* base64pubKey, char label[SlotManager::LABEL_LEN + 1]);
+    char labelPeerKey[70];                          // Base64 key the cached label belongs to
+    char labelCache[SlotManager::LABEL_LEN + 1];
+
+    // HMAC-SHA256 context set up once in init() and reused by every hkdf_sha256() call
+    mbedtls_md_context_t hmac;
+    bool hmacReady;
+    SemaphoreHandle_t digestLock;  // Guards hmac and the cached peer label
+
     // Shared secret and session key management
-    String hashKey(const char* longKey);
     bool sharedReady;
     
     // Session AES key - generated once per session from shared secret, used for all packets
     uint8_t aesKey[ENC_KEYSIZE];
     bool aesKeyReady;
+    uint8_t sessionResumes;  // Ticket resumptions since the last ECDH, counted into the next ticket
 
 
     SlotManager slotManager_;
 
+    // Pairing keypairs generated ahead of time by a low-priority task, so a button hold does not
+    // wait for key generation. Software mode pools volatile PSA keys; ATECC mode generates one key
+    // into the next free slot, never into a slot that would evict an enrolled peer.
+    TaskHandle_t keypairTask;
+#ifdef USE_SOFTWARE_CRYPTO
+    struct PooledKeypair {
+        psa_key_id_t id;
+        uint8_t publicKey[PUBKEY_SIZE];
+    };
+    PooledKeypair keypairPool[CONFIG_TOOTHPASTE_KEYPAIR_POOL_SIZE];
+    size_t keypairPoolCount;
+#else
+    uint8_t preparedSlot;                   // Reserved free slot holding a fresh key, or INVALID_SLOT
+    uint8_t preparedPublicKey[PUBKEY_SIZE]; // Compressed public key of the key in preparedSlot
+#endif
+
+    static void keypairPoolTask(void* arg);
+
+    // Generate keypairs until the pool is full (software) or a free slot holds a fresh key (ATECC)
+    void refillKeypairPool();
+
     // Internal helper functions
 
+#ifdef USE_SOFTWARE_CRYPTO
+    // Generate an exportable volatile PSA ECDH keypair and its compressed public key
+    int generatePsaKeypair(psa_key_id_t* keyId, uint8_t outPublicKey[PUBKEY_SIZE]);
+#else
+    // Generate a keypair in an ATECC slot and output its compressed public key
+    int generateSlotKeypair(uint8_t slot, uint8_t outPublicKey[PUBKEY_SIZE]);
+#endif
+
+    // Bodies of computeSharedSecret() and loadIfEnrolled(); caller holds keyLock
+    int computeSharedSecretLocked(const uint8_t peerPublicKey[PUBKEY_SIZE], size_t peerPubLen, const char* base64pubKey);
+    bool loadIfEnrolledLocked(const uint8_t* peerPublicKey, size_t peerPubLen, const char* base64pubKey);
+
+    // Body of resumeIfTicketed()
+    bool resumeFromTicket(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen);
+
     // Persist peer key mapping (and private key in software mode) to NVS after ECDH
-    int commitPeerKey(std::string base64Input);
+    int commitPeerKey(const char* base64Input);
+
+    // Load aesKey into the persistent session cipher
+    int keySessionCipher();
+
+    // Derive aesKey from ikm and a fresh sessionSalt with software HKDF, then key the cipher
+    int deriveSessionKey(const uint8_t ikm[ENC_KEYSIZE]);
     
 
     
-    // HKDF key derivation using SHA-256
+    // HKDF key derivation using SHA-256 on the shared HMAC context; no heap use
     int hkdf_sha256(const uint8_t *salt, size_t salt_len,
                 const uint8_t *ikm, size_t ikm_len,
                 const uint8_t *info, size_t info_len,
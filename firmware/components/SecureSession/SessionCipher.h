@@ -0,0 +1,13 @@
+#pragma once
+#include <sdkconfig.h>
+#include "GcmCipher.h"
+#include "PsaAeadCipher.h"
+
+/// @brief Per-session packet AEAD, backend selected by CONFIG_TOOTHPASTE_AEAD_BACKEND.
+/// @details Both backends expose the same begin/end/encrypt/decrypt interface and stay
+/// keyed for the lifetime of a session. CipherBenchmark times both regardless of choice.
+#ifdef CONFIG_TOOTHPASTE_AEAD_PSA
+using SessionCipher = PsaAeadCipher;
+#else
+using SessionCipher = GcmCipher;
+#endif
@@ -0,0 +1,34 @@
+#include "SessionCryptoBackend.h"
+#include <string.h>
+
+static_assert(sizeof(SecureSession::sessionSalt) == CryptoBackend::SALT_SIZE, "CHALLENGE salt size");
+
+bool SessionCryptoBackend::pair(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey)
+{
+    return session_->computeSharedSecret(peerKey, peerKeyLen, base64pubKey) == 0;
+}
+
+bool SessionCryptoBackend::resume(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen)
+{
+    return session_->resumeIfTicketed(base64pubKey, ticketId, ticketIdLen);
+}
+
+bool SessionCryptoBackend::reconnect(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey)
+{
+    return session_->loadIfEnrolled(peerKey, peerKeyLen, base64pubKey);
+}
+
+bool SessionCryptoBackend::issueTicket(const char* base64pubKey)
+{
+    return session_->issueResumeTicket(base64pubKey) == 0;
+}
+
+void SessionCryptoBackend::sessionSalt(uint8_t out[SALT_SIZE])
+{
+    memcpy(out, session_->sessionSalt, SALT_SIZE);
+}
+
+void SessionCryptoBackend::persist()
+{
+    session_->persistPeerOrder();
+}
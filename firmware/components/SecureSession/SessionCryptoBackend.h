@@ -0,0 +1,19 @@
+#pragma once
+#include "CryptoBackend.h"
+#include "SecureSession.h"
+
+/// @brief CryptoBackend over the device's SecureSession (mbedTLS / PSA or ATECC608B).
+class SessionCryptoBackend : public CryptoBackend {
+public:
+    explicit SessionCryptoBackend(SecureSession* session) : session_(session) {}
+
+    bool pair(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) override;
+    bool resume(const char* base64pubKey, const uint8_t* ticketId, size_t ticketIdLen) override;
+    bool reconnect(const uint8_t* peerKey, size_t peerKeyLen, const char* base64pubKey) override;
+    bool issueTicket(const char* base64pubKey) override;
+    void sessionSalt(uint8_t out[SALT_SIZE]) override;
+    void persist() override;
+
+private:
+    SecureSession* session_;
+};
@@ -7,28 +7,28 @@ static const char* TAG = "SLOTMGR";
 
 constexpr uint8_t SlotManager::ATECC_SLOTS[SlotManager::CAPACITY];
 
-SlotManager::SlotManager() : counter_(0), pending_idx_(-1) {
+SlotManager::SlotManager() : counter_(0), pending_idx_(-1), dirty_(false) {
     memset(entries_, 0, sizeof(entries_));
 }
 
 // Load slot mapping and LRU counter from NVS
 void SlotManager::load() {
-    Preferences prefs;
-    prefs.begin("slotmgr", true);
-    counter_ = prefs.getUInt("counter", 0);
-    size_t n = prefs.getBytesLength("entries");
+    prefs_.begin("slotmgr", false);
+    counter_ = prefs_.getUInt("counter", 0);
+    size_t n = prefs_.getBytesLength("entries");
     if (n == sizeof(entries_)) {
-        prefs.getBytes("entries", entries_, sizeof(entries_));
+        prefs_.getBytes("entries", entries_, sizeof(entries_));
     } 
-    prefs.end();
 }
 
 void SlotManager::save() {
-    Preferences prefs;
-    prefs.begin("slotmgr", false);
-    prefs.putUInt("counter", counter_);
-    prefs.putBytes("entries", entries_, sizeof(entries_));
-    prefs.end();
+    prefs_.putUInt("counter", counter_);
+    prefs_.putBytes("entries", entries_, sizeof(entries_));
+    dirty_ = false;
+}
+
+void SlotManager::flush() {
+    if (dirty_) save();
 }
 
 // Returns ATECC slot index for label, -1 if not found.
@@ -77,7 +77,7 @@ uint8_t SlotManager::lookup(const char* label) {
     int i = find_label(label);
     if (i < 0) return INVALID_SLOT;
     entries_[i].seq = ++counter_;
-    save();
+    dirty_ = true;
     return entries_[i].slot;
 }
 
@@ -120,6 +120,19 @@ uint8_t SlotManager::reserve() {
     return ATECC_SLOTS[i];
 }
 
+// Reserve a free slot without evicting anyone, so a key can be generated ahead of pairing.
+// Returns INVALID_SLOT when every slot is in use or a reservation is already pending.
+uint8_t SlotManager::reserveFree() {
+    if (pending_idx_ >= 0) return INVALID_SLOT;
+
+    int i = find_free();
+    if (i < 0) return INVALID_SLOT;
+
+    pending_idx_ = i;
+    ESP_LOGD(TAG, "Reserved free ATECC slot %u", ATECC_SLOTS[i]);
+    return ATECC_SLOTS[i];
+}
+
 // Finalize a pending reservation with the now-known label. Persists to NVS.
 // Returns the reserved slot, or INVALID_SLOT if no reservation is pending.
 uint8_t SlotManager::commit(const char* label, char* evicted_label_out) {
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <Preferences.h>
 
 /// @brief LRU manager for mapping transmitter labels to ATECC608B key storage slots. 
 /// @details Stores data in NVS and manages eviction of old entries when capacity is exceeded.
@@ -13,12 +14,19 @@ public:
     static constexpr uint8_t ATECC_SLOTS[CAPACITY] = { 0, 1, 2, 3, 4, 5, 6, 7 };
 
     SlotManager();
+
+    // Open the "slotmgr" namespace and load the mapping. The namespace stays open so
+    // flushing a reconnect's LRU bump does not reopen NVS.
     void load();
     void save();
 
-    // Returns ATECC slot for label, INVALID_SLOT if not found. Bumps LRU on hit.
+    // Returns ATECC slot for label, INVALID_SLOT if not found. Bumps LRU on hit, in RAM only
+    // so the handshake path writes no NVS; flush() persists it.
     uint8_t lookup(const char* label);
 
+    // Save if lookup() changed the LRU order since the last save
+    void flush();
+
     // Returns ATECC slot for label, allocating a free slot or evicting LRU.
     // out_is_new: set to true if a new slot was allocated (caller must call atcab_genkey)
     // evicted_label_out: if non-null, filled with the evicted label (LABEL_LEN+1 bytes) or '\0' if no eviction
@@ -29,6 +37,10 @@ public:
     // Only one reservation can be active at a time; calling reserve() again returns the same slot.
     uint8_t reserve();
 
+    // Reserve a free slot without evicting anyone, so a key can be generated ahead of pairing.
+    // Returns INVALID_SLOT when every slot is in use or a reservation is already pending.
+    uint8_t reserveFree();
+
     // Finalize a pending reservation with the now-known label. Persists to NVS.
     // Returns the reserved slot, or INVALID_SLOT if no reservation is pending.
     uint8_t commit(const char* label, char* evicted_label_out = nullptr);
@@ -45,9 +57,11 @@ private:
         uint32_t seq;
     };
 
+    Preferences prefs_;
     Entry entries_[CAPACITY];
     uint32_t counter_;
     int pending_idx_;  // index chosen by reserve(), or -1
+    bool dirty_;       // LRU order changed in RAM since the last save
 
     int find_label(const char* label) const;
     int find_free() const;
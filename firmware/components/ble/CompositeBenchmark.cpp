@@ -0,0 +1,187 @@
+#include "CompositeBenchmark.h"
+#include "PacketView.h"
+#include "SessionCipher.h"
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <esp_cpu.h>
+#include <psa/crypto.h>
+#include <string.h>
+
+#include "pb_encode.h"
+
+static const char* TAG = "COMPOSITE_BENCH";
+
+static constexpr int      ITERATIONS = 200;
+static constexpr unsigned BATCH_SIZES[] = { 1, 2, 4, 8, 16 };   // 16 framed commands fill 195 of the 200 B encryptedData
+static constexpr size_t   PLAIN_MAX = sizeof(toothpaste_DataPacket_encryptedData_t::bytes);
+static constexpr size_t   WIRE_MAX = 256;
+
+// One keycode command: press and release a two-key shortcut
+static size_t encodeCommand(uint8_t* buf, size_t cap)
+{
+    toothpaste_EncryptedData data = toothpaste_EncryptedData_init_zero;
+    data.packetType = toothpaste_EncryptedData_PacketType_KEYBOARD_KEYCODE;
+    data.which_packetData = toothpaste_EncryptedData_keycodePacket_tag;
+    data.packetData.keycodePacket.code.size = 2;
+    data.packetData.keycodePacket.code.bytes[0] = 0xe0;   // Left Ctrl
+    data.packetData.keycodePacket.code.bytes[1] = 0x06;   // C
+    data.packetData.keycodePacket.length = 2;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, cap);
+    return pb_encode(&stream, toothpaste_EncryptedData_fields, &data) ? stream.bytes_written : 0;
+}
+
+// An EncryptedData holding a CompositePacket of n copies of command. commands is a callback
+// field, so the batch is framed by hand the way the client serializes it.
+static size_t encodeComposite(const uint8_t* command, size_t commandLen, unsigned n, uint8_t* buf, size_t cap)
+{
+    uint8_t body[PLAIN_MAX];
+    pb_ostream_t inner = pb_ostream_from_buffer(body, sizeof(body));
+    for (unsigned i = 0; i < n; i++) {
+        if (!pb_encode_tag(&inner, PB_WT_STRING, toothpaste_CompositePacket_commands_tag) ||
+            !pb_encode_string(&inner, command, commandLen)) {
+            return 0;
+        }
+    }
+
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, cap);
+    if (!pb_encode_tag(&stream, PB_WT_STRING, toothpaste_EncryptedData_compositePacket_tag) ||
+        !pb_encode_string(&stream, body, inner.bytes_written)) {
+        return 0;
+    }
+    return stream.bytes_written;
+}
+
+// Encrypt plaintext into a serialized DataPacket, as the client sends it
+static size_t sealDataPacket(SessionCipher& cipher, const uint8_t* plain, size_t plainLen, uint8_t* wire, size_t cap)
+{
+    toothpaste_DataPacket packet = toothpaste_DataPacket_init_zero;
+    packet.packetID = toothpaste_DataPacket_PacketID_DATA_PACKET;
+    packet.packetNumber = 1;
+    packet.totalPackets = 1;
+    packet.dataLen = (uint32_t)plainLen;
+    packet.iv.size = SessionCipher::IV_SIZE;
+    packet.tag.size = SessionCipher::TAG_SIZE;
+    packet.encryptedData.size = (pb_size_t)plainLen;
+    if (psa_generate_random(packet.iv.bytes, SessionCipher::IV_SIZE) != PSA_SUCCESS ||
+        cipher.encrypt(packet.iv.bytes, plain, plainLen, packet.encryptedData.bytes, packet.tag.bytes) != 0) {
+        return 0;
+    }
+
+    pb_ostream_t stream = pb_ostream_from_buffer(wire, cap);
+    return pb_encode(&stream, toothpaste_DataPacket_fields, &packet) ? stream.bytes_written : 0;
+}
+
+// Locate every keycode report in a decrypted EncryptedData the way dispatchEncryptedData()
+// does, one CompositePacket level deep. Returns the commands found.
+static unsigned walkCommands(uint8_t* msg, size_t msgLen, bool inComposite)
+{
+    unsigned found = 0;
+    PbReader reader(msg, msgLen);
+    PbField field;
+    while (reader.next(&field)) {
+        if (field.wireType != PB_WT_STRING) continue;
+        if (field.tag == toothpaste_EncryptedData_keycodePacket_tag) {
+            uint8_t* code;
+            size_t codeLen;
+            uint32_t length;
+            findStringField(field.data, field.len, toothpaste_KeycodePacket_code_tag,
+                            toothpaste_KeycodePacket_length_tag, &code, &codeLen, &length);
+            if (code != nullptr) found++;
+        }
+        else if (field.tag == toothpaste_EncryptedData_compositePacket_tag && !inComposite) {
+            PbReader batch(field.data, field.len);
+            PbField command;
+            while (batch.next(&command)) {
+                if (command.tag == toothpaste_CompositePacket_commands_tag && command.wireType == PB_WT_STRING) {
+                    found += walkCommands(command.data, command.len, true);
+                }
+            }
+        }
+    }
+    return found;
+}
+
+// Copy a write into the slot (PacketRing does the same), index it, decrypt and walk it
+static unsigned ingest(SessionCipher& cipher, const uint8_t* wire, size_t len, uint8_t* slot)
+{
+    memcpy(slot, wire, len);
+    DataPacketView view;
+    if (!decodeDataPacketView(slot, len, &view) || view.encryptedData == nullptr) return 0;
+    if (cipher.decryptInPlace(view.iv, view.encryptedData, view.encryptedLen, view.tag) != 0) return 0;
+    size_t plainLen = view.dataLen < view.encryptedLen ? view.dataLen : view.encryptedLen;
+    return walkCommands(view.encryptedData, plainLen, false);
+}
+
+// Per-command average with 0.1us resolution alongside CPU cycles
+static void logResult(const char* label, unsigned n, unsigned writes, int64_t totalUs, uint32_t totalCycles)
+{
+    uint32_t commands = (uint32_t)n * ITERATIONS;
+    int64_t tenths = (totalUs * 10) / commands;
+    ESP_LOGI(TAG, "%-9s %2u cmds in %2u write(s): %lld.%lld us/cmd  %lu cycles/cmd", label, n, writes,
+             tenths / 10, tenths % 10, (unsigned long)(totalCycles / commands));
+}
+
+void runCompositeBenchmark()
+{
+    uint8_t key[SessionCipher::KEY_SIZE];
+    if (psa_generate_random(key, sizeof(key)) != PSA_SUCCESS) {
+        ESP_LOGE(TAG, "RNG unavailable, call after SecureSession::init()");
+        return;
+    }
+
+    SessionCipher cipher;
+    if (cipher.begin(key) != 0) {
+        ESP_LOGE(TAG, "Cipher setup failed");
+        memset(key, 0, sizeof(key));
+        return;
+    }
+
+    uint8_t command[32];
+    uint8_t plain[PLAIN_MAX];
+    uint8_t single[WIRE_MAX];
+    uint8_t composite[WIRE_MAX];
+    uint8_t slot[WIRE_MAX];
+
+    size_t commandLen = encodeCommand(command, sizeof(command));
+    size_t singleLen = commandLen > 0 ? sealDataPacket(cipher, command, commandLen, single, sizeof(single)) : 0;
+    if (singleLen == 0) {
+        ESP_LOGE(TAG, "Packet encode failed");
+        cipher.end();
+        memset(key, 0, sizeof(key));
+        return;
+    }
+
+    ESP_LOGI(TAG, "Ingest per keycode command, %d iterations, composite vs single-command writes", ITERATIONS);
+
+    for (unsigned n : BATCH_SIZES) {
+        size_t plainLen = encodeComposite(command, commandLen, n, plain, sizeof(plain));
+        size_t compositeLen = plainLen > 0 ? sealDataPacket(cipher, plain, plainLen, composite, sizeof(composite)) : 0;
+        if (compositeLen == 0) {
+            ESP_LOGE(TAG, "Composite of %u does not fit one DataPacket", n);
+            break;
+        }
+
+        unsigned found = 0;
+        int64_t t0 = esp_timer_get_time();
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        for (int i = 0; i < ITERATIONS; i++) {
+            for (unsigned k = 0; k < n; k++) found += ingest(cipher, single, singleLen, slot);
+        }
+        logResult("single", n, n, esp_timer_get_time() - t0, esp_cpu_get_cycle_count() - c0);
+        if (found != n * ITERATIONS) ESP_LOGE(TAG, "single: %u of %u commands walked", found, n * ITERATIONS);
+
+        found = 0;
+        t0 = esp_timer_get_time();
+        c0 = esp_cpu_get_cycle_count();
+        for (int i = 0; i < ITERATIONS; i++) {
+            found += ingest(cipher, composite, compositeLen, slot);
+        }
+        logResult("composite", n, 1, esp_timer_get_time() - t0, esp_cpu_get_cycle_count() - c0);
+        if (found != n * ITERATIONS) ESP_LOGE(TAG, "composite: %u of %u commands walked", found, n * ITERATIONS);
+    }
+
+    cipher.end();
+    memset(key, 0, sizeof(key));
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// On-device CompositePacket benchmark (enabled with CONFIG_TOOTHPASTE_CRYPTO_BENCHMARK).
+// Times the packet task's ingest path (decodeDataPacketView(), in-place decrypt, payload
+// walk) for one CompositePacket of N keycode commands against N single-command
+// DataPackets, and logs us and CPU cycles per command. HID dispatch costs the same per
+// command either way and is left out, as are the BLE writes (1 against N). Uses a
+// throwaway random key; never touches the live session.
+void runCompositeBenchmark();
@@ -0,0 +1,60 @@
+#include "ConnGovernor.h"
+
+// 7.5 ms for live capture; 30-50 ms with 4 skipped events (~250 ms effective) when idle.
+// Both keep a 4 s supervision timeout, above the (1 + latency) * interval * 2 minimum.
+static const ConnGovernor::Params PROFILE_IDLE   = { 24, 40, 4, 400 };
+static const ConnGovernor::Params PROFILE_ACTIVE = {  6,  6, 0, 400 };
+
+ConnGovernor::ConnGovernor()
+{
+    reset(0);
+}
+
+void ConnGovernor::reset(int64_t nowUs)
+{
+    profile_ = NONE;
+    lastPacketUs_ = nowUs;
+    for (size_t i = 0; i < BURST_PACKETS; i++) burst_[i] = INT64_MIN;
+    burstHead_ = 0;
+}
+
+bool ConnGovernor::onPacket(int64_t nowUs)
+{
+    lastPacketUs_ = nowUs;
+
+    // burst_[burstHead_] is the oldest of the last BURST_PACKETS arrivals
+    burst_[burstHead_] = nowUs;
+    burstHead_ = (burstHead_ + 1) % BURST_PACKETS;
+    int64_t oldest = burst_[burstHead_];
+
+    bool burst = oldest != INT64_MIN && nowUs - oldest <= BURST_WINDOW_US;
+    if (burst && profile_ != ACTIVE) {
+        profile_ = ACTIVE;
+        return true;
+    }
+    return false;
+}
+
+bool ConnGovernor::onTick(int64_t nowUs)
+{
+    if (profile_ != IDLE && nowUs - lastPacketUs_ >= QUIET_US) {
+        profile_ = IDLE;
+        return true;
+    }
+    return false;
+}
+
+const ConnGovernor::Params& ConnGovernor::params(Profile profile)
+{
+    return (profile == ACTIVE) ? PROFILE_ACTIVE : PROFILE_IDLE;
+}
+
+const char* ConnGovernor::name(Profile profile)
+{
+    switch (profile) {
+        case NONE:   return "none";
+        case IDLE:   return "idle";
+        case ACTIVE: return "active";
+    }
+    return "?";
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief Picks a BLE connection-parameter profile from the packet traffic packetTask sees.
+/// @details A burst (BURST_PACKETS writes within BURST_WINDOW_US) switches to the low-latency
+/// profile; QUIET_US without traffic relaxes back to the idle profile with slave latency.
+/// Pure logic with the clock passed in, so a recorded or simulated trace of packet
+/// timestamps can be replayed on the host to tune the thresholds.
+class ConnGovernor {
+public:
+    enum Profile : uint8_t {
+        NONE,       // Nothing requested yet on this connection; the central's choice stands
+        IDLE,
+        ACTIVE
+    };
+
+    // Connection parameters in BLE units (interval 1.25 ms, timeout 10 ms)
+    struct Params {
+        uint16_t intervalMin;
+        uint16_t intervalMax;
+        uint16_t latency;
+        uint16_t timeout;
+    };
+
+    static constexpr int     BURST_PACKETS   = 3;
+    static constexpr int64_t BURST_WINDOW_US = 300000;
+    static constexpr int64_t QUIET_US        = 3000000;
+
+    ConnGovernor();
+
+    // New connection: forget the traffic history
+    void reset(int64_t nowUs);
+
+    // Feed a packet arrival / an idle tick. Both return true when the profile changed and
+    // the new one should be requested from the central.
+    bool onPacket(int64_t nowUs);
+    bool onTick(int64_t nowUs);
+
+    Profile profile() const { return profile_; }
+
+    static const Params& params(Profile profile);
+    static const char* name(Profile profile);
+
+private:
+    Profile profile_;
+    int64_t lastPacketUs_;
+    int64_t burst_[BURST_PACKETS];  // Arrival times of the last BURST_PACKETS packets
+    size_t  burstHead_;
+};
@@ -0,0 +1,119 @@
+#include "CryptoWorker.h"
+#include <string.h>
+#include "esp_log.h"
+#include "PipelineStats.h"
+
+static const char* TAG = "CRYPTO";
+
+#define CRYPTO_TASK_STACK 6144   // PSA ECDH runs on this stack
+
+CryptoWorker::CryptoWorker()
+    : backend_(nullptr), wake_(nullptr), requests_(nullptr), results_(nullptr), task_(nullptr), inFlight_(0),
+      link_(0), inFlightLink_(0)
+{
+}
+
+bool CryptoWorker::begin(CryptoBackend* backend, void (*wake)(), UBaseType_t priority, BaseType_t core)
+{
+    if (task_ != nullptr) return true;
+
+    backend_ = backend;
+    wake_ = wake;
+    requests_ = xQueueCreate(QUEUE_DEPTH, sizeof(Request));
+    results_ = xQueueCreate(QUEUE_DEPTH, sizeof(Result));
+    if (requests_ == nullptr || results_ == nullptr) {
+        ESP_LOGE(TAG, "Failed to create crypto queues");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(task, "CryptoWorker", CRYPTO_TASK_STACK, this, priority, &task_, core) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create crypto worker");
+        task_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// Only the packet task submits and polls, so nothing else can fill the queue in between
+void CryptoWorker::submit(Request& request)
+{
+    if (task_ == nullptr) {
+        ESP_LOGE(TAG, "Crypto worker not running, handshake dropped");
+        return;
+    }
+
+    request.queuedUs = pipelineNowUs();
+    request.link = link_.load();
+    inFlightLink_ = request.link;
+    inFlight_++;
+    xQueueSend(requests_, &request, 0);
+}
+
+bool CryptoWorker::poll(Result* result, TickType_t wait)
+{
+    if (results_ == nullptr || xQueueReceive(results_, result, wait) != pdTRUE) return false;
+    inFlight_--;
+    return true;
+}
+
+void CryptoWorker::task(void* arg)
+{
+    CryptoWorker* worker = static_cast<CryptoWorker*>(arg);
+    Request request;
+    while (true) {
+        if (xQueueReceive(worker->requests_, &request, portMAX_DELAY) == pdTRUE) {
+            worker->run(request);
+        }
+    }
+}
+
+void CryptoWorker::run(const Request& request)
+{
+    Result result = {};
+    result.kind = request.kind;
+    result.link = request.link;
+    memcpy(result.base64pubKey, request.base64pubKey, sizeof(result.base64pubKey));
+
+    uint32_t start = pipelineNowUs();
+    result.waitUs = start - request.queuedUs;
+    pipelineRecord(STAGE_CRYPTO_WAIT, result.waitUs);
+
+    if (request.link != link_.load()) {
+        // The link closed while the request was queued: nobody is waiting for its answer
+        result.ok = false;
+    }
+    else if (request.kind == PAIR) {
+        result.ok = backend_->pair(request.peerKey, request.peerKeyLen, request.base64pubKey);
+    }
+    else {
+        if (request.ticketIdLen > 0) {
+            result.resumed = backend_->resume(request.base64pubKey, request.ticketId, request.ticketIdLen);
+        }
+        result.ok = result.resumed || backend_->reconnect(request.peerKey, request.peerKeyLen, request.base64pubKey);
+    }
+    if (result.ok) {
+        backend_->sessionSalt(result.salt);
+    }
+
+    result.runUs = pipelineNowUs() - start;
+    pipelineRecord(STAGE_CRYPTO_OUT, result.runUs);
+
+    // Never blocks: packetTask polled the last completion before submitting this request
+    xQueueSend(results_, &result, portMAX_DELAY);
+    if (wake_ != nullptr) wake_();
+
+    // A client that went away never saw CHALLENGE, so it holds no ticket for this session
+    if (request.link != link_.load()) return;
+
+    // After the completion, so CHALLENGE goes out without waiting on flash. Resumed sessions
+    // get one too: each ticket keys a single session.
+    if (result.ok && request.resume) {
+        uint32_t t0 = pipelineNowUs();
+        if (backend_->issueTicket(request.base64pubKey)) {
+            ESP_LOGD(TAG, "Resumption ticket issued in %lu us", (unsigned long)(pipelineNowUs() - t0));
+        }
+    }
+    if (result.ok) {
+        backend_->persist();
+    }
+}
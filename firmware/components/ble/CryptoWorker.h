@@ -0,0 +1,96 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "CryptoBackend.h"
+
+/// @brief Runs AUTH handshakes on their own task so packetTask keeps draining the ingest ring.
+/// @details packetTask submits one request per AUTH packet and collects completions between
+/// packets; the worker calls `wake` after posting one so packetTask does not sit out its
+/// ring timeout. One handshake is in flight at a time: packetTask submits only once the last
+/// completion has been polled. Every request carries the link generation it arrived on, which
+/// newLink() bumps on connect and disconnect; a completion from an earlier link is stale and
+/// must not be answered. Every successful handshake that asked for resumption, resumed or not,
+/// issues the next ticket after the completion is posted, so CHALLENGE never waits on the NVS
+/// write; the backend persists the rest of its bookkeeping then too. Stale handshakes do
+/// neither. Queue wait and backend time are recorded as the crypto.q / crypto.out pipeline
+/// stages.
+class CryptoWorker {
+public:
+    static constexpr size_t QUEUE_DEPTH = 1;
+    static constexpr size_t PEER_KEY_MAX = 65;      // Uncompressed P-256 point
+    static constexpr size_t PEER_B64_MAX = 70;      // Base64 peer key plus terminator
+    static constexpr size_t TICKET_ID_MAX = 8;
+
+    enum Kind : uint8_t {
+        PAIR,       // Pairing-mode AUTH: enroll a new peer
+        RECONNECT   // AUTH from an enrolled peer: ticket or ECDH
+    };
+
+    struct Request {
+        Kind     kind;
+        bool     resume;                        // Client asked for a resumption ticket
+        uint8_t  peerKey[PEER_KEY_MAX];
+        size_t   peerKeyLen;
+        char     base64pubKey[PEER_B64_MAX];
+        uint8_t  ticketId[TICKET_ID_MAX];       // Ticket the client holds (RECONNECT)
+        size_t   ticketIdLen;
+        uint32_t queuedUs;                      // Set by submit()
+        uint32_t link;                          // Link generation, set by submit()
+    };
+
+    struct Result {
+        Kind     kind;
+        bool     ok;
+        bool     resumed;                       // Keyed from the ticket, not ECDH
+        char     base64pubKey[PEER_B64_MAX];
+        uint8_t  salt[CryptoBackend::SALT_SIZE];
+        uint32_t waitUs;                        // Time queued behind earlier handshakes
+        uint32_t runUs;                         // Backend time
+        uint32_t link;                          // Link generation the AUTH arrived on
+    };
+
+    CryptoWorker();
+
+    // Create the queues and the worker task. `wake` runs on the worker after each completion.
+    bool begin(CryptoBackend* backend, void (*wake)(), UBaseType_t priority, BaseType_t core);
+
+    // Queue a handshake on the current link; the caller checks busy() first, so the queue has room
+    void submit(Request& request);
+
+    // Take the completion, waiting up to `wait` ticks for it
+    bool poll(Result* result, TickType_t wait = 0);
+
+    // A handshake was submitted and its completion has not been polled yet
+    bool busy() const { return inFlight_.load() > 0; }
+
+    // The handshake in flight was submitted on a link that has since gone away
+    bool busyWithOldLink() const { return busy() && inFlightLink_.load() != link_.load(); }
+
+    // Start a new link generation: call on connect and disconnect
+    void newLink() { link_++; }
+
+    // The completion belongs to a link that has gone away; its session key must be wiped
+    bool stale(const Result& result) const { return result.link != link_.load(); }
+
+    // The worker task, nullptr before begin()
+    TaskHandle_t taskHandle() const { return task_; }
+
+private:
+    static void task(void* arg);
+    void run(const Request& request);
+
+    CryptoBackend*    backend_;
+    void              (*wake_)();
+    QueueHandle_t     requests_;
+    QueueHandle_t     results_;
+    TaskHandle_t      task_;
+    std::atomic<int>  inFlight_;
+    std::atomic<uint32_t> link_;            // Current link generation
+    std::atomic<uint32_t> inFlightLink_;    // Generation of the handshake in flight
+};
@@ -0,0 +1,130 @@
+#include "PacketRing.h"
+#include <string.h>
+
+PacketRing::PacketRing(size_t capacity)
+    : buf_(new uint8_t[capacity]), size_(capacity & ~size_t(3)),
+      head_(0), tail_(0), highWater_(0),
+      pendingOffset_(0), pendingWrapAt_(0), pendingLen_(0), readLen_(0)
+{
+    pendingWrapAt_ = size_;
+    dataReady_ = xSemaphoreCreateBinary();
+}
+
+PacketRing::~PacketRing()
+{
+    vSemaphoreDelete(dataReady_);
+    delete[] buf_;
+}
+
+// Bytes currently held by committed (and not yet released) slots, including padding
+size_t PacketRing::used() const
+{
+    size_t h = head_.load(std::memory_order_acquire);
+    size_t t = tail_.load(std::memory_order_acquire);
+    return (h >= t) ? (h - t) : (size_ - t + h);
+}
+
+// Worst case: one word stays free to tell full from empty, and up to one slot can be lost
+// to padding when the next reservation wraps
+size_t PacketRing::fitCount(uint16_t len) const
+{
+    size_t slot = slotSize(len);
+    size_t free = freeBytes();
+    if (free < 2 * slot + sizeof(uint32_t)) return 0;
+    return (free - slot - sizeof(uint32_t)) / slot;
+}
+
+// Find room for a slot of len bytes. The write offset never catches up with the read
+// offset (head == tail means empty), so a slot must leave at least one word free.
+uint8_t* PacketRing::reserve(uint16_t len)
+{
+    if (len == WRAP_MARKER) return nullptr;
+
+    size_t need = slotSize(len);
+    size_t h = head_.load(std::memory_order_relaxed);
+    size_t t = tail_.load(std::memory_order_acquire);
+
+    pendingWrapAt_ = size_;
+
+    if (h >= t) {
+        size_t tailRoom = size_ - h;
+        if (tailRoom > need || (tailRoom == need && t != 0)) {
+            pendingOffset_ = h;
+        }
+        else if (t > need) {
+            pendingWrapAt_ = h;  // Doesn't fit before the end; pad and restart at 0
+            pendingOffset_ = 0;
+        }
+        else {
+            return nullptr;
+        }
+    }
+    else if (t - h > need) {
+        pendingOffset_ = h;
+    }
+    else {
+        return nullptr;
+    }
+
+    pendingLen_ = len;
+    return buf_ + pendingOffset_ + HEADER_SIZE;
+}
+
+// Publish the reserved slot to the consumer
+void PacketRing::commit()
+{
+    if (pendingWrapAt_ < size_) {
+        uint16_t marker = WRAP_MARKER;
+        memcpy(buf_ + pendingWrapAt_, &marker, HEADER_SIZE);
+    }
+    memcpy(buf_ + pendingOffset_, &pendingLen_, HEADER_SIZE);
+
+    size_t next = pendingOffset_ + slotSize(pendingLen_);
+    if (next == size_) next = 0;
+    head_.store(next, std::memory_order_release);
+
+    size_t inUse = used();
+    size_t peak = highWater_.load(std::memory_order_relaxed);
+    if (inUse > peak) highWater_.store(inUse, std::memory_order_relaxed);
+
+    xSemaphoreGive(dataReady_);
+}
+
+uint8_t* PacketRing::peek(uint16_t* len, TickType_t wait)
+{
+    while (true) {
+        size_t t = tail_.load(std::memory_order_relaxed);
+        size_t h = head_.load(std::memory_order_acquire);
+
+        if (h == t) {
+            if (xSemaphoreTake(dataReady_, wait) != pdTRUE) return nullptr;
+            wait = 0;  // Woken by commit() or wake(); still empty means a wake()
+            continue;
+        }
+
+        uint16_t slotLen;
+        memcpy(&slotLen, buf_ + t, HEADER_SIZE);
+        if (slotLen == WRAP_MARKER) {
+            tail_.store(0, std::memory_order_release);
+            continue;
+        }
+
+        readLen_ = slotLen;
+        *len = slotLen;
+        return buf_ + t + HEADER_SIZE;
+    }
+}
+
+// Wake the consumer from peek(); it returns nullptr if nothing was committed meanwhile
+void PacketRing::wake()
+{
+    xSemaphoreGive(dataReady_);
+}
+
+// Hand the slot returned by peek() back to the producer
+void PacketRing::release()
+{
+    size_t next = tail_.load(std::memory_order_relaxed) + slotSize(readLen_);
+    if (next == size_) next = 0;
+    tail_.store(next, std::memory_order_release);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/// @brief Single-producer / single-consumer byte ring with variable-length slots.
+/// @details The BLE write callback reserves a slot sized to the incoming write, copies the
+/// characteristic value straight into it and commits. packetTask peeks the oldest slot,
+/// processes it in place and releases it. Each slot costs its payload plus a 2-byte length
+/// header rounded up to 4 bytes, so small live-capture writes no longer pay for a full
+/// BLE_MAX_RAW_PACKET buffer.
+class PacketRing {
+public:
+    explicit PacketRing(size_t capacity);
+    ~PacketRing();
+
+    // Producer: get a writable slot for len bytes, or nullptr if the ring is full.
+    // At most one reservation may be outstanding; finish it with commit().
+    uint8_t* reserve(uint16_t len);
+    void commit();
+
+    // Consumer: block up to `wait` for the oldest slot. Returns nullptr on timeout, or early
+    // after wake(). The slot stays valid (and writable, for in-place decode) until release().
+    uint8_t* peek(uint16_t* len, TickType_t wait);
+    void release();
+
+    // Cut a blocked peek() short so the consumer can attend to something else
+    void wake();
+
+    size_t capacity() const { return size_; }
+    size_t used() const;
+    size_t freeBytes() const { return size_ - used(); }
+    size_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+
+    // Writes of up to len bytes guaranteed to fit right now, allowing one slot lost to wrap padding
+    size_t fitCount(uint16_t len) const;
+
+private:
+    static constexpr uint16_t HEADER_SIZE = sizeof(uint16_t);
+    static constexpr uint16_t WRAP_MARKER = 0xFFFF;  // Rest of the buffer is padding; next slot is at 0
+
+    static size_t slotSize(uint16_t len) { return (HEADER_SIZE + len + 3u) & ~3u; }
+
+    uint8_t* buf_;
+    size_t   size_;
+
+    std::atomic<size_t> head_;      // Next write offset (producer-owned)
+    std::atomic<size_t> tail_;      // Oldest unread slot (consumer-owned)
+    std::atomic<size_t> highWater_; // Peak bytes in use since boot
+
+    size_t   pendingOffset_;        // Slot handed out by reserve(), awaiting commit()
+    size_t   pendingWrapAt_;        // Offset of the wrap marker to write on commit, or size_ if none
+    uint16_t pendingLen_;
+    uint16_t readLen_;              // Length of the slot handed out by peek()
+
+    SemaphoreHandle_t dataReady_;
+};
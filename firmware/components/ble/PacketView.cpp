@@ -0,0 +1,134 @@
+#include "PacketView.h"
+#include <string.h>
+
+PbReader::PbReader(uint8_t* buf, size_t len)
+    : base_(buf), total_(len), stream_(pb_istream_from_buffer(buf, len)), error_(false) {}
+
+bool PbReader::next(PbField* field)
+{
+    if (error_ || stream_.bytes_left == 0) return false;
+
+    bool eof = false;
+    if (!pb_decode_tag(&stream_, &field->wireType, &field->tag, &eof)) {
+        error_ = !eof;
+        return false;
+    }
+
+    field->varint = 0;
+    field->data = nullptr;
+    field->len = 0;
+
+    switch (field->wireType) {
+        case PB_WT_VARINT:
+            error_ = !pb_decode_varint(&stream_, &field->varint);
+            break;
+
+        case PB_WT_STRING:
+        {
+            uint32_t n = 0;
+            if (!pb_decode_varint32(&stream_, &n) || n > stream_.bytes_left) {
+                error_ = true;
+                break;
+            }
+            // Point at the payload in place, then step the stream over it
+            field->data = base_ + (total_ - stream_.bytes_left);
+            field->len = n;
+            error_ = !pb_read(&stream_, nullptr, n);
+            break;
+        }
+
+        default:
+            error_ = !pb_skip_field(&stream_, field->wireType);
+            break;
+    }
+
+    return !error_;
+}
+
+bool decodeDataPacketView(uint8_t* buf, size_t len, DataPacketView* out)
+{
+    memset(out, 0, sizeof(*out));
+
+    PbReader reader(buf, len);
+    PbField field;
+    while (reader.next(&field)) {
+        switch (field.tag) {
+            case toothpaste_DataPacket_packetID_tag:     out->packetID = (toothpaste_DataPacket_PacketID)field.varint; break;
+            case toothpaste_DataPacket_packetNumber_tag: out->packetNumber = (uint32_t)field.varint; break;
+            case toothpaste_DataPacket_totalPackets_tag: out->totalPackets = (uint32_t)field.varint; break;
+            case toothpaste_DataPacket_slowMode_tag:     out->slowMode = field.varint != 0; break;
+            case toothpaste_DataPacket_dataLen_tag:      out->dataLen = (uint32_t)field.varint; break;
+            case toothpaste_DataPacket_typingProfile_tag: out->typingProfile = (toothpaste_TypingProfile)field.varint; break;
+            case toothpaste_DataPacket_bulk_tag:         out->bulk = field.varint != 0; break;
+            case toothpaste_DataPacket_resume_tag:       out->resume = field.varint != 0; break;
+            case toothpaste_DataPacket_iv_tag:
+                out->iv = field.data;
+                out->ivLen = field.len;
+                break;
+            case toothpaste_DataPacket_encryptedData_tag:
+                out->encryptedData = field.data;
+                out->encryptedLen = field.len;
+                break;
+            case toothpaste_DataPacket_tag_tag:
+                out->tag = field.data;
+                out->tagLen = field.len;
+                break;
+            case toothpaste_DataPacket_resumeTicket_tag:
+                out->resumeTicket = field.data;
+                out->resumeTicketLen = field.len;
+                break;
+            default:
+                break; // Unknown fields are skipped for forward compatibility
+        }
+    }
+
+    return reader.ok();
+}
+
+void findStringField(uint8_t* msg, size_t msgLen, uint32_t stringTag, uint32_t lengthTag,
+                     uint8_t** data, size_t* len, uint32_t* declaredLen)
+{
+    *data = nullptr;
+    *len = 0;
+    *declaredLen = 0;
+
+    PbReader reader(msg, msgLen);
+    PbField field;
+    while (reader.next(&field)) {
+        if (field.tag == stringTag && field.wireType == PB_WT_STRING) {
+            *data = field.data;
+            *len = field.len;
+        }
+        else if (field.tag == lengthTag && field.wireType == PB_WT_VARINT) {
+            *declaredLen = (uint32_t)field.varint;
+        }
+    }
+}
+
+uint32_t writeCredits(const uint8_t* buf, size_t len, bool* bulk)
+{
+    *bulk = false;
+    pb_istream_t stream = pb_istream_from_buffer(buf, len);
+    pb_wire_type_t wireType;
+    uint32_t tag;
+    bool eof;
+    uint64_t credits = 1;
+
+    while (pb_decode_tag(&stream, &wireType, &tag, &eof)) {
+        if (tag == toothpaste_DataPacket_credits_tag && wireType == PB_WT_VARINT) {
+            if (!pb_decode_varint(&stream, &credits)) return 1;
+        }
+        else if (tag == toothpaste_DataPacket_bulk_tag && wireType == PB_WT_VARINT) {
+            uint64_t value;
+            if (!pb_decode_varint(&stream, &value)) return 1;
+            *bulk = value != 0;
+        }
+        else if (!pb_skip_field(&stream, wireType)) {
+            return 1;
+        }
+    }
+
+    uint64_t maxCredits = len / 2;
+    if (credits > maxCredits) credits = maxCredits;
+    return credits > 0 ? (uint32_t)credits : 1;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pb_decode.h"
+#include "toothpacket.pb.h"
+
+// One protobuf field as seen by PbReader. Length-delimited fields are not copied:
+// data points into the buffer being read.
+struct PbField {
+    uint32_t       tag;
+    pb_wire_type_t wireType;
+    uint64_t       varint;  // PB_WT_VARINT value
+    uint8_t*       data;    // PB_WT_STRING payload (bytes, string or sub-message)
+    size_t         len;
+};
+
+/// @brief Forward-only protobuf field iterator over a mutable buffer.
+/// @details Used instead of pb_decode() into the static-size structs when a field only
+/// needs to be located (ciphertext, strings) rather than copied out.
+class PbReader {
+public:
+    PbReader(uint8_t* buf, size_t len);
+
+    // Returns the next field, or false at end of buffer / on malformed input (see ok())
+    bool next(PbField* field);
+    bool ok() const { return !error_; }
+    const char* error() const { return PB_GET_ERROR(&stream_); }
+
+private:
+    uint8_t*     base_;
+    size_t       total_;
+    pb_istream_t stream_;
+    bool         error_;
+};
+
+// DataPacket with its byte fields left in the receive buffer. encryptedData is writable
+// so it can be decrypted in place.
+struct DataPacketView {
+    toothpaste_DataPacket_PacketID packetID;
+    uint32_t       packetNumber;
+    uint32_t       totalPackets;
+    bool           slowMode;
+    toothpaste_TypingProfile typingProfile;
+    bool           bulk;
+    uint32_t       dataLen;
+
+    const uint8_t* iv;
+    size_t         ivLen;
+    uint8_t*       encryptedData;
+    size_t         encryptedLen;
+    const uint8_t* tag;
+    size_t         tagLen;
+
+    bool           resume;          // AUTH only
+    const uint8_t* resumeTicket;
+    size_t         resumeTicketLen;
+};
+
+// Index a serialized DataPacket without copying. Returns false on malformed input.
+bool decodeDataPacketView(uint8_t* buf, size_t len, DataPacketView* out);
+
+// Find a string / bytes field and its declared-length varint inside a serialized sub-message
+// without copying it out. *data is null when the field is absent.
+void findStringField(uint8_t* msg, size_t msgLen, uint32_t stringTag, uint32_t lengthTag,
+                     uint8_t** data, size_t* len, uint32_t* declaredLen);
+
+// Flow-control credits a raw write spent: its DataPacket credits field, at least 1 and at most
+// one per two bytes (the smallest CompositePacket command). Malformed writes cost 1.
+// *bulk receives the write's keyboard lane flag.
+uint32_t writeCredits(const uint8_t* buf, size_t len, bool* bulk);
@@ -0,0 +1,80 @@
+#include "TransferAssembler.h"
+#include "esp_log.h"
+
+static const char* TAG = "BLE_TASK";
+
+TransferAssembler::TransferAssembler()
+    : active_(false), total_(0), next_(0), bytes_(0), startUs_(0)
+{
+}
+
+TransferAssembler::Verdict TransferAssembler::check(uint32_t packetNumber, uint32_t totalPackets)
+{
+    if (totalPackets <= 1) return STANDALONE;
+
+    if (packetNumber == 0 || packetNumber > totalPackets) {
+        ESP_LOGW(TAG, "Transfer packet %lu/%lu out of range", (unsigned long)packetNumber, (unsigned long)totalPackets);
+        return GAP;
+    }
+
+    // Packet 1 always opens a new transfer; whatever was unfinished is abandoned
+    if (packetNumber == 1) {
+        abort("superseded");
+        return START;
+    }
+
+    // Without packet 1 we'd type the middle of something; wait for the next transfer
+    if (!active_) return GAP;
+
+    if (totalPackets != total_) {
+        abort("length changed");
+        return GAP;
+    }
+
+    if (packetNumber == next_) return CONTINUE;
+    if (packetNumber < next_) return DUPLICATE;
+
+    ESP_LOGW(TAG, "Transfer gap: expected %lu/%lu, got %lu", (unsigned long)next_,
+        (unsigned long)total_, (unsigned long)packetNumber);
+    abort("gap");
+    return GAP;
+}
+
+bool TransferAssembler::accept(uint32_t packetNumber, uint32_t totalPackets, size_t payloadBytes, int64_t nowUs)
+{
+    if (packetNumber == 1) {
+        active_ = true;
+        total_ = totalPackets;
+        bytes_ = 0;
+        startUs_ = nowUs;
+    }
+
+    next_ = packetNumber + 1;
+    bytes_ += payloadBytes;
+
+    if (packetNumber < total_) return false;
+
+    ESP_LOGI(TAG, "Transfer complete: %lu packets, %u B in %lld us", (unsigned long)total_,
+        (unsigned)bytes_, nowUs - startUs_);
+    active_ = false;
+    return true;
+}
+
+void TransferAssembler::abort(const char* reason)
+{
+    if (!active_) return;
+    ESP_LOGW(TAG, "Transfer aborted (%s) at %lu/%lu", reason, (unsigned long)(next_ - 1), (unsigned long)total_);
+    active_ = false;
+}
+
+const char* TransferAssembler::verdictName(Verdict v)
+{
+    switch (v) {
+        case STANDALONE: return "single";
+        case START:      return "start";
+        case CONTINUE:   return "cont";
+        case DUPLICATE:  return "dup";
+        case GAP:        return "gap";
+    }
+    return "?";
+}
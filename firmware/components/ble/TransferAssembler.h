@@ -0,0 +1,45 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief Tracks the in-progress multi-packet transfer (DataPacket packetNumber / totalPackets).
+/// @details The client numbers the packets of one logical transfer 1..totalPackets and sends
+/// them in order. Packets with totalPackets <= 1 are standalone and pass through without
+/// touching the transfer in progress, so live keystrokes can interleave with a paste.
+/// Packet 1 always starts a new transfer (there is no transfer ID), so an unfinished one
+/// never blocks the next. Later packets already executed are skipped as duplicates, and
+/// after a gap the rest of that transfer is dropped until the client starts a new one.
+/// There is no timeout: a transfer legitimately stalls while the client waits for credits.
+class TransferAssembler {
+public:
+    enum Verdict : uint8_t {
+        STANDALONE,   // Single-packet command, dispatch as-is
+        START,        // First packet of a new transfer
+        CONTINUE,     // Next packet of the active transfer
+        DUPLICATE,    // Already executed, skip
+        GAP           // Out of sequence, skip (transfer aborted)
+    };
+
+    TransferAssembler();
+
+    // Classify a packet before decrypting it. Aborts the active transfer on a gap.
+    Verdict check(uint32_t packetNumber, uint32_t totalPackets);
+
+    // Record a START / CONTINUE packet that decrypted and dispatched.
+    // Returns true when it completed the transfer.
+    bool accept(uint32_t packetNumber, uint32_t totalPackets, size_t payloadBytes, int64_t nowUs);
+
+    // Abandon the active transfer (disconnect, decrypt failure)
+    void abort(const char* reason);
+
+    bool active() const { return active_; }
+
+    static const char* verdictName(Verdict v);
+
+private:
+    bool     active_;
+    uint32_t total_;
+    uint32_t next_;     // packetNumber expected next
+    size_t   bytes_;
+    int64_t  startUs_;
+};
@@ -2,6 +2,8 @@
 #include "NeoPixelRMT.h"
 #include "StateManager.h"
 #include "esp_log.h"
+#include "SessionCryptoBackend.h"
+#include "MockCryptoBackend.h"
 
 // Global definitions — declared extern in ble.h for use by ble_auth.cpp and ble_dispatch.cpp
 BLEServer*         bluServer              = NULL;
@@ -9,7 +11,8 @@ BLECharacteristic* inputCharacteristic    = NULL;
 BLECharacteristic* responseCharacteristic = NULL;
 BLECharacteristic* macCharacteristic      = NULL;
 
-QueueHandle_t packetQueue  = xQueueCreate(20, sizeof(RawPacket));
+PacketRing    packetRing(BLE_PACKET_RING_SIZE);
+CryptoWorker  cryptoWorker;
 bool          manualDisconnect = false;
 
 char   clientPubKey[70];
@@ -21,14 +24,34 @@ static void createPacketTask(SecureSession* sec) {
   xTaskCreatePinnedToCore(
     packetTask,
     "PacketWorker",
-    8192,
+    6144,
     sec, // persistent task shares 1 ECDH session
-    1,
+    PACKET_TASK_PRIORITY,
     nullptr,
-    1
+    PACKET_TASK_CORE
   );
 }
 
+// A finished handshake wakes PacketWorker out of its ring wait to send the response
+static void wakePacketTask() {
+  packetRing.wake();
+}
+
+static void startCryptoWorker(SecureSession* sec) {
+#ifdef CONFIG_TOOTHPASTE_CRYPTO_MOCK
+  static MockCryptoBackend backend(CONFIG_TOOTHPASTE_CRYPTO_MOCK_ECDH_MS * 1000, CONFIG_TOOTHPASTE_CRYPTO_MOCK_HKDF_MS * 1000);
+  ESP_LOGW(TAG, "Handshakes use the mock crypto backend; clients cannot connect");
+#else
+  static SessionCryptoBackend backend(sec);
+#endif
+  if (cryptoWorker.begin(&backend, wakePacketTask, CRYPTO_TASK_PRIORITY, CRYPTO_TASK_CORE)) {
+    SecureSession::bindHandshakeTask(cryptoWorker.taskHandle()); // Handshake crypto off the heap
+  }
+}
+
+// Callback constructor for BLE server events
+DeviceServerCallbacks::DeviceServerCallbacks(SecureSession* session) : session(session) {}
+
 // Handle Connect
 void DeviceServerCallbacks::onConnect(BLEServer* bluServer)
 {
@@ -36,6 +59,9 @@ void DeviceServerCallbacks::onConnect(BLEServer* bluServer)
 
   if (connectedCount == 0) {
     esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_CONN_HDL0, ESP_PWR_LVL_P9); // max power once connected
+    flowReset(); // Client counts credits from its first write on this link
+    cryptoWorker.newLink(); // A handshake the last client left running is not answered here
+    linkNegotiate(bluServer->getConnId());
     stateManager->setState(UNPAIRED);
   }
   // TODO: improve multi-client rejection strategy
@@ -50,6 +76,10 @@ void DeviceServerCallbacks::onDisconnect(BLEServer* bluServer)
 {
   // getConnectedCount() hasn't decremented yet when this fires, so still shows 1 at true disconnect
   if (bluServer->getConnectedCount() <= 1) {
+    cryptoWorker.newLink(); // Before endSession(): a handshake still running is now stale
+    session->endSession(); // Drop the session key; the next client must re-authenticate
+    linkClear();
+
     if (manualDisconnect) {
       manualDisconnect = false;
       stateManager->setState(NOT_CONNECTED);
@@ -63,7 +93,7 @@ void DeviceServerCallbacks::onDisconnect(BLEServer* bluServer)
 // Callback constructor for BLE Input Characteristic events
 InputCharacteristicCallbacks::InputCharacteristicCallbacks(SecureSession* session) : session(session) {}
 
-// Receive an incoming BLE write, validate length, and push raw bytes onto the packet queue
+// Receive an incoming BLE write, validate length, and copy it straight into the ingest ring
 void InputCharacteristicCallbacks::onWrite(BLECharacteristic* inputCharacteristic)
 {
   int64_t t0 = esp_timer_get_time();
@@ -72,40 +102,54 @@ void InputCharacteristicCallbacks::onWrite(BLECharacteristic* inputCharacteristi
 
   if (bleLen == 0 || session == nullptr) return;
 
+  // Every write spends the client's credits for it, even if dropped below. packetTask charges
+  // the same bytes when it processes the slot, so both sides agree on the count.
+  uint16_t len = (bleLen < BLE_MAX_RAW_PACKET) ? (uint16_t)bleLen : (uint16_t)BLE_MAX_RAW_PACKET;
+  bool bulk;
+  uint32_t credits = writeCredits(bleData, len, &bulk);
+  flowOnWrite(credits, bulk);
+
   if (bleLen < SecureSession::IV_SIZE + SecureSession::TAG_SIZE + SecureSession::HEADER_SIZE) {
     ESP_LOGW(TAG, "Characteristic too short! Received length: %d", bleLen);
+    flowOnDropped(credits, bulk);
     stateManager->setState(DROP);
     return;
   }
 
   ESP_LOGD(TAG, "Received %d bytes on input characteristic", bleLen);
 
-  RawPacket pkt;
-  pkt.len = (bleLen < BLE_MAX_RAW_PACKET) ? (uint16_t)bleLen : (uint16_t)BLE_MAX_RAW_PACKET;
-  memcpy(pkt.data, bleData, pkt.len);
-
-  ESP_LOGD(TAG, "Packet queuing took %lld us", esp_timer_get_time() - t0);
-
-  if (xQueueSend(packetQueue, &pkt, 0) != pdTRUE) {
+  uint8_t* slot = packetRing.reserve(len + INGEST_STAMP_SIZE);
+  if (slot == nullptr) {
     ESP_LOGW(TAG, "Packet queue full, dropping packet");
+    flowOnDropped(credits, bulk);
     stateManager->setState(DROP);
+    return;
   }
+
+  uint32_t stamp = pipelineNowUs();
+  memcpy(slot, &stamp, INGEST_STAMP_SIZE);
+  memcpy(slot + INGEST_STAMP_SIZE, bleData, len); // The only copy between the BLE stack and packetTask
+  packetRing.commit();
+
+  ESP_LOGD(TAG, "Packet queuing took %lld us", esp_timer_get_time() - t0);
 }
 
 // Initialise BLE server, characteristics, and advertising
 void bleSetup(SecureSession* session)
 {
+  startCryptoWorker(session);
   createPacketTask(session);
-  startKeyboardTask();
+  startHidTasks();
 
   String deviceName;
   session->getDeviceName(deviceName);
   ESP_LOGI(TAG, "Device name: %s", deviceName.c_str());
 
   BLEDevice::init(deviceName.length() > 0 ? deviceName.c_str() : BLE_DEVICE_DEFAULT_NAME);
+  BLEDevice::setMTU(BLE_PREFERRED_MTU);
 
   bluServer = BLEDevice::createServer();
-  bluServer->setCallbacks(new DeviceServerCallbacks());
+  bluServer->setCallbacks(new DeviceServerCallbacks(session));
 
   BLEService* pService = bluServer->createService(SERVICE_UUID);
 
@@ -7,6 +7,7 @@
 
 #include "esp_log.h"
 #include "espHID.h"
+#include "PipelineStats.h"
 #include "SecureSession.h"
 #include "toothpacket.pb.h"
 
@@ -17,40 +18,68 @@
 #define RESPONSE_CHARACTERISTIC     "6856e119-2c7b-455a-bf42-cf7ddd2c5908"
 #define MAC_CHARACTERISTIC_UUID     "19b10002-e8f2-537e-4f6c-d104768a1214"
 
-// Max serialized DataPacket: IV(14) + encryptedData(231) + authTag(22) + scalars(~11) ≈ 278 bytes
-#define BLE_MAX_RAW_PACKET 320
+#include "PacketRing.h"
+#include "PacketView.h"
+#include "TransferAssembler.h"
+#include "ConnGovernor.h"
+#include "CryptoWorker.h"
 
-struct RawPacket {
-    uint8_t  data[BLE_MAX_RAW_PACKET];
-    uint16_t len;
-};
+// Largest input write accepted: the ATT attribute value cap (needs an MTU of 515 or more)
+#define BLE_MAX_RAW_PACKET 512
+
+// Worst-case DataPacket bytes around encryptedData on a DATA write, from the nanopb bounds:
+// everything except the encryptedData payload and the AUTH-only resume(2) and resumeTicket(10).
+// That is header scalars(26) + IV(14) + dataLen(6) + encryptedData header(3) + authTag(18).
+// maxPayload = usable write size minus this.
+#define DATA_PACKET_AUTH_ONLY_SIZE (2 + 2 + sizeof(toothpaste_DataPacket_resumeTicket_t::bytes))
+#define DATA_PACKET_OVERHEAD (toothpaste_DataPacket_size - sizeof(toothpaste_DataPacket_encryptedData_t::bytes) \
+                              - DATA_PACKET_AUTH_ONLY_SIZE)
+static_assert(DATA_PACKET_OVERHEAD == 26 + 14 + 6 + 3 + 18, "DataPacket fields changed: update the overhead breakdown");
+
+// Link parameters requested on connect; the central may grant less
+#define BLE_PREFERRED_MTU   517
+#define BLE_DLE_TX_OCTETS   251   // LE Data Length Extension maximum
+#define BLE_DLE_TX_TIME     2120  // us for 251 octets on the 1M PHY
+
+// Ingest ring size; same RAM as the old 20 x RawPacket queue, but slots are sized per write
+#define BLE_PACKET_RING_SIZE 6144
+
+// Each ring slot is prefixed with the esp_timer time (us, truncated) the write arrived,
+// so packetTask can report how long packets wait between the BLE callback and decode
+#define INGEST_STAMP_SIZE   sizeof(uint32_t)
+
+// Decode stage: PacketWorker runs beside the NimBLE host on core 0 so decryption and
+// protobuf work never compete with the HID output workers on the TinyUSB core
+#define PACKET_TASK_CORE        0
+#define PACKET_TASK_PRIORITY    3
+#define PIPELINE_REPORT_US      5000000
+
+// AUTH handshakes run on CryptoWorker beside PacketWorker, one priority below it so ingest
+// keeps being drained while ECDH or the ATECC is busy
+#define CRYPTO_TASK_CORE        0
+#define CRYPTO_TASK_PRIORITY    2
+#define CRYPTO_STALE_WAIT_MS    2000  // An AUTH waits this long for the last link's handshake to end
+
+// Flow control: re-advertise once this many new credits are available, and re-check
+// credits this often while the ring is idle so HID queue drain is reported
+#define BLE_CREDIT_BATCH    4
+#define BLE_INTERACTIVE_RESERVE 2   // Ring slots bulk writes may not use (live input, CancelPacket)
+#define BLE_FLOW_POLL_MS    20
 
 // Shared globals — defined in ble.cpp, used across ble_auth.cpp and ble_dispatch.cpp
 extern BLECharacteristic* responseCharacteristic;
-extern QueueHandle_t      packetQueue;
+extern PacketRing         packetRing;
 extern char               clientPubKey[70];
 extern size_t             clientPubKeyLen;
-
-enum NotificationType : uint8_t {
-    KEEPALIVE,
-    RECV_READY,
-    RECV_NOT_READY
-};
-
-enum AuthStatus : uint8_t {
-    AUTH_FAILED,
-    AUTH_SUCCESS
-};
-
-struct NotificationPacket {
-    NotificationType packetType;
-    AuthStatus authStatus;
-};
+extern CryptoWorker       cryptoWorker;
 
 class DeviceServerCallbacks : public BLEServerCallbacks {
 public:
+    DeviceServerCallbacks(SecureSession* session);
     void onConnect(BLEServer* bluServer);
     void onDisconnect(BLEServer* bluServer);
+private:
+    SecureSession* session;
 };
 
 class InputCharacteristicCallbacks : public BLECharacteristicCallbacks {
@@ -63,9 +92,33 @@ private:
 
 void bleSetup(SecureSession* session);
 void packetTask(void* params);
-void generateSharedSecret(toothpaste_DataPacket* packet, SecureSession* session);
-void authenticateClient(toothpaste_DataPacket* packet, SecureSession* session);
-void decryptSendString(toothpaste_DataPacket* packet, SecureSession* session);
-void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, const uint8_t* challengeData, size_t challengeDataLen);
+void requestPairing(DataPacketView* packet);
+void requestReconnect(DataPacketView* packet);
+void finishHandshake(const CryptoWorker::Result& result);
+bool decryptSendString(DataPacketView* packet, SecureSession* session, size_t* copied);
+void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, const uint8_t* challengeData, size_t challengeDataLen,
+                          uint32_t creditLimit = 0, uint32_t bulkCreditLimit = 0, bool resumed = false);
+
+// Negotiated link parameters (ble_link.cpp)
+struct LinkInfo {
+    uint16_t attMtu;      // 23 until the MTU exchange completes
+    uint16_t maxWrite;    // Largest input write we can take on this link
+    uint16_t maxPayload;  // Largest DataPacket.encryptedData that fits in maxWrite
+    uint8_t  phy;         // BLE_HCI_LE_PHY_* of our TX side, 0 if unknown
+    uint16_t connInterval; // Current connection interval in 1.25 ms units, 0 if not connected
+    uint16_t connLatency;  // Connection events the peripheral may skip
+};
+void linkNegotiate(uint16_t connHandle);
+void linkClear();
+uint16_t linkHandle();
+void linkRequestProfile(ConnGovernor::Profile profile);
+LinkInfo linkInfo();
+
+// Credit-based flow control (ble_flow.cpp)
+void flowReset();
+void flowOnWrite(uint32_t credits, bool bulk);
+void flowOnDropped(uint32_t credits, bool bulk);
+void flowOnProcessed(uint32_t credits, bool bulk);
+void flowUpdate(SecureSession* session);
 
 #endif // BLE_H
@@ -3,88 +3,109 @@
 
 static const char* TAG = "BLE_AUTH";
 
-// Derive a new ECDH shared secret and session AES key from a pairing AUTH packet
-void generateSharedSecret(toothpaste_DataPacket* packet, SecureSession* session)
+// Decode the base64 peer public key carried in an AUTH packet into a crypto request
+static bool buildRequest(DataPacketView* packet, CryptoWorker::Kind kind, CryptoWorker::Request* request)
 {
-  uint8_t peerKeyArray[65];
-  size_t peerKeyLen = 0;
-
-  // Copy the base64 key bytes into a null-terminated char array
-  size_t base64InputLen = packet->dataLen;
-  char base64Input[70];
-  size_t copyLen = (base64InputLen < sizeof(base64Input) - 1) ? base64InputLen : sizeof(base64Input) - 1;
-  memcpy(base64Input, packet->encryptedData.bytes, copyLen);
-  base64Input[copyLen] = '\0';
-  
-  // Decode the base64 public key from the packet 
+  // Keep the base64 key as a null-terminated string; it labels the peer's slot
+  size_t base64InputLen = packet->encryptedLen;
+  if (kind == CryptoWorker::PAIR && packet->dataLen < base64InputLen) base64InputLen = packet->dataLen;
+  size_t copyLen = (base64InputLen < sizeof(request->base64pubKey) - 1) ? base64InputLen : sizeof(request->base64pubKey) - 1;
+  memcpy(request->base64pubKey, packet->encryptedData, copyLen);
+  request->base64pubKey[copyLen] = '\0';
+
+  // Decode the base64 public key from the packet
   int ret = mbedtls_base64_decode(
-    peerKeyArray,
-    sizeof(peerKeyArray),
-    &peerKeyLen,
-    packet->encryptedData.bytes,
+    request->peerKey,
+    sizeof(request->peerKey),
+    &request->peerKeyLen,
+    packet->encryptedData,
     base64InputLen);
 
   if (ret != 0) {
     ESP_LOGE(TAG, "Base64 decode failed, err %d", ret);
-    stateManager->setState(ERROR);
-    return;
+    return false;
   }
-  ESP_LOGD(TAG, "Base64 decoded, peer public key, length: %d", peerKeyLen);
+  ESP_LOGD(TAG, "Base64 decoded peer public key, length: %zu", request->peerKeyLen);
 
-  if (!session->computeSharedSecret(peerKeyArray, peerKeyLen, base64Input)) {
-    ESP_LOGI(TAG, "Shared secret computed, AES key derived");
-    memcpy(clientPubKey, base64Input, copyLen + 1);
-    clientPubKeyLen = copyLen;
-    notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_CHALLENGE, session->sessionSalt, sizeof(session->sessionSalt));
+  request->kind = kind;
+  request->resume = false;
+  request->ticketIdLen = 0;
+#ifdef CONFIG_TOOTHPASTE_SESSION_RESUMPTION
+  request->resume = packet->resume;
+  if (kind == CryptoWorker::RECONNECT && packet->resume && packet->resumeTicketLen > 0
+      && packet->resumeTicketLen <= sizeof(request->ticketId)) {
+    memcpy(request->ticketId, packet->resumeTicket, packet->resumeTicketLen);
+    request->ticketIdLen = packet->resumeTicketLen;
   }
-  else {
-    ESP_LOGE(TAG, "Shared secret computation failed");
+#endif
+  return true;
+}
+
+// Hand a pairing AUTH packet to the crypto worker: ECDH with the pairing keypair enrolls the peer
+void requestPairing(DataPacketView* packet)
+{
+  CryptoWorker::Request request;
+  if (!buildRequest(packet, CryptoWorker::PAIR, &request)) {
     stateManager->setState(ERROR);
+    return;
   }
 
-  stateManager->setState(READY);
-  ESP_LOGI(TAG, "Pairing mode disabled");
+  cryptoWorker.submit(request);
 }
 
-// Check whether a reconnecting client is enrolled; compute the session key if so
-void authenticateClient(toothpaste_DataPacket* packet, SecureSession* session)
+// Hand a reconnecting client's AUTH packet to the crypto worker. A client holding a matching
+// resumption ticket is keyed from it, otherwise through ECDH with its enrolled keypair.
+void requestReconnect(DataPacketView* packet)
 {
-  ESP_LOGD(TAG, "Entered authenticateClient");
-
-  // Decode the base64 peer public key from the packet
-  uint8_t peerKeyArray[65];
-  size_t peerKeyLen = 0;
-  int ret = mbedtls_base64_decode(
-    peerKeyArray,
-    sizeof(peerKeyArray),
-    &peerKeyLen,
-    packet->encryptedData.bytes,
-    packet->encryptedData.size);
+  ESP_LOGD(TAG, "Entered requestReconnect");
 
-  if (ret != 0) {
-    ESP_LOGE(TAG, "Base64 decode failed, err %d", ret);
+  CryptoWorker::Request request;
+  if (!buildRequest(packet, CryptoWorker::RECONNECT, &request)) {
     notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_PEER_UNKNOWN, nullptr, 0);
     stateManager->setState(ERROR);
     return;
   }
-  ESP_LOGD(TAG, "Base64 decoded peer public key, length: %zu", peerKeyLen);
+
+  cryptoWorker.submit(request);
+}
+
+// Answer a finished handshake: CHALLENGE with the session salt, or PEER_UNKNOWN for a client
+// that is not enrolled
+void finishHandshake(const CryptoWorker::Result& result)
+{
+  if (result.kind == CryptoWorker::PAIR) {
+    if (result.ok) {
+      ESP_LOGI(TAG, "Shared secret computed, AES key derived in %lu us (queued %lu us)",
+        (unsigned long)result.runUs, (unsigned long)result.waitUs);
+      clientPubKeyLen = strlen(result.base64pubKey);
+      memcpy(clientPubKey, result.base64pubKey, clientPubKeyLen + 1);
+      notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_CHALLENGE, result.salt, sizeof(result.salt));
+    }
+    else {
+      ESP_LOGE(TAG, "Shared secret computation failed");
+      stateManager->setState(ERROR);
+    }
+
+    stateManager->setState(READY);
+    ESP_LOGI(TAG, "Pairing mode disabled");
+    return;
+  }
 
   // Store the base64 key for reference
-  clientPubKeyLen = (packet->encryptedData.size < sizeof(clientPubKey) - 1)
-                    ? packet->encryptedData.size : sizeof(clientPubKey) - 1;
-  memcpy(clientPubKey, packet->encryptedData.bytes, clientPubKeyLen);
-  clientPubKey[clientPubKeyLen] = '\0';
+  clientPubKeyLen = strlen(result.base64pubKey);
+  memcpy(clientPubKey, result.base64pubKey, clientPubKeyLen + 1);
 
-  // Load the enrolled client and compute shared secret on-the-fly
-  if (!session->loadIfEnrolled(peerKeyArray, peerKeyLen, clientPubKey)) {
+  if (!result.ok) {
     ESP_LOGW(TAG, "Client not enrolled or shared secret computation failed");
     notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_PEER_UNKNOWN, nullptr, 0);
     stateManager->setState(UNPAIRED);
     return;
   }
 
-  ESP_LOGI(TAG, "Client authenticated and shared secret computed");
+  ESP_LOGI(TAG, "Client authenticated, session key from %s in %lu us (queued %lu us)",
+    result.resumed ? "ticket" : "ECDH", (unsigned long)result.runUs, (unsigned long)result.waitUs);
 
-  notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_CHALLENGE, session->sessionSalt, sizeof(session->sessionSalt));
+  notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_CHALLENGE, result.salt, sizeof(result.salt),
+                       0, 0, result.resumed);
   stateManager->setState(READY);
 }
@@ -0,0 +1,124 @@
+#include "ble.h"
+#include "StateManager.h"
+
+#include <atomic>
+
+static const char* TAG = "BLE_FLOW";
+
+// The client counts the credits of every write to the input characteristic from connect (one,
+// or one per command for a CompositePacket), and may keep writing while that count is below
+// the last creditLimit it was sent. The limit is a running total rather than a delta, so a
+// notify crossing in-flight writes is harmless.
+//
+// Credits are tracked per keyboard lane. creditLimit only reflects the interactive lane and
+// the ring; bulk writes must also stay under bulkCreditLimit, which keeps
+// BLE_INTERACTIVE_RESERVE ring slots back, so a paste filling its lane never blocks live
+// input or the CancelPacket.
+static std::atomic<uint32_t> writesReceived[KEY_LANE_COUNT];  // BLE callback task
+static std::atomic<uint32_t> writesDropped[KEY_LANE_COUNT];   // BLE callback task; never reached the ring
+static std::atomic<bool>     resetPending{false};
+static uint32_t writesProcessed[KEY_LANE_COUNT];              // packetTask only
+static uint32_t advertisedLimit = 0;
+static uint32_t advertisedBulkLimit = 0;
+static bool     stalled = false;
+static bool     bulkStalled = false;
+
+static KeyLane writeLane(bool bulk)
+{
+  return bulk ? LANE_BULK : LANE_INTERACTIVE;
+}
+
+// New connection: the client starts counting from zero
+void flowReset()
+{
+  for (size_t lane = 0; lane < KEY_LANE_COUNT; lane++) {
+    writesReceived[lane].store(0, std::memory_order_relaxed);
+    writesDropped[lane].store(0, std::memory_order_relaxed);
+  }
+  resetPending.store(true, std::memory_order_release);
+}
+
+// Count a write accepted by the input characteristic (queued or dropped)
+void flowOnWrite(uint32_t credits, bool bulk)
+{
+  writesReceived[writeLane(bulk)].fetch_add(credits, std::memory_order_release);
+}
+
+// A counted write was discarded before reaching the ring (too short, ring full)
+void flowOnDropped(uint32_t credits, bool bulk)
+{
+  writesDropped[writeLane(bulk)].fetch_add(credits, std::memory_order_release);
+}
+
+// A queued packet has been dispatched and its ring slot released
+void flowOnProcessed(uint32_t credits, bool bulk)
+{
+  writesProcessed[writeLane(bulk)] += credits;
+}
+
+// Credits a lane can take without dropping: each write needs a ring slot for the largest
+// write the link allows and may later put that much text into the lane's HID stream, as may
+// the lane's packets already waiting in the ring
+static uint32_t laneCredits(KeyLane lane, uint32_t received, uint32_t settled, size_t ringRoom, uint16_t maxWrite)
+{
+  uint32_t inRing = (received > settled) ? received - settled : 0;
+  size_t hidSpaces = hidQueueSpaces(lane, maxWrite);
+  size_t hidRoom = (hidSpaces > inRing) ? hidSpaces - inRing : 0;
+  return (uint32_t)(ringRoom < hidRoom ? ringRoom : hidRoom);
+}
+
+// Re-evaluate credits and notify the client when it is blocked, a batch has freed up, or the
+// bulk lane stalls or resumes. Called by packetTask after each packet and on idle polls.
+void flowUpdate(SecureSession* session)
+{
+  if (resetPending.exchange(false, std::memory_order_acquire)) {
+    for (size_t lane = 0; lane < KEY_LANE_COUNT; lane++) writesProcessed[lane] = 0;
+    advertisedLimit = 0;
+    advertisedBulkLimit = 0;
+    stalled = false;
+    bulkStalled = false;
+  }
+
+  // Nothing to pace until the client can send encrypted data
+  if (!session->isSessionKeyReady()) return;
+
+  // Dropped is read before received, so a drop is never subtracted without its write
+  uint32_t settled[KEY_LANE_COUNT], received[KEY_LANE_COUNT];
+  uint32_t total = 0;
+  for (size_t lane = 0; lane < KEY_LANE_COUNT; lane++) {
+    settled[lane] = writesProcessed[lane] + writesDropped[lane].load(std::memory_order_acquire);
+    received[lane] = writesReceived[lane].load(std::memory_order_acquire);
+    total += received[lane];
+  }
+
+  uint16_t maxWrite = linkInfo().maxWrite;
+  size_t ringRoom = packetRing.fitCount(maxWrite + INGEST_STAMP_SIZE);
+  size_t bulkRingRoom = (ringRoom > BLE_INTERACTIVE_RESERVE) ? ringRoom - BLE_INTERACTIVE_RESERVE : 0;
+  uint32_t credits = laneCredits(LANE_INTERACTIVE, received[LANE_INTERACTIVE], settled[LANE_INTERACTIVE],
+                                 ringRoom, maxWrite);
+  uint32_t bulkCredits = laneCredits(LANE_BULK, received[LANE_BULK], settled[LANE_BULK], bulkRingRoom, maxWrite);
+  uint32_t limit = total + credits;
+  uint32_t bulkLimit = total + bulkCredits;
+
+  if (credits == 0) {
+    if (!stalled) {
+      stalled = true;
+      bulkStalled = true;
+      ESP_LOGD(TAG, "RECV_NOT_READY  limit=%lu  ring=%u B", (unsigned long)limit, (unsigned)packetRing.used());
+      notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_RECV_NOT_READY, nullptr, 0, limit, bulkLimit);
+    }
+    return;
+  }
+
+  bool bulkChanged = (bulkCredits == 0) != bulkStalled;
+  if (stalled || bulkChanged || limit >= advertisedLimit + BLE_CREDIT_BATCH ||
+      bulkLimit >= advertisedBulkLimit + BLE_CREDIT_BATCH) {
+    stalled = false;
+    bulkStalled = (bulkCredits == 0);
+    advertisedLimit = limit;
+    advertisedBulkLimit = bulkLimit;
+    ESP_LOGD(TAG, "RECV_READY  limit=%lu  credits=%lu  bulk=%lu", (unsigned long)limit, (unsigned long)credits,
+      (unsigned long)bulkCredits);
+    notifyResponsePacket(toothpaste_ResponsePacket_ResponseType_RECV_READY, nullptr, 0, limit, bulkLimit);
+  }
+}
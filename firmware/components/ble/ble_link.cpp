@@ -0,0 +1,114 @@
+#include "ble.h"
+#include "host/ble_hs.h"
+
+#include <atomic>
+
+static const char* TAG = "BLE";
+
+static std::atomic<uint16_t> linkConn{BLE_HS_CONN_HANDLE_NONE};
+static std::atomic<uint8_t>  linkPhy{0};  // Our TX PHY, tracked from GAP events instead of read over HCI
+static struct ble_gap_event_listener gapListener;
+
+// Follow PHY changes for the current link; every connection starts on the 1M PHY
+static int onGapEvent(struct ble_gap_event* event, void* arg)
+{
+  if (event->type != BLE_GAP_EVENT_PHY_UPDATE_COMPLETE) return 0;
+  if (event->phy_updated.conn_handle != linkConn.load(std::memory_order_relaxed)) return 0;
+
+  if (event->phy_updated.status != 0) {
+    ESP_LOGD(TAG, "PHY update status %d", event->phy_updated.status);
+    return 0;
+  }
+  linkPhy.store(event->phy_updated.tx_phy, std::memory_order_relaxed);
+  ESP_LOGI(TAG, "PHY now tx=%u rx=%u", event->phy_updated.tx_phy, event->phy_updated.rx_phy);
+  return 0;
+}
+
+// Log the MTU once our exchange completes (the central may have started its own first)
+static int onMtuExchanged(uint16_t connHandle, const struct ble_gatt_error* error, uint16_t mtu, void* arg)
+{
+  if (error != nullptr && error->status != 0) {
+    ESP_LOGD(TAG, "MTU exchange status %d, using %u", error->status, ble_att_mtu(connHandle));
+    return 0;
+  }
+  ESP_LOGI(TAG, "MTU negotiated: %u (max payload %u B)", mtu, linkInfo().maxPayload);
+  return 0;
+}
+
+// Ask for the largest MTU, LE Data Length Extension and the 2M PHY. Each request is
+// best effort: a central without support keeps the defaults and the link still works.
+void linkNegotiate(uint16_t connHandle)
+{
+  linkConn.store(connHandle, std::memory_order_relaxed);
+  linkPhy.store(BLE_HCI_LE_PHY_1M, std::memory_order_relaxed);
+
+  static bool listening = false;
+  if (!listening) {
+    listening = (ble_gap_event_listener_register(&gapListener, onGapEvent, nullptr) == 0);
+    if (!listening) ESP_LOGW(TAG, "GAP listener not registered, PHY updates will not be reported");
+  }
+
+  int rc = ble_gap_set_prefered_le_phy(connHandle, BLE_GAP_LE_PHY_2M_MASK, BLE_GAP_LE_PHY_2M_MASK,
+                                       BLE_GAP_LE_PHY_CODED_ANY);
+  if (rc != 0) ESP_LOGW(TAG, "2M PHY request failed: %d", rc);
+
+  rc = ble_gap_set_data_len(connHandle, BLE_DLE_TX_OCTETS, BLE_DLE_TX_TIME);
+  if (rc != 0) ESP_LOGW(TAG, "Data length request failed: %d", rc);
+
+  rc = ble_gattc_exchange_mtu(connHandle, onMtuExchanged, nullptr);
+  if (rc != 0) ESP_LOGD(TAG, "MTU exchange not started: %d", rc);
+}
+
+void linkClear()
+{
+  linkConn.store(BLE_HS_CONN_HANDLE_NONE, std::memory_order_relaxed);
+  linkPhy.store(0, std::memory_order_relaxed);
+}
+
+uint16_t linkHandle()
+{
+  return linkConn.load(std::memory_order_relaxed);
+}
+
+// Ask the central for a connection-parameter profile; it may pick anything in range or refuse
+void linkRequestProfile(ConnGovernor::Profile profile)
+{
+  uint16_t conn = linkConn.load(std::memory_order_relaxed);
+  if (conn == BLE_HS_CONN_HANDLE_NONE) return;
+
+  const ConnGovernor::Params& p = ConnGovernor::params(profile);
+  struct ble_gap_upd_params params = {};
+  params.itvl_min = p.intervalMin;
+  params.itvl_max = p.intervalMax;
+  params.latency = p.latency;
+  params.supervision_timeout = p.timeout;
+
+  int rc = ble_gap_update_params(conn, &params);
+  ESP_LOGI(TAG, "Conn profile %s: interval %u-%u x1.25ms, latency %u (rc=%d)",
+    ConnGovernor::name(profile), p.intervalMin, p.intervalMax, p.latency, rc);
+}
+
+// Current link limits; cheap enough for every notify and flow update (no HCI round trips)
+LinkInfo linkInfo()
+{
+  LinkInfo info = {BLE_ATT_MTU_DFLT, 0, 0, 0, 0, 0};
+  uint16_t conn = linkConn.load(std::memory_order_relaxed);
+
+  if (conn != BLE_HS_CONN_HANDLE_NONE) {
+    uint16_t mtu = ble_att_mtu(conn);
+    if (mtu != 0) info.attMtu = mtu;
+
+    struct ble_gap_conn_desc desc;
+    if (ble_gap_conn_find(conn, &desc) == 0) {
+      info.connInterval = desc.conn_itvl;
+      info.connLatency = desc.conn_latency;
+    }
+
+    info.phy = linkPhy.load(std::memory_order_relaxed);
+  }
+
+  uint16_t writeLen = info.attMtu - 3; // ATT write header
+  info.maxWrite = (writeLen < BLE_MAX_RAW_PACKET) ? writeLen : BLE_MAX_RAW_PACKET;
+  info.maxPayload = (info.maxWrite > DATA_PACKET_OVERHEAD) ? info.maxWrite - DATA_PACKET_OVERHEAD : 0;
+  return info;
+}
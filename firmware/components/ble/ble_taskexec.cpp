@@ -8,101 +8,263 @@
 
 static const char* TAG = "BLE_TASK";
 
-// Decrypt a data packet and dispatch its payload to the appropriate HID function
-void decryptSendString(toothpaste_DataPacket* packet, SecureSession* session)
-{
-  int64_t t0 = esp_timer_get_time();
-
-  // Average decryption time: ~377us with key caching; ~13ms without
-  // Max encryptedData field is 228 bytes; +2 matches the original buffer sizing
-  uint8_t decrypted_bytes[230];
-  toothpaste_EncryptedData decrypted = toothpaste_EncryptedData_init_default;
-
-  int ret = session->decrypt(packet, decrypted_bytes, clientPubKey);
-  int64_t decryptUs = esp_timer_get_time() - t0;
-
-  if (ret != 0) {
-    ESP_LOGE(TAG, "Decryption failed (err %d)", ret);
-    stateManager->setState(DROP);
-    return;
-  }
-
-  pb_istream_t stream = pb_istream_from_buffer(decrypted_bytes, packet->dataLen);
-  if (!pb_decode(&stream, toothpaste_EncryptedData_fields, &decrypted)) {
-    ESP_LOGE(TAG, "Protobuf decode failed: %s", PB_GET_ERROR(&stream));
-    return;
-  }
+static size_t dispatchEncryptedData(uint8_t* msg, size_t msgLen, DataPacketView* packet, SecureSession* session,
+                                    int64_t decryptUs, bool inComposite);
 
-  stateManager->setState(READY);
-
-  switch (decrypted.which_packetData) {
+// Execute one EncryptedData payload (a oneof sub-message still sitting in the plaintext buffer).
+// Only small fixed-layout messages are materialized; returns the bytes copied to do so.
+static size_t dispatchPayload(PbField& payload, DataPacketView* packet, SecureSession* session,
+                              int64_t decryptUs, bool inComposite)
+{
+  switch (payload.tag) {
     case toothpaste_EncryptedData_keyboardPacket_tag:
     {
-      auto& kp = decrypted.packetData.keyboardPacket;
-      ESP_LOGD(TAG, "KEYBOARD  decrypt=%lldus  len=%lu  slow=%d  msg=\"%.*s\"",
-        decryptUs, packet->dataLen, packet->slowMode,
-        (int)kp.length, kp.message);
-      sendString(kp.message, kp.length, packet->slowMode);
-      break;
+      uint8_t* msg;
+      size_t msgLen;
+      uint32_t length;
+      findStringField(payload.data, payload.len, toothpaste_KeyboardPacket_message_tag,
+                      toothpaste_KeyboardPacket_length_tag, &msg, &msgLen, &length);
+      if (length > 0 && length < msgLen) msgLen = length;
+      toothpaste_TypingProfile profile = resolveTypingProfile(packet->typingProfile, packet->slowMode);
+      ESP_LOGD(TAG, "KEYBOARD  decrypt=%lldus  len=%lu  typing=%s  bulk=%d  msg=\"%.*s\"",
+        decryptUs, packet->dataLen, typingProfileName(profile), packet->bulk, (int)msgLen, (const char*)msg);
+      if (msg != nullptr) sendString((const char*)msg, msgLen, profile, packet->bulk ? LANE_BULK : LANE_INTERACTIVE);
+      return 0;
     }
 
     case toothpaste_EncryptedData_keycodePacket_tag:
     {
-      auto& kc = decrypted.packetData.keycodePacket;
+      uint8_t* code;
+      size_t codeLen;
+      uint32_t length;
+      findStringField(payload.data, payload.len, toothpaste_KeycodePacket_code_tag,
+                      toothpaste_KeycodePacket_length_tag, &code, &codeLen, &length);
+
+      if (length > 0 && length < codeLen) codeLen = length; // An empty code list just releases all keys
+
       char hexbuf[19];
-      for (int i = 0; i < 6; i++) snprintf(hexbuf + i*3, 4, "%02X ", kc.code.bytes[i]);
-      ESP_LOGD(TAG, "KEYCODE   decrypt=%lldus  slow=%d  codes=%s", decryptUs, packet->slowMode, hexbuf);
-      sendKeycode(kc.code.bytes, packet->slowMode, true);
-      break;
+      size_t shown = codeLen < 6 ? codeLen : 6;
+      hexbuf[0] = '\0';
+      for (size_t i = 0; i < shown; i++) snprintf(hexbuf + i*3, 4, "%02X ", code[i]);
+      toothpaste_TypingProfile profile = resolveTypingProfile(packet->typingProfile, packet->slowMode);
+      ESP_LOGD(TAG, "KEYCODE   decrypt=%lldus  typing=%s  keys=%u  codes=%s", decryptUs, typingProfileName(profile),
+        (unsigned)codeLen, hexbuf);
+      queueKeycode(code, codeLen, profile, packet->bulk ? LANE_BULK : LANE_INTERACTIVE);
+      return codeLen;
     }
 
     case toothpaste_EncryptedData_mousePacket_tag:
     {
-      auto& mp = decrypted.packetData.mousePacket;
+      toothpaste_MousePacket mp = toothpaste_MousePacket_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+      if (!pb_decode(&stream, toothpaste_MousePacket_fields, &mp)) {
+        ESP_LOGE(TAG, "Mouse decode failed: %s", PB_GET_ERROR(&stream));
+        return 0;
+      }
       ESP_LOGD(TAG, "MOUSE     decrypt=%lldus  frames=%lu  L=%ld R=%ld wheel=%ld",
         decryptUs, mp.num_frames, mp.l_click, mp.r_click, mp.wheel);
-      moveMouse(mp);
-      break;
+      queueMouse(mp);
+      return sizeof(mp);
+    }
+
+    case toothpaste_EncryptedData_pointerPacket_tag:
+    {
+      toothpaste_PointerPacket pp = toothpaste_PointerPacket_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+      if (!pb_decode(&stream, toothpaste_PointerPacket_fields, &pp)) {
+        ESP_LOGE(TAG, "Pointer decode failed: %s", PB_GET_ERROR(&stream));
+        return 0;
+      }
+      ESP_LOGD(TAG, "POINTER   decrypt=%lldus  x=%lu y=%lu  L=%ld R=%ld wheel=%ld",
+        decryptUs, pp.x, pp.y, pp.l_click, pp.r_click, pp.wheel);
+      queuePointer(pp);
+      return sizeof(pp);
     }
 
     case toothpaste_EncryptedData_consumerControlPacket_tag:
     {
-      auto& cp = decrypted.packetData.consumerControlPacket;
+      toothpaste_ConsumerControlPacket cp = toothpaste_ConsumerControlPacket_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+      if (!pb_decode(&stream, toothpaste_ConsumerControlPacket_fields, &cp)) {
+        ESP_LOGE(TAG, "Consumer control decode failed: %s", PB_GET_ERROR(&stream));
+        return 0;
+      }
       char codebuf[64] = {};
       int cpos = 0;
       for (size_t i = 0; i < cp.length && cpos < (int)sizeof(codebuf) - 7; i++)
         cpos += snprintf(codebuf + cpos, sizeof(codebuf) - cpos, "0x%04lX ", (unsigned long)cp.code[i]);
       ESP_LOGD(TAG, "CONSUMER  decrypt=%lldus  count=%lu  codes=%s", decryptUs, cp.length, codebuf);
-      consumerControlPress(cp);
-      break;
+      queueConsumerControl(cp);
+      return sizeof(cp);
     }
 
     case toothpaste_EncryptedData_mouseJigglePacket_tag:
     {
-      bool enable = decrypted.packetData.mouseJigglePacket.enable;
-      ESP_LOGD(TAG, "JIGGLE    decrypt=%lldus  state=%s", decryptUs, enable ? "ON" : "OFF");
-      enable ? startJiggle() : stopJiggle();
-      break;
+      toothpaste_MouseJigglePacket jp = toothpaste_MouseJigglePacket_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+      if (!pb_decode(&stream, toothpaste_MouseJigglePacket_fields, &jp)) {
+        ESP_LOGE(TAG, "Jiggle decode failed: %s", PB_GET_ERROR(&stream));
+        return 0;
+      }
+      ESP_LOGD(TAG, "JIGGLE    decrypt=%lldus  state=%s", decryptUs, jp.enable ? "ON" : "OFF");
+      jp.enable ? startJiggle() : stopJiggle();
+      return sizeof(jp);
+    }
+
+    case toothpaste_EncryptedData_keyboardLayoutPacket_tag:
+    {
+      // Walked in place: the custom table stays in the plaintext buffer until it is queued
+      uint32_t layout = toothpaste_KeyboardLayoutPacket_LayoutID_EN_US;
+      uint8_t* table = nullptr;
+      size_t tableLen = 0;
+      PbReader reader(payload.data, payload.len);
+      PbField field;
+      while (reader.next(&field)) {
+        if (field.tag == toothpaste_KeyboardLayoutPacket_layout_tag && field.wireType == PB_WT_VARINT) {
+          layout = (uint32_t)field.varint;
+        }
+        else if (field.tag == toothpaste_KeyboardLayoutPacket_customTable_tag && field.wireType == PB_WT_STRING) {
+          table = field.data;
+          tableLen = field.len;
+        }
+      }
+      ESP_LOGD(TAG, "LAYOUT    decrypt=%lldus  layout=%lu  table=%uB", decryptUs, (unsigned long)layout, (unsigned)tableLen);
+      queueKeyboardLayout((toothpaste_KeyboardLayoutPacket_LayoutID)layout, table, tableLen,
+                          packet->bulk ? LANE_BULK : LANE_INTERACTIVE);
+      return 0;
     }
 
     case toothpaste_EncryptedData_renamePacket_tag:
     {
-      auto& rp = decrypted.packetData.renamePacket;
-      ESP_LOGD(TAG, "RENAME    decrypt=%lldus  name=\"%s\"", decryptUs, rp.message);
-      int renameRet = session->setDeviceName(rp.message);
+      uint8_t* msg;
+      size_t msgLen;
+      uint32_t length;
+      findStringField(payload.data, payload.len, toothpaste_RenamePacket_message_tag,
+                      toothpaste_RenamePacket_length_tag, &msg, &msgLen, &length);
+
+      // setDeviceName() needs a terminated string
+      char name[sizeof(toothpaste_RenamePacket::message)];
+      size_t nameLen = msgLen < sizeof(name) - 1 ? msgLen : sizeof(name) - 1;
+      memcpy(name, msg, nameLen);
+      name[nameLen] = '\0';
+
+      ESP_LOGD(TAG, "RENAME    decrypt=%lldus  name=\"%s\"", decryptUs, name);
+      int renameRet = session->setDeviceName(name);
       ESP_LOGI(TAG, "Rename status=%d, rebooting", renameRet);
       esp_restart();
-      break;
+      return nameLen;
+    }
+
+    case toothpaste_EncryptedData_cancelPacket_tag:
+    {
+      toothpaste_CancelPacket cp = toothpaste_CancelPacket_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+      if (!pb_decode(&stream, toothpaste_CancelPacket_fields, &cp)) {
+        ESP_LOGE(TAG, "Cancel decode failed: %s", PB_GET_ERROR(&stream));
+        return 0;
+      }
+      ESP_LOGD(TAG, "CANCEL    decrypt=%lldus  mouse=%d", decryptUs, cp.mouse);
+      cancelBulkKeyboard();
+      if (cp.mouse) cancelQueuedMouse();
+      return sizeof(cp);
+    }
+
+    case toothpaste_EncryptedData_compositePacket_tag:
+    {
+      // Batches are one level deep so a crafted packet can't recurse the worker stack
+      if (inComposite) {
+        ESP_LOGW(TAG, "COMPOSITE nested batch ignored");
+        return 0;
+      }
+
+      int64_t t0 = esp_timer_get_time();
+      size_t copied = 0;
+      unsigned ops = 0;
+
+      PbReader reader(payload.data, payload.len);
+      PbField command;
+      while (reader.next(&command)) {
+        if (command.tag != toothpaste_CompositePacket_commands_tag || command.wireType != PB_WT_STRING) continue;
+        copied += dispatchEncryptedData(command.data, command.len, packet, session, decryptUs, true);
+        ops++;
+      }
+      if (!reader.ok()) {
+        ESP_LOGE(TAG, "Composite decode failed after %u ops: %s", ops, reader.error());
+      }
+
+      // One decrypt amortized over the whole batch; compare against single-op Task cycle times
+      int64_t batchUs = esp_timer_get_time() - t0 + decryptUs;
+      ESP_LOGD(TAG, "COMPOSITE decrypt=%lldus  ops=%u  total=%lldus  (%lld ops/s)",
+        decryptUs, ops, batchUs, batchUs > 0 ? (int64_t)ops * 1000000 / batchUs : 0);
+      return copied;
     }
 
     default:
-      ESP_LOGW(TAG, "UNKNOWN   decrypt=%lldus  tag=%d", decryptUs, decrypted.which_packetData);
-      break;
+      ESP_LOGW(TAG, "UNKNOWN   decrypt=%lldus  tag=%lu", decryptUs, (unsigned long)payload.tag);
+      return 0;
+  }
+}
+
+// Walk a serialized EncryptedData and execute its payload. The oneof normally holds a
+// single entry; a CompositePacket entry expands into an ordered list of EncryptedData.
+static size_t dispatchEncryptedData(uint8_t* msg, size_t msgLen, DataPacketView* packet, SecureSession* session,
+                                    int64_t decryptUs, bool inComposite)
+{
+  PbReader reader(msg, msgLen);
+  PbField field;
+  size_t copied = 0;
+
+  while (reader.next(&field)) {
+    if (field.tag == toothpaste_EncryptedData_packetType_tag) continue;
+    if (field.wireType != PB_WT_STRING) continue;
+    copied += dispatchPayload(field, packet, session, decryptUs, inComposite);
   }
+
+  if (!reader.ok()) {
+    ESP_LOGE(TAG, "Protobuf decode failed: %s", reader.error());
+  }
+
+  return copied;
+}
+
+// Decrypt a data packet in place in the receive buffer and dispatch its payload to the
+// appropriate HID function. Returns false if the packet was rejected; *copied receives the
+// bytes copied out of the buffer while dispatching.
+bool decryptSendString(DataPacketView* packet, SecureSession* session, size_t* copied)
+{
+  *copied = 0;
+
+  int64_t t0 = esp_timer_get_time();
+
+  // Average decryption time: ~377us with key caching; ~13ms without (CONFIG_TOOTHPASTE_CRYPTO_BENCHMARK)
+  if (packet->encryptedData == nullptr ||
+      packet->ivLen != SecureSession::IV_SIZE || packet->tagLen != SecureSession::TAG_SIZE) {
+    ESP_LOGE(TAG, "Malformed data packet (iv=%u tag=%u)", (unsigned)packet->ivLen, (unsigned)packet->tagLen);
+    stateManager->setState(DROP);
+    return false;
+  }
+
+  int ret = session->decryptInPlace(packet->iv, packet->encryptedData, packet->encryptedLen, packet->tag);
+  int64_t decryptUs = esp_timer_get_time() - t0;
+
+  if (ret != 0) {
+    ESP_LOGE(TAG, "Decryption failed (err %d)", ret);
+    stateManager->setState(DROP);
+    return false;
+  }
+
+  // encryptedData now holds the serialized EncryptedData plaintext
+  size_t plainLen = (packet->dataLen < packet->encryptedLen) ? packet->dataLen : packet->encryptedLen;
+
+  stateManager->setState(READY);
+
+  *copied = dispatchEncryptedData(packet->encryptedData, plainLen, packet, session, decryptUs, false);
+  return true;
 }
 
 // Send a protobuf ResponsePacket to the client via BLE notify
-void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, const uint8_t* challengeData, size_t challengeDataLen)
+void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, const uint8_t* challengeData, size_t challengeDataLen,
+                          uint32_t creditLimit, uint32_t bulkCreditLimit, bool resumed)
 {
   uint8_t buffer[256];
   pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
@@ -111,6 +273,16 @@ void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, c
   strncpy(responsePacket.firmwareVersion, FIRMWARE_VERSION, sizeof(responsePacket.firmwareVersion) - 1);
   responsePacket.firmwareVersion[sizeof(responsePacket.firmwareVersion) - 1] = '\0';
   responsePacket.responseType = responseType;
+  responsePacket.creditLimit = creditLimit;
+  responsePacket.bulkCreditLimit = bulkCreditLimit;
+  responsePacket.resumed = resumed;
+  responsePacket.absolutePointer = pointerAvailable(); // Otherwise the client positions with relative frames
+
+  LinkInfo link = linkInfo();
+  responsePacket.attMtu = link.attMtu;
+  responsePacket.maxPayload = link.maxPayload;
+  responsePacket.phy = link.phy;
+  responsePacket.connInterval = link.connInterval;
 
   if (challengeData != nullptr && challengeDataLen > 0) {
     size_t copyLen = (challengeDataLen < sizeof(responsePacket.challengeData.bytes))
@@ -128,40 +300,154 @@ void notifyResponsePacket(toothpaste_ResponsePacket_ResponseType responseType, c
   responseCharacteristic->notify();
 }
 
+// Feed the connection-parameter governor a packet arrival or idle tick, and log the interval
+// the central actually applied whenever it changes
+static void governConnection(ConnGovernor* governor, uint16_t* governedConn, uint16_t* reportedInterval,
+                             bool packetArrived)
+{
+  int64_t now = esp_timer_get_time();
+  uint16_t conn = linkHandle();
+  if (conn != *governedConn) {
+    *governedConn = conn;
+    governor->reset(now);
+  }
+
+  bool changed = packetArrived ? governor->onPacket(now) : governor->onTick(now);
+  if (changed) {
+    linkRequestProfile(governor->profile());
+  }
+
+  uint16_t interval = linkInfo().connInterval;
+  if (interval != *reportedInterval) {
+    *reportedInterval = interval;
+    ESP_LOGI(TAG, "Conn interval now %u.%02u ms (profile %s)", interval * 125 / 100, (interval * 125) % 100,
+      ConnGovernor::name(governor->profile()));
+  }
+}
+
+// Answer finished handshakes, waiting up to `wait` ticks for the first. A handshake whose link
+// closed keyed the session after onDisconnect() ended it, so that key is wiped instead.
+static void collectHandshakes(SecureSession* session, TickType_t wait)
+{
+  CryptoWorker::Result handshake;
+  while (cryptoWorker.poll(&handshake, wait)) {
+    wait = 0;
+    if (cryptoWorker.stale(handshake)) {
+      ESP_LOGW(TAG, "Handshake finished after its link closed, discarded");
+      session->endSession();
+      continue;
+    }
+    finishHandshake(handshake);
+  }
+}
+
 // Persistent RTOS task: receives raw BLE packets, decodes protobuf, routes to auth or data path
 void packetTask(void* params)
 {
   SecureSession* session = static_cast<SecureSession*>(params);
-  RawPacket pkt;
+  TransferAssembler transfer;
+  ConnGovernor governor;
+  uint16_t governedConn = linkHandle();
+  uint16_t reportedInterval = 0;
+  size_t reportedHighWater = 0;
+  int64_t lastPipelineReport = esp_timer_get_time();
 
   while (true) {
-    if (xQueueReceive(packetQueue, &pkt, portMAX_DELAY) == pdTRUE) {
-      int64_t t0 = esp_timer_get_time();
+    uint16_t len = 0;
+    uint8_t* data = packetRing.peek(&len, pdMS_TO_TICKS(BLE_FLOW_POLL_MS)); // Decoded in place, released after dispatch
 
-      toothpaste_DataPacket toothPacket = toothpaste_DataPacket_init_default;
-      pb_istream_t istream = pb_istream_from_buffer(pkt.data, pkt.len);
-      if (!pb_decode(&istream, toothpaste_DataPacket_fields, &toothPacket)) {
-        ESP_LOGE(TAG, "Outer decode failed: %s", PB_GET_ERROR(&istream));
+    // Answer handshakes the crypto worker finished while packets kept flowing
+    collectHandshakes(session, 0);
+
+    if (data == nullptr) {
+      flowUpdate(session); // Idle: the HID queue may have drained since the last advertisement
+      governConnection(&governor, &governedConn, &reportedInterval, false);
+      if (esp_timer_get_time() - lastPipelineReport >= PIPELINE_REPORT_US) {
+        pipelineReport();
+        lastPipelineReport = esp_timer_get_time();
       }
+      continue;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    uint32_t decodeStart = pipelineNowUs();
+    uint32_t stamp;
+    memcpy(&stamp, data, INGEST_STAMP_SIZE);
+    pipelineRecord(STAGE_INGEST, decodeStart - stamp);
+    data += INGEST_STAMP_SIZE;
+    len -= INGEST_STAMP_SIZE;
+    governConnection(&governor, &governedConn, &reportedInterval, true);
+    bool bulk;
+    uint32_t credits = writeCredits(data, len, &bulk); // The same charge onWrite() counted for this slot
 
-      if (toothPacket.packetID == toothpaste_DataPacket_PacketID_DATA_PACKET) {
-        ESP_LOGD(TAG, "DATA  raw=%uB  payload=%luB  slow=%d  pkt=%ld/%ld",
-          pkt.len, toothPacket.dataLen, toothPacket.slowMode,
-          toothPacket.packetNumber, toothPacket.totalPackets);
-        decryptSendString(&toothPacket, session);
+    // Index the packet in place; ciphertext is decrypted where it sits in the ring slot
+    DataPacketView toothPacket;
+    size_t copied = 0;
+    if (!decodeDataPacketView(data, len, &toothPacket)) {
+      ESP_LOGE(TAG, "Outer decode failed");
+    }
+    else if (toothPacket.packetID == toothpaste_DataPacket_PacketID_DATA_PACKET && cryptoWorker.busy()) {
+      // The client only encrypts with the new key after CHALLENGE, which has not gone out yet
+      ESP_LOGW(TAG, "DATA during handshake, dropped");
+    }
+    else if (toothPacket.packetID == toothpaste_DataPacket_PacketID_DATA_PACKET) {
+      TransferAssembler::Verdict verdict = transfer.check(toothPacket.packetNumber, toothPacket.totalPackets);
+      ESP_LOGD(TAG, "DATA  raw=%uB  payload=%luB  slow=%d  pkt=%ld/%ld (%s)",
+        len, toothPacket.dataLen, toothPacket.slowMode,
+        toothPacket.packetNumber, toothPacket.totalPackets, TransferAssembler::verdictName(verdict));
+
+      if (verdict == TransferAssembler::GAP) {
+        stateManager->setState(DROP);
       }
-      else if (toothPacket.packetID == toothpaste_DataPacket_PacketID_AUTH_PACKET) {
-        bool pairing = (stateManager->getState() == PAIRING);
-        ESP_LOGD(TAG, "AUTH  raw=%uB  mode=%s", pkt.len, pairing ? "PAIRING" : "RECONNECT");
-        if (pairing) {
-          generateSharedSecret(&toothPacket, session);
-        }
-        else {
-          authenticateClient(&toothPacket, session);
+      else if (verdict != TransferAssembler::DUPLICATE) {
+        bool ok = decryptSendString(&toothPacket, session, &copied);
+        if (verdict != TransferAssembler::STANDALONE) {
+          if (!ok) {
+            transfer.abort("decrypt failed");
+          }
+          else if (transfer.accept(toothPacket.packetNumber, toothPacket.totalPackets, toothPacket.dataLen,
+                                   esp_timer_get_time())) {
+            // One completion for the whole transfer once the HID side types it out
+            endStringJob(toothPacket.bulk ? LANE_BULK : LANE_INTERACTIVE);
+          }
         }
       }
+    }
+    else if (toothPacket.packetID == toothpaste_DataPacket_PacketID_AUTH_PACKET) {
+      // A handshake the last client left running ends first, so its key is wiped before this one is keyed
+      if (cryptoWorker.busyWithOldLink()) {
+        collectHandshakes(session, pdMS_TO_TICKS(CRYPTO_STALE_WAIT_MS));
+      }
 
-      ESP_LOGD(TAG, "Task cycle: %lld us", esp_timer_get_time() - t0);
+      bool pairing = (stateManager->getState() == PAIRING);
+      ESP_LOGD(TAG, "AUTH  raw=%uB  mode=%s", len, pairing ? "PAIRING" : "RECONNECT");
+      if (cryptoWorker.busy()) {
+        // A resent AUTH would queue a second handshake, and in PAIRING a second ECDH against
+        // the keypair the first one already spent; the first handshake's answer covers it
+        ESP_LOGW(TAG, "AUTH during handshake, ignored");
+      }
+      else if (pairing) {
+        requestPairing(&toothPacket);
+      }
+      else {
+        requestReconnect(&toothPacket);
+      }
+    }
+
+    pipelineRecord(STAGE_DECODE, pipelineNowUs() - decodeStart);
+    packetRing.release();
+    flowOnProcessed(credits, bulk);
+    flowUpdate(session);
+
+    // Report ring and stack pressure whenever the ring reaches a new peak
+    size_t highWater = packetRing.highWater();
+    if (highWater > reportedHighWater) {
+      reportedHighWater = highWater;
+      ESP_LOGI(TAG, "Ingest ring high-water: %u/%u B, stack free: %u B", (unsigned)highWater,
+        (unsigned)packetRing.capacity(), (unsigned)uxTaskGetStackHighWaterMark(nullptr));
     }
+
+    // copied = bytes moved after the ring slot write (in-place decrypt/decode moves none)
+    ESP_LOGD(TAG, "Task cycle: %lld us  copied=%uB", esp_timer_get_time() - t0, (unsigned)copied);
   }
 }
@@ -0,0 +1,69 @@
+#include "MouseMotion.h"
+
+static int64_t magnitude(int64_t v)
+{
+    return v < 0 ? -v : v;
+}
+
+static int32_t clampFrame(int32_t v)
+{
+    return v > MOUSE_FRAME_MAX ? MOUSE_FRAME_MAX : v < -MOUSE_FRAME_MAX ? -MOUSE_FRAME_MAX : v;
+}
+
+// Share i of total split into n nearly equal whole parts; the n shares sum to total
+static int64_t share(int64_t total, uint32_t i, uint32_t n)
+{
+    return total * (i + 1) / n - total * i / n;
+}
+
+MouseMotion::MouseMotion(uint16_t scale)
+    : scale_(scale)
+{
+    reset();
+}
+
+void MouseMotion::reset()
+{
+    fracX_ = fracY_ = 0;
+    totalX_ = totalY_ = totalWheel_ = 0;
+    steps_ = step_ = 0;
+}
+
+void MouseMotion::add(int32_t dx, int32_t dy, int32_t wheel)
+{
+    // Whatever of the last frame was not sent yet
+    int64_t restX = 0, restY = 0, restWheel = 0;
+    if (step_ < steps_) {
+        restX = totalX_ - totalX_ * step_ / steps_;
+        restY = totalY_ - totalY_ * step_ / steps_;
+        restWheel = totalWheel_ - totalWheel_ * step_ / steps_;
+    }
+
+    // Division truncates toward zero, so the carried fraction keeps the motion's sign
+    fracX_ += (int64_t)clampFrame(dx) * scale_;
+    fracY_ += (int64_t)clampFrame(dy) * scale_;
+    int64_t wholeX = fracX_ / MOUSE_SCALE_ONE;
+    int64_t wholeY = fracY_ / MOUSE_SCALE_ONE;
+    fracX_ -= wholeX * MOUSE_SCALE_ONE;
+    fracY_ -= wholeY * MOUSE_SCALE_ONE;
+
+    totalX_ = restX + wholeX;
+    totalY_ = restY + wholeY;
+    totalWheel_ = restWheel + clampFrame(wheel);
+
+    int64_t largest = magnitude(totalX_);
+    if (magnitude(totalY_) > largest) largest = magnitude(totalY_);
+    if (magnitude(totalWheel_) > largest) largest = magnitude(totalWheel_);
+    steps_ = (uint32_t)((largest + MOUSE_STEP_MAX - 1) / MOUSE_STEP_MAX);
+    step_ = 0;
+}
+
+bool MouseMotion::next(MouseStep* step)
+{
+    if (step_ >= steps_) return false;
+    step->x = (int8_t)share(totalX_, step_, steps_);
+    step->y = (int8_t)share(totalY_, step_, steps_);
+    step->wheel = (int8_t)share(totalWheel_, step_, steps_);
+    step_++;
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+
+// Largest movement one relative mouse report can carry on each axis
+#define MOUSE_STEP_MAX 127
+
+// Unity speed for MouseMotion's 8.8 fixed-point scale
+#define MOUSE_SCALE_ONE 256
+
+// Largest delta one frame may ask for, per axis; bounds how long a frame can take to play
+#define MOUSE_FRAME_MAX 32767
+
+// One relative mouse report's worth of motion
+struct MouseStep {
+    int8_t x;
+    int8_t y;
+    int8_t wheel;
+};
+
+/// @brief Turns relative mouse deltas of any size into HID mouse reports.
+/// @details Pointer deltas are scaled in 8.8 fixed point. Whatever fraction of a count a
+/// frame leaves over is carried into the next frame, so slow motion at a low speed still
+/// moves the pointer instead of rounding to nothing. A frame's whole counts are spread
+/// evenly over the fewest reports that keep every axis within +-127. The reports always
+/// add up to exactly the frame's counts, so large moves land where they were aimed.
+/// The wheel is split the same way but is never scaled. Deltas beyond MOUSE_FRAME_MAX
+/// are clamped.
+///
+/// Feed a frame with add() and drain it with next() before the next frame. Motion that
+/// was not drained is folded into the next frame rather than lost.
+class MouseMotion {
+public:
+    explicit MouseMotion(uint16_t scale = MOUSE_SCALE_ONE);
+
+    void setScale(uint16_t scale) { scale_ = scale; }
+    uint16_t scale() const { return scale_; }
+
+    void add(int32_t dx, int32_t dy, int32_t wheel);
+
+    // Next report for the current frame; false once it has all been sent
+    bool next(MouseStep* step);
+
+    // Forget carried fractions and untaken steps
+    void reset();
+
+private:
+    int64_t  fracX_;     // Scaled remainders below one count, 1/256 units
+    int64_t  fracY_;
+    int64_t  totalX_;    // Whole counts for the current frame
+    int64_t  totalY_;
+    int64_t  totalWheel_;
+    uint32_t steps_;     // Reports the current frame is split into
+    uint32_t step_;      // Reports taken so far
+    uint16_t scale_;
+};
@@ -0,0 +1,58 @@
+#include "PipelineStats.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdio.h>
+
+static const char* TAG = "PIPELINE";
+
+struct StageWindow {
+  uint32_t count;
+  uint64_t totalUs;
+  uint32_t maxUs;
+};
+
+static const char* STAGE_NAMES[STAGE_COUNT] = {
+  "ingest", "decode", "kbd.q", "kbd.out", "bulk.q", "bulk.out", "mouse.q", "mouse.out", "cc.q", "cc.out",
+  "crypto.q", "crypto.out", "kbd.q+paste", "mouse.q+paste"
+};
+
+static StageWindow stages[STAGE_COUNT];
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t pipelineNowUs()
+{
+  return (uint32_t)esp_timer_get_time();
+}
+
+void pipelineRecord(PipelineStage stage, uint32_t us)
+{
+  taskENTER_CRITICAL(&statsLock);
+  StageWindow& s = stages[stage];
+  s.count++;
+  s.totalUs += us;
+  if (us > s.maxUs) s.maxUs = us;
+  taskEXIT_CRITICAL(&statsLock);
+}
+
+void pipelineReport()
+{
+  StageWindow snapshot[STAGE_COUNT];
+
+  taskENTER_CRITICAL(&statsLock);
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    snapshot[i] = stages[i];
+    stages[i] = {};
+  }
+  taskEXIT_CRITICAL(&statsLock);
+
+  char line[384];
+  int pos = 0;
+  for (int i = 0; i < STAGE_COUNT && pos < (int)sizeof(line); i++) {
+    const StageWindow& s = snapshot[i];
+    if (s.count == 0) continue;
+    pos += snprintf(line + pos, sizeof(line) - pos, "%s %lu/%lu (n=%lu)  ", STAGE_NAMES[i],
+      (unsigned long)(s.totalUs / s.count), (unsigned long)s.maxUs, (unsigned long)s.count);
+  }
+  if (pos > 0) ESP_LOGI(TAG, "avg/max us: %s", line);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+// Per-stage latency counters for the BLE -> HID pipeline:
+//   ingest (BLE write -> PacketWorker picks it up), decode (decrypt + dispatch),
+//   then queue wait and output time for each HID interface worker. The keyboard stages
+//   are the interactive lane; bulk text has its own pair. AUTH handshakes run beside the
+//   pipeline on the crypto worker and report their queue wait and backend time.
+//   The +paste stages repeat the interactive keyboard and mouse queue waits taken while
+//   bulk text was queued or typing, to show what a concurrent paste costs live input.
+enum PipelineStage : uint8_t {
+    STAGE_INGEST,
+    STAGE_DECODE,
+    STAGE_KEYBOARD_WAIT,
+    STAGE_KEYBOARD_OUT,
+    STAGE_BULK_WAIT,
+    STAGE_BULK_OUT,
+    STAGE_MOUSE_WAIT,
+    STAGE_MOUSE_OUT,
+    STAGE_CONSUMER_WAIT,
+    STAGE_CONSUMER_OUT,
+    STAGE_CRYPTO_WAIT,
+    STAGE_CRYPTO_OUT,
+    STAGE_KEYBOARD_WAIT_PASTE,
+    STAGE_MOUSE_WAIT_PASTE,
+    STAGE_COUNT
+};
+
+// Record one sample; safe from any task on either core
+void pipelineRecord(PipelineStage stage, uint32_t us);
+
+// Log avg/max/count per stage for the window since the last report, then start a new
+// window. Quiet if nothing was recorded.
+void pipelineReport();
+
+// Low 32 bits of esp_timer, for stamping items as they cross a stage boundary
+uint32_t pipelineNowUs();
@@ -0,0 +1,341 @@
+#include <stdlib.h>
+#include "ReportCompiler.h"
+#include "KeyboardLayout.h"
+
+#define MOD_LEFT_CTRL   0x01
+#define MOD_LEFT_SHIFT  0x02
+#define MOD_LEFT_ALT    0x04    // Option on macOS
+
+#define USAGE_A         0x04
+#define USAGE_1         0x1e
+#define USAGE_0         0x27
+#define USAGE_KP_ADD    0x57
+#define USAGE_KP_1      0x59
+#define USAGE_KP_0      0x62
+
+// Non-ASCII character the active layout can type: a direct key, or a dead key and its base
+struct ComposedChar {
+    uint16_t    codepoint;
+    KeymapEntry deadKey;    // usage 0 = typed directly
+    KeymapEntry key;
+};
+
+#define COMPOSED_TABLE_MAX 128
+
+// Built on first use of a layout and kept until the layout changes. Only the keyboard
+// worker compiles text, so the cache needs no lock.
+static ComposedChar   composedTable[COMPOSED_TABLE_MAX];
+static size_t         composedCount = 0;
+static const uint8_t* composedLayout = nullptr;
+
+static int compareComposed(const void* a, const void* b)
+{
+    return (int)((const ComposedChar*)a)->codepoint - (int)((const ComposedChar*)b)->codepoint;
+}
+
+static void addComposed(uint16_t codepoint, KeymapEntry deadKey, KeymapEntry key)
+{
+    if (composedCount >= COMPOSED_TABLE_MAX) return;
+    for (size_t i = 0; i < composedCount; i++) {
+        if (composedTable[i].codepoint == codepoint) return;    // First (direct) key wins
+    }
+    composedTable[composedCount++] = {codepoint, deadKey, key};
+}
+
+static void buildComposedTable(const uint8_t* layout, const KeymapEntry* keymap)
+{
+    composedLayout = layout;
+    composedCount = 0;
+
+    const KeyboardLayoutExtras* extras = keyboardLayoutExtras(layout);
+    if (!extras) return;
+
+    for (size_t i = 0; i < extras->charCount; i++) {
+        addComposed(extras->chars[i].codepoint, KeymapEntry{0, 0}, keymapEntry(extras->chars[i].key));
+    }
+    for (size_t d = 0; d < extras->deadKeyCount; d++) {
+        const KeyboardLayoutDeadKey& dead = extras->deadKeys[d];
+        for (size_t i = 0; i < KeyboardCompositionCount; i++) {
+            const KeyboardComposition& c = KeyboardCompositions[i];
+            const KeymapEntry& base = keymap[(uint8_t)c.base];
+            if (c.accent != dead.accent || !base.usage) continue;
+            addComposed(c.codepoint, keymapEntry(dead.key), base);
+        }
+    }
+    qsort(composedTable, composedCount, sizeof(ComposedChar), compareComposed);
+}
+
+static const ComposedChar* findComposed(const uint8_t* layout, const KeymapEntry* keymap, uint32_t codepoint)
+{
+    if (codepoint > 0xffff) return nullptr;
+    if (layout != composedLayout) buildComposedTable(layout, keymap);
+
+    ComposedChar key = {(uint16_t)codepoint, {0, 0}, {0, 0}};
+    return (const ComposedChar*)bsearch(&key, composedTable, composedCount, sizeof(ComposedChar), compareComposed);
+}
+
+// Decode one UTF-8 sequence, advancing *pos. Malformed input is consumed a byte at a
+// time; a truncated sequence stops before the byte that broke it.
+static bool decodeUtf8(const char* text, size_t len, size_t* pos, uint32_t* codepoint)
+{
+    uint8_t b = (uint8_t)text[(*pos)++];
+    if (b < 0x80) {
+        *codepoint = b;
+        return true;
+    }
+
+    size_t extra;
+    uint32_t cp, min;
+    if ((b & 0xe0) == 0xc0)      { extra = 1; cp = b & 0x1f; min = 0x80; }
+    else if ((b & 0xf0) == 0xe0) { extra = 2; cp = b & 0x0f; min = 0x800; }
+    else if ((b & 0xf8) == 0xf0) { extra = 3; cp = b & 0x07; min = 0x10000; }
+    else return false;
+
+    for (size_t i = 0; i < extra; i++) {
+        if (*pos >= len || ((uint8_t)text[*pos] & 0xc0) != 0x80) return false;
+        cp = (cp << 6) | ((uint8_t)text[(*pos)++] & 0x3f);
+    }
+    if (cp < min || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) return false;
+
+    *codepoint = cp;
+    return true;
+}
+
+ReportCompiler::ReportCompiler(const uint8_t* layout, const KeymapEntry* keymap, UnicodeInput input)
+    : layout_(layout), keymap_(keymap), input_(input), text_(nullptr), len_(0), pos_(0), typed_(0), coalesce_(true), last_(true),
+      held_{0, 0}, pending_{0, 0}, hasPending_(false), holdModifiers_(false),
+      strokeCount_(0), strokePos_(0)
+{
+}
+
+void ReportCompiler::begin(const char* text, size_t len, bool coalesce)
+{
+    begin(coalesce);
+    feed(text, len, true);
+}
+
+void ReportCompiler::begin(bool coalesce)
+{
+    text_ = nullptr;
+    len_ = 0;
+    pos_ = 0;
+    typed_ = 0;
+    coalesce_ = coalesce;
+    last_ = false;
+    held_ = {0, 0};
+    hasPending_ = false;
+    holdModifiers_ = false;
+    strokeCount_ = 0;
+    strokePos_ = 0;
+}
+
+void ReportCompiler::feed(const char* text, size_t len, bool last)
+{
+    text_ = text;
+    len_ = len;
+    pos_ = 0;
+    last_ = last;
+}
+
+size_t ReportCompiler::completeUtf8(const char* text, size_t len)
+{
+    for (size_t back = 1; back <= 3 && back <= len; back++) {
+        uint8_t b = (uint8_t)text[len - back];
+        if ((b & 0xc0) == 0x80) continue;   // Continuation, keep looking for the lead byte
+        size_t need = b >= 0xf0 ? 4 : b >= 0xe0 ? 3 : b >= 0xc0 ? 2 : 1;
+        return need > back ? len - back : len;
+    }
+    return len;
+}
+
+bool ReportCompiler::lookup(uint8_t ch, KeyFrame* press) const
+{
+    if (ch >= KEYMAP_SIZE || ch == '\r') return false; // '\n' already types Enter
+
+    const KeymapEntry& entry = keymap_[ch];
+    if (!entry.usage) return false;
+
+    *press = KeyFrame{entry.modifiers, entry.usage};
+    return true;
+}
+
+void ReportCompiler::addStroke(uint8_t modifiers, uint8_t key)
+{
+    if (strokeCount_ < COMPILER_MAX_STROKES) {
+        strokes_[strokeCount_++] = {modifiers, key};
+    }
+}
+
+// Type the code point through the host's Unicode input method. Entry starts and ends
+// with every key up so the host sees one complete sequence per character.
+bool ReportCompiler::compileUnicodeEntry(uint32_t codepoint)
+{
+    static const char hex[] = "0123456789abcdef";
+    KeyFrame press;
+
+    switch (input_) {
+        case UNICODE_INPUT_LINUX: {
+            if (!lookup('u', &press)) return false;
+            addStroke(0, 0);
+            addStroke(MOD_LEFT_CTRL | MOD_LEFT_SHIFT, 0);
+            addStroke(MOD_LEFT_CTRL | MOD_LEFT_SHIFT, press.key);
+            addStroke(0, 0);
+
+            int shift = 20;
+            while (shift > 0 && !(codepoint >> shift)) shift -= 4;
+            for (; shift >= 0; shift -= 4) {
+                if (!lookup(hex[(codepoint >> shift) & 0xf], &press)) return false;
+                addStroke(press.modifiers, press.key);
+            }
+            if (!lookup(' ', &press)) return false;
+            addStroke(press.modifiers, press.key);
+            return true;
+        }
+
+        case UNICODE_INPUT_WINDOWS: {
+            if (codepoint > 0xffff) return false;
+            addStroke(0, 0);
+            addStroke(MOD_LEFT_ALT, 0);
+            if (codepoint <= 0xff) {
+                // Alt+0<decimal> picks from the ANSI code page, which is Latin-1 from 0xa0 up
+                uint8_t digits[4] = {0, (uint8_t)(codepoint / 100), (uint8_t)(codepoint / 10 % 10), (uint8_t)(codepoint % 10)};
+                for (uint8_t d : digits) {
+                    addStroke(MOD_LEFT_ALT, d ? (uint8_t)(USAGE_KP_1 + d - 1) : USAGE_KP_0);
+                }
+            } else {
+                addStroke(MOD_LEFT_ALT, USAGE_KP_ADD);
+                for (int shift = 12; shift >= 0; shift -= 4) {
+                    uint8_t d = (codepoint >> shift) & 0xf;
+                    if (d < 10) {
+                        addStroke(MOD_LEFT_ALT, d ? (uint8_t)(USAGE_KP_1 + d - 1) : USAGE_KP_0);
+                    } else {
+                        if (!lookup(hex[d], &press)) return false;
+                        addStroke(MOD_LEFT_ALT, press.key);
+                    }
+                }
+            }
+            addStroke(0, 0);
+            return true;
+        }
+
+        case UNICODE_INPUT_MACOS: {
+            // Unicode Hex Input is its own US-positioned layout and takes UTF-16 units
+            uint16_t units[2];
+            size_t count = 0;
+            if (codepoint > 0xffff) {
+                codepoint -= 0x10000;
+                units[count++] = 0xd800 | (codepoint >> 10);
+                units[count++] = 0xdc00 | (codepoint & 0x3ff);
+            } else {
+                units[count++] = codepoint;
+            }
+
+            addStroke(0, 0);
+            addStroke(MOD_LEFT_ALT, 0);
+            for (size_t u = 0; u < count; u++) {
+                for (int shift = 12; shift >= 0; shift -= 4) {
+                    uint8_t d = (units[u] >> shift) & 0xf;
+                    uint8_t usage = d >= 10 ? USAGE_A + d - 10 : d ? USAGE_1 + d - 1 : USAGE_0;
+                    addStroke(MOD_LEFT_ALT, usage);
+                }
+            }
+            addStroke(0, 0);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool ReportCompiler::compileChar(uint32_t codepoint)
+{
+    strokeCount_ = 0;
+    strokePos_ = 0;
+    holdModifiers_ = false;
+
+    KeyFrame press;
+    if (codepoint < 0x80 && lookup((uint8_t)codepoint, &press)) {
+        addStroke(press.modifiers, press.key);
+        return true;
+    }
+    if (codepoint < 0x20 || (codepoint >= 0x7f && codepoint < 0xa0)) return false;  // Controls
+
+    const ComposedChar* composed = findComposed(layout_, keymap_, codepoint);
+    if (composed) {
+        if (composed->deadKey.usage) {
+            addStroke(composed->deadKey.modifiers, composed->deadKey.usage);
+        }
+        addStroke(composed->key.modifiers, composed->key.usage);
+        return true;
+    }
+
+    holdModifiers_ = true;
+    if (compileUnicodeEntry(codepoint)) return true;
+    strokeCount_ = 0;
+    return false;
+}
+
+// Compile the next typeable character into strokes_; false at the end of the text
+bool ReportCompiler::loadChar()
+{
+    while (pos_ < len_) {
+        uint32_t codepoint;
+        if (!decodeUtf8(text_, len_, &pos_, &codepoint)) continue;
+        if (compileChar(codepoint)) {
+            typed_++;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReportCompiler::next(KeyFrame* frame)
+{
+    if (hasPending_) {
+        hasPending_ = false;
+        *frame = held_ = pending_;
+        return true;
+    }
+
+    while (strokePos_ < strokeCount_ || loadChar()) {
+        KeyFrame press = strokes_[strokePos_++];
+
+        if (press.key == 0) {
+            // Bare modifiers, or all-up around Unicode entry
+            if (held_.key == 0 && held_.modifiers == press.modifiers) continue;
+            *frame = held_ = press;
+            return true;
+        }
+
+        bool release = held_.key != 0 &&
+            (!coalesce_ || press.key == held_.key || press.modifiers != held_.modifiers);
+        if (release) {
+            // Lift the held key, switching to the next character's modifiers in the same
+            // report. Unicode entry keeps its modifier down between digits even uncoalesced.
+            bool keepModifiers = coalesce_ || (holdModifiers_ && press.modifiers == held_.modifiers);
+            pending_ = press;
+            hasPending_ = true;
+            *frame = held_ = KeyFrame{keepModifiers ? press.modifiers : (uint8_t)0, 0};
+            return true;
+        }
+
+        *frame = held_ = press;
+        return true;
+    }
+
+    if (!last_) return false;   // Wait for the next piece with the keys still down
+    if (held_.key != 0 || held_.modifiers != 0) {
+        *frame = held_ = KeyFrame{0, 0};
+        return true;
+    }
+    return false;
+}
+
+// All-up report for an interruption; false if nothing is down
+bool ReportCompiler::release(KeyFrame* frame)
+{
+    if (held_.key == 0 && held_.modifiers == 0) return false;
+    *frame = held_ = KeyFrame{0, 0};
+    return true;
+}
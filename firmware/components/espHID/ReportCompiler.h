@@ -0,0 +1,90 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "KeyboardKeymap.h"
+
+// One boot-keyboard report as the compiler sees it: modifiers plus at most one key
+struct KeyFrame {
+    uint8_t modifiers;
+    uint8_t key;        // HID usage, 0 = no key down
+};
+
+// How the host accepts characters the layout has no key for
+enum UnicodeInput : uint8_t {
+    UNICODE_INPUT_NONE,     // Skip them
+    UNICODE_INPUT_LINUX,    // Ctrl+Shift+U, hex, Space (IBus, GTK)
+    UNICODE_INPUT_WINDOWS,  // Alt + numpad 0<decimal> for Latin-1, Alt + numpad '+' hex above (EnableHexNumpad)
+    UNICODE_INPUT_MACOS,    // Option + hex with the Unicode Hex Input source selected
+};
+
+// Longest key sequence one character can compile to (host Unicode entry)
+#define COMPILER_MAX_STROKES 12
+
+/// @brief Compiles UTF-8 text into a minimal keyboard report sequence for a layout.
+/// @details Typed naively, every character is a press report and a release report. When
+/// consecutive characters use different keys and the same modifiers, the report pressing
+/// the next key also lifts the previous one, so "ab" takes three reports (a down, b down,
+/// all up) rather than four press/release pairs, or the six the old press, release and
+/// releaseAll typing sent. A release is inserted only when a key repeats or the
+/// modifiers change, and every string ends all-up. With coalescing off it emits plain
+/// press/release pairs for hosts that must see each key lifted (BIOS, KVM switches).
+///
+/// ASCII comes straight from the keyboard's expanded keymap. Characters outside ASCII
+/// resolve through the layout's extras: a direct key, or a dead key followed by its base
+/// letter. Those sequences are compiled once per layout into a sorted table. Anything
+/// else is typed with the host's Unicode entry method, if set.
+///
+/// Text can arrive in pieces: feed() each piece and drain next() before the next one.
+/// Keys stay down across pieces and only the last piece ends the string all-up.
+class ReportCompiler {
+public:
+    ReportCompiler(const uint8_t* layout, const KeymapEntry* keymap, UnicodeInput input = UNICODE_INPUT_NONE);
+
+    void begin(const char* text, size_t len, bool coalesce);
+
+    // Start a string whose text is supplied with feed()
+    void begin(bool coalesce);
+    void feed(const char* text, size_t len, bool last);
+
+    // Next report to send; false once the text fed so far is used up, and for the
+    // last piece once all keys are up
+    bool next(KeyFrame* frame);
+
+    // Length of the prefix of text that holds only whole UTF-8 sequences
+    static size_t completeUtf8(const char* text, size_t len);
+
+    // Between characters, where other input may be typed: lift the keys with release()
+    // and the string carries on from a clean report
+    bool atBoundary() const { return !hasPending_ && strokePos_ >= strokeCount_; }
+    bool release(KeyFrame* frame);
+
+    // Characters emitted so far; unmapped characters are skipped
+    size_t typed() const { return typed_; }
+
+private:
+    bool lookup(uint8_t ch, KeyFrame* press) const;
+    bool loadChar();
+    bool compileChar(uint32_t codepoint);
+    bool compileUnicodeEntry(uint32_t codepoint);
+    void addStroke(uint8_t modifiers, uint8_t key);
+
+    const uint8_t* layout_;
+    const KeymapEntry* keymap_;
+    UnicodeInput   input_;
+    const char*    text_;
+    size_t         len_;
+    size_t         pos_;
+    size_t         typed_;
+    bool           coalesce_;
+    bool           last_;           // Text fed so far ends the string
+    KeyFrame       held_;           // Last report emitted
+    KeyFrame       pending_;        // Press waiting behind an inserted release
+    bool           hasPending_;
+    bool           holdModifiers_;  // Current character is Unicode entry
+
+    // Presses for the current character. A stroke with no key is a bare modifier
+    // report; {0, 0} lifts everything before Unicode entry starts or ends.
+    KeyFrame       strokes_[COMPILER_MAX_STROKES];
+    uint8_t        strokeCount_;
+    uint8_t        strokePos_;
+};
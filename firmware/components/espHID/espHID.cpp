@@ -1,5 +1,13 @@
 #include <espHID.h>
 #include "esp_log.h"
+#include "sdkconfig.h"
+#include <Preferences.h>
+#include "freertos/stream_buffer.h"
+#include "esp_heap_caps.h"
+#include <algorithm>
+#include <atomic>
+#include "PipelineStats.h"
+#include "MouseMotion.h"
 
 #include "tinyusb.h"
 #include "tudconfig.cpp"
@@ -8,12 +16,7 @@
 #include "IDFHIDMouse.h"
 #include "IDFHIDConsumerControl.h"
 #include "IDFHIDSystemControl.h"
-
-// TODO: tud_hid_report_complete_cb is commented out below. Without it, SendReport
-// holds the semaphore indefinitely if the host never ACKs — the lock() loop in
-// IDFHID compensates by spinning on tud_task(), but wiring up the callback and
-// calling unlock() there would be cleaner.
-
+#include "IDFHIDNkroKeyboard.h"
 
 // Needed to enable CDC if defined
 #if ARDUINO_USB_CDC_ON_BOOT
@@ -21,15 +24,82 @@
     USBCDC USBSerial; 
 #endif
 
-// RTOS Queue for HID reports
-#define MAX_QUEUE_STRING_LEN 256
+enum KeyItemType : uint8_t {
+  KEY_TEXT,     // UTF-8 text, typed as it is read
+  KEY_CODES,    // Encoded keys pressed together
+  KEY_JOB_END,  // Marker closing a multi-packet transfer, optionally with an int64_t request time
+  KEY_LAYOUT    // Layout ID byte, followed by the table for CUSTOM
+};
+
+// Keyboard items of one lane share a queue so text and keycodes stay in order. Their
+// payloads go through the lane's stream in the same order, so an item costs its own
+// bytes and nothing more, and text has no length limit beyond the stream size.
+typedef struct {
+  KeyItemType type;
+  toothpaste_TypingProfile profile;
+  uint32_t length;    // Payload bytes in the lane's stream
+  uint32_t queuedUs;
+} QueueKeyItem;
+
+// Keyboard lanes. The worker always takes interactive items first and breaks into bulk
+// text between characters to type them.
+typedef struct {
+  const char* name;
+  QueueHandle_t queue;
+  StreamBufferHandle_t stream;    // Created by startHidTasks()
+  size_t streamSize;
+  PipelineStage waitStage;
+  PipelineStage outStage;
+  size_t jobChars;                // Typed since the last KEY_JOB_END
+  int64_t jobStart;
+} KeyLaneState;
+
+// Relative and absolute moves share the mouse queue so they play in the order sent
+typedef struct {
+  bool absolute;
+  union {
+    toothpaste_MousePacket packet;
+    toothpaste_PointerPacket pointer;
+  };
+  uint32_t queuedUs;
+} QueueMouseItem;
+
+typedef struct {
+  toothpaste_ConsumerControlPacket packet;
+  uint32_t queuedUs;
+} QueueConsumerItem;
+
+// Stage queues between PacketWorker and the per-interface HID workers
+static KeyLaneState keyLanes[KEY_LANE_COUNT] = {
+  {"interactive", xQueueCreate(KEYBOARD_QUEUE_DEPTH, sizeof(QueueKeyItem)), nullptr, HID_INTERACTIVE_STREAM_SIZE,
+   STAGE_KEYBOARD_WAIT, STAGE_KEYBOARD_OUT, 0, 0},
+  {"bulk", xQueueCreate(KEYBOARD_QUEUE_DEPTH, sizeof(QueueKeyItem)), nullptr, HID_STREAM_SIZE,
+   STAGE_BULK_WAIT, STAGE_BULK_OUT, 0, 0},
+};
+SemaphoreHandle_t keyboardProducerLock = xSemaphoreCreateMutex();   // Keeps stream and queue order in step
+std::atomic<bool> bulkCancelRequested{false};
+static std::atomic<bool> bulkTyping{false};   // Keyboard worker is inside a bulk item
+QueueHandle_t mouseQueue = xQueueCreate(MOUSE_QUEUE_DEPTH, sizeof(QueueMouseItem));
+QueueHandle_t consumerQueue = xQueueCreate(CONSUMER_QUEUE_DEPTH, sizeof(QueueConsumerItem));
 
+// Relative input that found the mouse queue full. It logically sits behind everything
+// queued, so the mouse worker plays it once the queue has drained, and later relative
+// packets join it until then. Each segment is motion followed by the button change that
+// closed it, so parked presses and releases keep their order with the motion around them.
 typedef struct {
-  char data[MAX_QUEUE_STRING_LEN];
-  uint8_t length;
-} QueueStringItem;
+  int64_t x;
+  int64_t y;
+  int64_t wheel;
+  int32_t lClick;   // Both 0 while the segment is still open to motion
+  int32_t rClick;
+} MouseOverflowSegment;
 
-QueueHandle_t reportQueue = xQueueCreate(18, sizeof(QueueStringItem)); // Queue to manage HID inputs
+typedef struct {
+  MouseOverflowSegment segments[MOUSE_OVERFLOW_SEGMENTS];
+  uint8_t count;    // Only the last segment can be open
+} MouseOverflow;
+static MouseOverflow mouseOverflow = {};
+static portMUX_TYPE mouseOverflowLock = portMUX_INITIALIZER_UNLOCKED;
 
 // RTOS Task flags
 bool mouseJiggleEnabled = false;
@@ -38,57 +108,478 @@ bool keyboardStarted = false;
 // Task handle for jiggle task (NULL when not running)
 TaskHandle_t jiggleTaskHandle = nullptr;
 TaskHandle_t keyboardTaskHandle = nullptr;
+TaskHandle_t mouseTaskHandle = nullptr;
+TaskHandle_t consumerTaskHandle = nullptr;
 
 // HID Instances
 IDFHIDKeyboard keyboard0(0); // Boot Keyboard
 IDFHIDMouse mouse(1); // Boot Mouse
 IDFHIDConsumerControl control(2); // Consumer Control
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+IDFHIDNkroKeyboard nkroKeyboard(HID_ITF_NKRO_KEYBOARD); // Report-protocol bitmap keyboard
+#endif
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+USBHIDAbsoluteMouse absMouse(HID_ITF_ABS_MOUSE); // Screen-position pointer
+#endif
 
 void hidSetup()
 {
   tudsetup();
-  // begin() creates the shared FreeRTOS semaphore used by all HID interfaces.
-  // mouse and control share the same semaphore and don't need their own begin() calls,
-  // but if they are ever moved to independent semaphores, call begin() on each here.
-  keyboard0.begin();
-  startKeyboardTask();
+  // begin() creates each interface's transmit FIFO; reports sent before it are dropped
+  keyboard0.begin(loadKeyboardLayout());
+  mouse.begin();
+  control.begin();
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+  nkroKeyboard.begin();
+#endif
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+  absMouse.begin();
+#endif
+  startHidTasks();
 }
 
-// Send a string with a delay between each character (crude implementation of alternative polling rates since ESPHID doesn't expose this)
-size_t sendStringSlow(const char *str, int delayms) {
-  size_t sentCount = 0;
+#if defined(CONFIG_TOOTHPASTE_TYPING_DEFAULT_FULL_SPEED)
+#define TYPING_BUILD_DEFAULT toothpaste_TypingProfile_TYPING_FULL_SPEED
+#elif defined(CONFIG_TOOTHPASTE_TYPING_DEFAULT_CONSERVATIVE)
+#define TYPING_BUILD_DEFAULT toothpaste_TypingProfile_TYPING_CONSERVATIVE
+#else
+#define TYPING_BUILD_DEFAULT toothpaste_TypingProfile_TYPING_STANDARD
+#endif
 
-  for (size_t i = 0; str[i] != '\0'; i++) {
-    char ch = str[i];
+#if defined(CONFIG_TOOTHPASTE_UNICODE_INPUT_LINUX)
+#define UNICODE_INPUT_BUILD_DEFAULT UNICODE_INPUT_LINUX
+#elif defined(CONFIG_TOOTHPASTE_UNICODE_INPUT_WINDOWS)
+#define UNICODE_INPUT_BUILD_DEFAULT UNICODE_INPUT_WINDOWS
+#elif defined(CONFIG_TOOTHPASTE_UNICODE_INPUT_MACOS)
+#define UNICODE_INPUT_BUILD_DEFAULT UNICODE_INPUT_MACOS
+#else
+#define UNICODE_INPUT_BUILD_DEFAULT UNICODE_INPUT_NONE
+#endif
 
-    keyboard0.print(ch);  // Send single character
-    //keyboard1.print(ch);  // Send single character
+static volatile UnicodeInput activeUnicodeInput = UNICODE_INPUT_BUILD_DEFAULT;
 
-    vTaskDelay(pdMS_TO_TICKS(delayms)); // Delay between characters
-    sentCount++;
-    keyboard0.releaseAll(); // Release all keys to avoid sticky keys
+struct TypingRate {
+  uint8_t holdMs;
+  uint8_t gapMs;
+  bool coalesce;    // Let the next key's press lift the previous key (see ReportCompiler)
+};
+
+static TypingRate typingRate(toothpaste_TypingProfile profile)
+{
+  switch (profile) {
+    case toothpaste_TypingProfile_TYPING_FULL_SPEED:   return {0, 0, true};
+    case toothpaste_TypingProfile_TYPING_CONSERVATIVE: return {TYPING_CONSERVATIVE_HOLD_MS, TYPING_CONSERVATIVE_GAP_MS, false};
+    default:                                           return {TYPING_STANDARD_HOLD_MS, TYPING_STANDARD_GAP_MS, true};
   }
+}
 
-  return sentCount;
+toothpaste_TypingProfile resolveTypingProfile(toothpaste_TypingProfile requested, bool slowMode)
+{
+  if (requested > toothpaste_TypingProfile_TYPING_DEFAULT && requested <= _toothpaste_TypingProfile_MAX) return requested;
+  return slowMode ? toothpaste_TypingProfile_TYPING_CONSERVATIVE : TYPING_BUILD_DEFAULT;
+}
+
+const char* typingProfileName(toothpaste_TypingProfile profile)
+{
+  switch (profile) {
+    case toothpaste_TypingProfile_TYPING_FULL_SPEED:   return "full";
+    case toothpaste_TypingProfile_TYPING_STANDARD:     return "standard";
+    case toothpaste_TypingProfile_TYPING_CONSERVATIVE: return "conservative";
+    default:                                           return "default";
+  }
+}
+
+void setUnicodeInput(UnicodeInput input)
+{
+  activeUnicodeInput = input;
+}
+
+UnicodeInput unicodeInput()
+{
+  return activeUnicodeInput;
+}
+
+// Let the host read everything queued so far, then hold for `ms` more frames.
+// Zero leaves pacing to the report FIFO.
+static void paceKeyboard(IDFHID& itf, uint32_t ms)
+{
+  if (ms == 0) return;
+  itf.waitSent();
+  vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+static void sendFrame(const KeyFrame& frame, uint32_t paceMs)
+{
+  KeyReport report = {};
+  report.modifiers = frame.modifiers;
+  report.keys[0] = frame.key;
+  keyboard0.sendReport(&report);
+  paceKeyboard(keyboard0, paceMs);
+}
+
+static bool interactivePending();
+static void typeInteractive();
+
+// Send the compiler's reports at the profile's pace: a key is held for holdMs and the
+// gap only applies where a release report was needed. Bulk text lets waiting
+// interactive input in between characters, and stops early (returning false) when
+// cancelled.
+static bool sendFrames(ReportCompiler& compiler, const TypingRate& rate, KeyLane lane)
+{
+  KeyFrame frame;
+  while (true) {
+    if (lane == LANE_BULK && compiler.atBoundary()) {
+      if (bulkCancelRequested) return false;
+      if (interactivePending()) {
+        if (compiler.release(&frame)) sendFrame(frame, rate.gapMs);
+        typeInteractive();
+      }
+    }
+    if (!compiler.next(&frame)) return true;
+    sendFrame(frame, frame.key ? rate.holdMs : rate.gapMs);
+  }
+}
+
+// Type a UTF-8 string at the profile's pace, blocking until it is sent
+size_t typeString(const char *str, size_t len, toothpaste_TypingProfile profile) {
+  TypingRate rate = typingRate(profile);
+  ReportCompiler compiler(keyboard0.layout(), keyboard0.keymap(), activeUnicodeInput);
+  compiler.begin(str, len, rate.coalesce);
+  sendFrames(compiler, rate, LANE_INTERACTIVE);
+  return compiler.typed();
+}
+
+// Append one item's payload to the lane's stream and queue the item, or neither. Waits
+// up to `wait` for the keyboard worker to make room.
+static bool queueKeyItem(KeyLane lane, KeyItemType type, toothpaste_TypingProfile profile, const void* payload,
+                         size_t len, TickType_t wait)
+{
+  KeyLaneState& l = keyLanes[lane];
+  if (l.stream == nullptr) return false;
+
+  TickType_t start = xTaskGetTickCount();
+  while (true) {
+    xSemaphoreTake(keyboardProducerLock, portMAX_DELAY);
+    bool fits = uxQueueSpacesAvailable(l.queue) > 0 && xStreamBufferSpacesAvailable(l.stream) >= len;
+    if (fits) {
+      if (len > 0) xStreamBufferSend(l.stream, payload, len, 0);
+      QueueKeyItem item = {type, profile, (uint32_t)len, pipelineNowUs()};
+      xQueueSend(l.queue, &item, 0);
+    }
+    xSemaphoreGive(keyboardProducerLock);
+
+    if (fits) {
+      if (keyboardTaskHandle != nullptr) xTaskNotifyGive(keyboardTaskHandle);
+      return true;
+    }
+    if (xTaskGetTickCount() - start >= wait) return false;
+    vTaskDelay(1);
+  }
 }
 
 // Queue a string to be sent via HID
 void sendString(const char *str, bool slowMode)
 {
-  QueueStringItem item;
-  strncpy(item.data, str, MAX_QUEUE_STRING_LEN - 1);
-  item.data[MAX_QUEUE_STRING_LEN - 1] = '\0';
-  xQueueSend(reportQueue, &item, 0);
+  sendString(str, strlen(str), slowMode);
+}
+
+void sendString(const char *str, size_t stringLen, bool slowMode)
+{
+  sendString(str, stringLen, resolveTypingProfile(toothpaste_TypingProfile_TYPING_DEFAULT, slowMode));
+}
+
+// Queue a string with specified length. Text longer than a quarter of the lane's stream
+// is split on UTF-8 boundaries; the keyboard worker types consecutive pieces as one string.
+void sendString(const char *str, size_t stringLen, toothpaste_TypingProfile profile, KeyLane lane)
+{
+  size_t itemMax = keyLanes[lane].streamSize / 4;
+  while (stringLen > 0) {
+    size_t itemLen = stringLen;
+    if (itemLen > itemMax) {
+      itemLen = ReportCompiler::completeUtf8(str, itemMax);
+      if (itemLen == 0) itemLen = itemMax;
+    }
+    if (!queueKeyItem(lane, KEY_TEXT, profile, str, itemLen, 0)) {
+      ESP_LOGW(TAG, "HID %s stream full, dropping %u bytes of text", keyLanes[lane].name, (unsigned)stringLen);
+      return;
+    }
+    str += itemLen;
+    stringLen -= itemLen;
+  }
+}
+
+// Close the current multi-packet transfer; the keyboard task reports it once typed out. A
+// non-zero requestedUs (esp_timer time) is logged as the time from request to typed.
+void endStringJob(KeyLane lane, int64_t requestedUs)
+{
+  if (!queueKeyItem(lane, KEY_JOB_END, toothpaste_TypingProfile_TYPING_DEFAULT, &requestedUs,
+                    requestedUs != 0 ? sizeof(requestedUs) : 0, pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS))) {
+    ESP_LOGW(TAG, "HID queue full, job end not reported");
+  }
+}
+
+// Queue a chord behind any text already waiting in the same keyboard lane
+void queueKeycode(const uint8_t* keys, size_t count, toothpaste_TypingProfile profile, KeyLane lane)
+{
+  if (count > HID_KEYCODE_MAX) count = HID_KEYCODE_MAX;
+  if (!queueKeyItem(lane, KEY_CODES, profile, keys, count, 0)) {
+    ESP_LOGW(TAG, "HID queue full, dropping keycode");
+  }
+}
+
+// ##################### Keyboard Layouts #################### //
+
+static uint8_t customLayout[KEYMAP_SIZE];  // Client-uploaded table, only touched by the keyboard worker
+
+static const uint8_t* builtinLayout(toothpaste_KeyboardLayoutPacket_LayoutID id)
+{
+  switch (id) {
+    case toothpaste_KeyboardLayoutPacket_LayoutID_DE_DE: return KeyboardLayout_de_DE;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_ES_ES: return KeyboardLayout_es_ES;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_FR_FR: return KeyboardLayout_fr_FR;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_IT_IT: return KeyboardLayout_it_IT;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_PT_PT: return KeyboardLayout_pt_PT;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_SV_SE: return KeyboardLayout_sv_SE;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_DA_DK: return KeyboardLayout_da_DK;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_HU_HU: return KeyboardLayout_hu_HU;
+    case toothpaste_KeyboardLayoutPacket_LayoutID_PT_BR: return KeyboardLayout_pt_BR;
+    default:                                             return KeyboardLayout_en_US;
+  }
+}
+
+// Copy an uploaded table into customLayout. Control characters keep the en_US keys so
+// Enter, Tab and Backspace work whatever the client sent.
+static void installCustomLayout(const uint8_t* table)
+{
+  memcpy(customLayout, KeyboardLayout_en_US, ' ');
+  memcpy(customLayout + ' ', table + ' ', KEYMAP_SIZE - ' ');
 }
 
-// Queue a string with specified length
-void sendString(const char *str, uint8_t stringLen, bool slowMode)
+// Layout saved by the last KeyboardLayoutPacket, en_US if none
+const uint8_t* loadKeyboardLayout()
 {
-  QueueStringItem item;
-  size_t copyLen = stringLen;
-  memcpy(item.data, str, copyLen);
-  item.data[copyLen] = '\0';
-  xQueueSend(reportQueue, &item, 0);
+  Preferences prefs;
+  prefs.begin("keyboard", true);
+  auto id = (toothpaste_KeyboardLayoutPacket_LayoutID)prefs.getUChar("layout", toothpaste_KeyboardLayoutPacket_LayoutID_EN_US);
+  const uint8_t* layout = builtinLayout(id);
+  if (id == toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM) {
+    uint8_t table[KEYMAP_SIZE];
+    if (prefs.getBytes("custom", table, sizeof(table)) == sizeof(table)) {
+      installCustomLayout(table);
+      layout = customLayout;
+    }
+  }
+  prefs.end();
+
+  ESP_LOGI(TAG, "Keyboard layout %d", (int)id);
+  return layout;
+}
+
+// Persist a layout choice and switch to it once the text already queued has been typed
+bool queueKeyboardLayout(toothpaste_KeyboardLayoutPacket_LayoutID id, const uint8_t* customTable, size_t customLen,
+                         KeyLane lane)
+{
+  if (id > _toothpaste_KeyboardLayoutPacket_LayoutID_MAX) {
+    ESP_LOGW(TAG, "Unknown keyboard layout %d", (int)id);
+    return false;
+  }
+  if (id == toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM && (customTable == nullptr || customLen != KEYMAP_SIZE)) {
+    ESP_LOGW(TAG, "Custom layout needs a %u byte table, got %u", (unsigned)KEYMAP_SIZE, (unsigned)customLen);
+    return false;
+  }
+
+  uint8_t payload[1 + KEYMAP_SIZE];
+  size_t payloadLen = 1;
+  payload[0] = (uint8_t)id;
+  if (id == toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM) {
+    memcpy(payload + 1, customTable, KEYMAP_SIZE);
+    payloadLen += KEYMAP_SIZE;
+  }
+  if (!queueKeyItem(lane, KEY_LAYOUT, toothpaste_TypingProfile_TYPING_DEFAULT, payload, payloadLen,
+                    pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS))) {
+    ESP_LOGW(TAG, "HID queue full, layout change dropped");
+    return false;
+  }
+
+  Preferences prefs;
+  prefs.begin("keyboard", false);
+  prefs.putUChar("layout", (uint8_t)id);
+  if (id == toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM) {
+    prefs.putBytes("custom", customTable, KEYMAP_SIZE);
+  }
+  prefs.end();
+  return true;
+}
+
+// Keyboard worker side of queueKeyboardLayout(): rebuild keyboard0's keymap
+static void applyKeyboardLayout(const uint8_t* payload, size_t len)
+{
+  auto id = (toothpaste_KeyboardLayoutPacket_LayoutID)payload[0];
+  const uint8_t* layout = builtinLayout(id);
+  if (id == toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM) {
+    if (len != 1 + KEYMAP_SIZE) return;
+    installCustomLayout(payload + 1);
+    layout = customLayout;
+  }
+  keyboard0.setLayout(layout);
+  ESP_LOGI(TAG, "Keyboard layout now %d", (int)id);
+}
+
+static bool segmentClosed(const MouseOverflowSegment& segment)
+{
+  return segment.lClick != 0 || segment.rClick != 0;
+}
+
+static bool mouseOverflowPending()
+{
+  portENTER_CRITICAL(&mouseOverflowLock);
+  bool pending = mouseOverflow.count > 0;
+  portEXIT_CRITICAL(&mouseOverflowLock);
+  return pending;
+}
+
+// Add a packet to the overflow: its motion joins the open segment and its button change, if
+// any, closes it. Without start it only joins overflow that is already pending; returns
+// whether it was merged.
+static bool mergeMouseOverflow(const toothpaste_MousePacket& packet, bool start)
+{
+  pb_size_t frames = packet.num_frames < packet.frames_count ? packet.num_frames : packet.frames_count;
+  bool buttons = packet.l_click != 0 || packet.r_click != 0;
+  bool droppedButtons = false;
+
+  portENTER_CRITICAL(&mouseOverflowLock);
+  bool merge = start || mouseOverflow.count > 0;
+  if (merge) {
+    // Segments only close while one is spare, so there is always room to open the next
+    if (mouseOverflow.count == 0 || segmentClosed(mouseOverflow.segments[mouseOverflow.count - 1])) {
+      mouseOverflow.segments[mouseOverflow.count++] = {};
+    }
+    MouseOverflowSegment& open = mouseOverflow.segments[mouseOverflow.count - 1];
+    for (pb_size_t i = 0; i < frames; i++) {
+      open.x += packet.frames[i].x;
+      open.y += packet.frames[i].y;
+    }
+    open.wheel += packet.wheel;
+    if (buttons && mouseOverflow.count < MOUSE_OVERFLOW_SEGMENTS) {
+      open.lClick = packet.l_click;
+      open.rClick = packet.r_click;
+    }
+    else if (buttons) {
+      droppedButtons = true;
+    }
+  }
+  portEXIT_CRITICAL(&mouseOverflowLock);
+
+  if (droppedButtons) ESP_LOGW(TAG, "Mouse overflow full, button change dropped");
+  return merge;
+}
+
+// Take the overflow, if any, leaving none pending
+static bool takeMouseOverflow(MouseOverflow* out)
+{
+  portENTER_CRITICAL(&mouseOverflowLock);
+  *out = mouseOverflow;
+  mouseOverflow = {};
+  portEXIT_CRITICAL(&mouseOverflowLock);
+  return out->count > 0;
+}
+
+// Split off the next frame-sized piece of a segment's motion; false once none is left
+static bool nextOverflowFrame(MouseOverflowSegment* segment, int32_t* x, int32_t* y, int32_t* wheel)
+{
+  if (segment->x == 0 && segment->y == 0 && segment->wheel == 0) return false;
+  *x = (int32_t)std::clamp<int64_t>(segment->x, -MOUSE_FRAME_MAX, MOUSE_FRAME_MAX);
+  *y = (int32_t)std::clamp<int64_t>(segment->y, -MOUSE_FRAME_MAX, MOUSE_FRAME_MAX);
+  *wheel = (int32_t)std::clamp<int64_t>(segment->wheel, -MOUSE_FRAME_MAX, MOUSE_FRAME_MAX);
+  segment->x -= *x;
+  segment->y -= *y;
+  segment->wheel -= *wheel;
+  return true;
+}
+
+// Queue a mouse packet for the mouse worker. Waits briefly first; that back-pressure stalls
+// PacketWorker, which the flow-control credits then reflect. A packet that still finds the
+// queue full goes to the overflow, motion merged and button changes parked in order, and
+// the mouse worker plays it once it has drained the queue. PacketWorker never waits longer
+// than HID_ENQUEUE_WAIT_MS here.
+void queueMouse(const toothpaste_MousePacket& packet)
+{
+  // Packets join pending overflow directly so they cannot overtake it
+  if (mergeMouseOverflow(packet, false)) return;
+
+  QueueMouseItem item;
+  item.absolute = false;
+  item.packet = packet;
+  item.queuedUs = pipelineNowUs();
+  if (xQueueSend(mouseQueue, &item, pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS)) == pdTRUE) return;
+
+  mergeMouseOverflow(packet, true);
+  ESP_LOGD(TAG, "Mouse queue full, packet moved to overflow");
+}
+
+// Queue an absolute pointer position behind any relative input already waiting. It may not
+// overtake the overflow, so it waits up to HID_ENQUEUE_WAIT_MS for the worker to play that.
+void queuePointer(const toothpaste_PointerPacket& packet)
+{
+  TickType_t start = xTaskGetTickCount();
+  while (mouseOverflowPending()) {
+    if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS)) {
+      ESP_LOGW(TAG, "Mouse overflow pending, dropping pointer report");
+      return;
+    }
+    vTaskDelay(1);
+  }
+
+  QueueMouseItem item;
+  item.absolute = true;
+  item.pointer = packet;
+  item.queuedUs = pipelineNowUs();
+  if (xQueueSend(mouseQueue, &item, pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS)) != pdTRUE) {
+    ESP_LOGW(TAG, "Mouse queue full, dropping pointer report");
+  }
+}
+
+// Drop mouse movement that has not reached the mouse worker yet
+void cancelQueuedMouse()
+{
+  MouseOverflow overflow;
+  takeMouseOverflow(&overflow);
+  xQueueReset(mouseQueue);
+}
+
+void queueConsumerControl(const toothpaste_ConsumerControlPacket& packet)
+{
+  QueueConsumerItem item;
+  item.packet = packet;
+  item.queuedUs = pipelineNowUs();
+  if (xQueueSend(consumerQueue, &item, pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS)) != pdTRUE) {
+    ESP_LOGW(TAG, "Consumer control queue full, dropping press");
+  }
+}
+
+// Writes of up to bytesPerWrite one keyboard lane can still take; feeds the BLE
+// flow-control credits, which are kept per lane so a full bulk lane never blocks live input
+size_t hidQueueSpaces(KeyLane lane, size_t bytesPerWrite)
+{
+  const KeyLaneState& l = keyLanes[lane];
+  if (bytesPerWrite == 0 || l.stream == nullptr) return 0;
+  size_t items = uxQueueSpacesAvailable(l.queue);
+  size_t bytes = xStreamBufferSpacesAvailable(l.stream) / bytesPerWrite;
+  return items < bytes ? items : bytes;
+}
+
+// Bulk text queued or being typed, for the latency stats taken under a concurrent paste
+static bool bulkBusy()
+{
+  return bulkTyping.load(std::memory_order_relaxed) || uxQueueMessagesWaiting(keyLanes[LANE_BULK].queue) > 0;
+}
+
+// Drop all queued bulk text. Takes effect at the next character of a paste in progress;
+// interactive input is kept.
+void cancelBulkKeyboard()
+{
+  bulkCancelRequested = true;
+  if (keyboardTaskHandle != nullptr) xTaskNotifyGive(keyboardTaskHandle);
 }
 
 // Print a toothpaste_KeyboardPacket's message
@@ -113,13 +604,63 @@ void stringTest(){
 //     //keyboard1.releaseAll();
 // }
 
-void sendKeycode(uint8_t* encodedKeys, bool slowMode, bool autoRelease) {
-  // autoRelease parameter is currently unused; releaseAll() always fires.
-  keyboard0.sendKeycode(encodedKeys, 6);
-  if (slowMode) {
-    vTaskDelay(pdMS_TO_TICKS(SLOWMODE_DELAY_MS));
+// The NKRO interface is only read in report protocol; once a host switches the boot
+// keyboard to boot protocol (BIOS, KVM) chords fall back to 6-key boot reports.
+static bool nkroActive()
+{
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+  return tud_mounted() && tud_hid_n_get_protocol(keyboard0.interface()) == HID_PROTOCOL_REPORT;
+#else
+  return false;
+#endif
+}
+
+// Press all the keys together and release them, paced like typed text
+void sendKeycode(uint8_t* encodedKeys, size_t count, toothpaste_TypingProfile profile) {
+  TypingRate rate = typingRate(profile);
+
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+  if (nkroActive()) {
+    uint8_t usages[HID_KEYCODE_MAX];
+    uint8_t modifiers = 0;
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (keyboard0.decodeKey(encodedKeys[i], &usages[n], &modifiers) && usages[n] != 0) n++;
+    }
+    // The two interfaces have separate FIFOs: let boot-keyboard text already queued reach
+    // the host before the chord, and the chord's release leave before anything that follows
+    keyboard0.waitSent();
+    nkroKeyboard.sendKeys(modifiers, usages, n);
+    paceKeyboard(nkroKeyboard, rate.holdMs);
+    nkroKeyboard.releaseAll();
+    paceKeyboard(nkroKeyboard, rate.gapMs);
+    nkroKeyboard.waitSent();
+    return;
+  }
+#endif
+
+  if (count > 6) {
+    ESP_LOGW(TAG, "Boot protocol keyboard: sending the first 6 of %u keys", (unsigned)count);
+    count = 6;
   }
+  keyboard0.sendKeycode(encodedKeys, count);
+  paceKeyboard(keyboard0, rate.holdMs);
   keyboard0.releaseAll();
+  paceKeyboard(keyboard0, rate.gapMs);
+}
+
+// Relative motion state for the mouse worker; not shared with the jiggle task
+static MouseMotion mouseMotion(MOUSE_SPEED_SCALE);
+
+// Send one frame of motion as however many reports it needs. Each report takes one USB
+// frame to leave the interface FIFO, so a packet's frames play back at the polling rate.
+static void playMotion(int32_t x, int32_t y, int32_t wheel)
+{
+  mouseMotion.add(x, y, wheel);
+  MouseStep step;
+  while (mouseMotion.next(&step)) {
+    mouse.move(step.x, step.y, step.wheel, 0);
+  }
 }
 
 // Move the mouse by dx and dy, with optional left/right click states
@@ -136,7 +677,7 @@ void moveMouse(int32_t x, int32_t y, int32_t LClick, int32_t RClick, int32_t whe
   
   // vTaskDelay(pdMS_TO_TICKS(5));
   //smoothMoveMouse(x, y, 20, 5); // Move the mouse by dx and dy over 20 steps and SLOWMODE_DELAY_MS ms between each step
-  mouse.move(x, y, wheel, 0);
+  playMotion(x, y, wheel);
   // vTaskDelay(pdMS_TO_TICKS(5));
 
   // Release after moving the mouse
@@ -149,22 +690,21 @@ void moveMouse(int32_t x, int32_t y, int32_t LClick, int32_t RClick, int32_t whe
   }
 }
 
-// Press a consumer control key
+// Tap a consumer control key. The press and its release go into the interface FIFO back
+// to back, so the host reads the release on the poll after the press and nothing sleeps.
 void consumerControlPress(uint16_t key){
   control.press(key);
-  vTaskDelay(pdMS_TO_TICKS(10));
   control.release();
-
 }
 
-// Press a consumer control key
+// Tap each key of a toothpaste_ConsumerControlPacket in order. Reports leave the FIFO one
+// per host poll as each completes; queueing only waits once the FIFO is full.
 void consumerControlPress(toothpaste_ConsumerControlPacket& controlPacket){
-  for (size_t i = 0; i < controlPacket.length; i++) {
+  // length comes from the client, code_count from the decoder
+  pb_size_t count = controlPacket.length < controlPacket.code_count ? controlPacket.length : controlPacket.code_count;
+  for (pb_size_t i = 0; i < count; i++) {
     consumerControlPress(controlPacket.code[i]);
   }
-  vTaskDelay(pdMS_TO_TICKS(10));
-  control.release();
-
 }
 
 // Unpack a mouse packet from a byte array and move the mouse accordingly
@@ -195,8 +735,9 @@ void moveMouse(uint8_t* mousePacket) {
 
 // Unpack a toothpacket_MousePacket and move the mouse accordingly
 void moveMouse(toothpaste_MousePacket& mousePacket) {
-    // Move mouse for each frame
-    for(uint8_t i = 0; i < mousePacket.num_frames; i++){
+    // Move mouse for each frame; num_frames comes from the client, frames_count from the decoder
+    pb_size_t frames = mousePacket.num_frames < mousePacket.frames_count ? mousePacket.num_frames : mousePacket.frames_count;
+    for(pb_size_t i = 0; i < frames; i++){
         int32_t x = mousePacket.frames[i].x;
         int32_t y = mousePacket.frames[i].y;
         moveMouse(x, y, 0, 0, 0);
@@ -210,6 +751,35 @@ void moveMouse(toothpaste_MousePacket& mousePacket) {
     moveMouse(0, 0, LClick, RClick, mousePacket.wheel); 
 }
 
+bool pointerAvailable() {
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Place the cursor at a toothpaste_PointerPacket's screen position. The position and wheel go
+// out in one report; click changes follow at the new position so a tap never lands, or a
+// drag never ends, where the cursor used to be.
+void movePointer(toothpaste_PointerPacket& pointerPacket) {
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+    int16_t x = (int16_t)std::min<uint32_t>(pointerPacket.x, POINTER_AXIS_MAX);
+    int16_t y = (int16_t)std::min<uint32_t>(pointerPacket.y, POINTER_AXIS_MAX);
+    int8_t wheel = (int8_t)std::max<int32_t>(-MOUSE_STEP_MAX, std::min<int32_t>(pointerPacket.wheel, MOUSE_STEP_MAX));
+    absMouse.move(x, y, wheel);
+
+    // Same click states as MousePacket: 1 presses, 2 releases
+    if (pointerPacket.l_click == 1) absMouse.press(MOUSE_LEFT);
+    else if (pointerPacket.l_click == 2) absMouse.release(MOUSE_LEFT);
+    if (pointerPacket.r_click == 1) absMouse.press(MOUSE_RIGHT);
+    else if (pointerPacket.r_click == 2) absMouse.release(MOUSE_RIGHT);
+#else
+    (void)pointerPacket;
+    ESP_LOGW(TAG, "Pointer packet ignored: absolute pointer interface not built in");
+#endif
+}
+
 
 // Simple mouse jiggle function to prevent screen sleep
 void jiggleMouse(){
@@ -221,30 +791,300 @@ void jiggleMouse(){
   int32_t x = (int32_t)((ticks % 7) - 3);
   int32_t y = (int32_t)(((ticks >> 16) % 7) - 3);
   
-  moveMouse(x, y, 0, 0, 0);
+  mouse.move(x, y);
   vTaskDelay(pdMS_TO_TICKS(1000));
-  moveMouse(-x, -y, 0, 0, 0);
+  mouse.move(-x, -y);
   vTaskDelay(pdMS_TO_TICKS(1000));
 }
 
 // ##################### RTOS Tasks + Helpers #################### //
 
+// Read exactly len payload bytes; the producer wrote them before queueing their item
+static size_t readKeyboardStream(StreamBufferHandle_t stream, void* dst, size_t len)
+{
+  size_t got = 0;
+  while (got < len) {
+    size_t n = xStreamBufferReceive(stream, (uint8_t*)dst + got, len - got, 0);
+    if (n == 0) break;
+    got += n;
+  }
+  return got;
+}
+
+// Drop a payload the worker cannot use so the stream stays aligned with the queue
+static void skipKeyboardStream(StreamBufferHandle_t stream, size_t len)
+{
+  uint8_t scratch[32];
+  while (len > 0) {
+    size_t n = readKeyboardStream(stream, scratch, len < sizeof(scratch) ? len : sizeof(scratch));
+    if (n == 0) break;
+    len -= n;
+  }
+}
+
+// The stream came up short of an item's length, so it no longer lines up with the queue.
+// Drop both rather than type the items behind it from the wrong offset.
+static void resyncKeyLane(KeyLaneState& l)
+{
+  xSemaphoreTake(keyboardProducerLock, portMAX_DELAY);
+  UBaseType_t dropped = uxQueueMessagesWaiting(l.queue);
+  xQueueReset(l.queue);
+  xStreamBufferReset(l.stream);
+  xSemaphoreGive(keyboardProducerLock);
+
+  ESP_LOGE(TAG, "Keyboard %s lane resynced, %u items dropped", l.name, (unsigned)dropped);
+}
+
+// Pull the next queued item into *item if it is more text for the same profile
+static bool continueText(KeyLaneState& l, toothpaste_TypingProfile profile, QueueKeyItem* item)
+{
+  QueueKeyItem next;
+  if (xQueuePeek(l.queue, &next, 0) != pdTRUE) return false;
+  if (next.type != KEY_TEXT || next.profile != profile) return false;
+  xQueueReceive(l.queue, item, 0);
+  pipelineRecord(l.waitStage, pipelineNowUs() - item->queuedUs);
+  return true;
+}
+
+// Type a text item straight out of the lane's stream, HID_TEXT_CHUNK bytes at a time.
+// Text items already queued behind it with the same profile continue the same string,
+// so a paste split across packets coalesces across the split and only lifts its keys at
+// the end. A short read ends the string with what arrived and resyncs the lane.
+static size_t typeStream(KeyLane lane, const QueueKeyItem& first)
+{
+  KeyLaneState& l = keyLanes[lane];
+  TypingRate rate = typingRate(first.profile);
+  ReportCompiler compiler(keyboard0.layout(), keyboard0.keymap(), activeUnicodeInput);
+  compiler.begin(rate.coalesce);
+
+  char chunk[HID_TEXT_CHUNK + 3];   // Room for a split UTF-8 sequence carried over
+  size_t carry = 0;
+  size_t remaining = first.length;
+  bool shortRead = false;
+
+  while (true) {
+    size_t want = remaining < HID_TEXT_CHUNK ? remaining : HID_TEXT_CHUNK;
+    size_t got = readKeyboardStream(l.stream, chunk + carry, want);
+    if (got < want) {
+      ESP_LOGE(TAG, "Keyboard %s stream short by %u bytes", l.name, (unsigned)(remaining - got));
+      shortRead = true;
+      remaining = 0;
+    } else {
+      remaining -= got;
+    }
+
+    // Items behind a short read would start at the wrong stream offset: never continue into them
+    QueueKeyItem next;
+    if (remaining == 0 && !shortRead && continueText(l, first.profile, &next)) remaining = next.length;
+
+    bool last = remaining == 0;
+    size_t avail = carry + got;
+    size_t whole = last ? avail : ReportCompiler::completeUtf8(chunk, avail);
+    compiler.feed(chunk, whole, last);
+    if (!sendFrames(compiler, rate, lane)) {
+      // Cancelled: lift whatever the paste was holding; the rest of it is flushed
+      KeyFrame up;
+      if (compiler.release(&up)) sendFrame(up, rate.gapMs);
+      break;
+    }
+    if (last) break;
+
+    carry = avail - whole;
+    memmove(chunk, chunk + whole, carry);
+  }
+
+  if (shortRead) resyncKeyLane(l);
+  return compiler.typed();
+}
+
+static void runKeyItem(KeyLane lane, const QueueKeyItem& item)
+{
+  static uint8_t payload[HID_KEYCODE_MAX > 1 + KEYMAP_SIZE ? HID_KEYCODE_MAX : 1 + KEYMAP_SIZE];
+  KeyLaneState& l = keyLanes[lane];
+  uint32_t t0 = pipelineNowUs();
+  pipelineRecord(l.waitStage, t0 - item.queuedUs);
+  if (lane == LANE_INTERACTIVE && bulkBusy()) pipelineRecord(STAGE_KEYBOARD_WAIT_PASTE, t0 - item.queuedUs);
+
+  switch (item.type) {
+    case KEY_JOB_END: {
+      int64_t requestedUs = 0;
+      if (item.length == sizeof(requestedUs)) readKeyboardStream(l.stream, &requestedUs, sizeof(requestedUs));
+      else if (item.length > 0) skipKeyboardStream(l.stream, item.length);
+
+      int64_t now = esp_timer_get_time();
+      if (requestedUs != 0) {
+        ESP_LOGI(TAG, "Job complete (%s): %u chars in %lld ms, %lld ms after request", l.name,
+          (unsigned)l.jobChars, (now - l.jobStart) / 1000, (now - requestedUs) / 1000);
+      } else {
+        ESP_LOGI(TAG, "Job complete (%s): %u chars in %lld ms", l.name, (unsigned)l.jobChars,
+          (now - l.jobStart) / 1000);
+      }
+      l.jobChars = 0;
+      return;
+    }
+
+    case KEY_CODES:
+    case KEY_LAYOUT:
+      // payload is shared: bulk text only yields between characters, so these never nest
+      if (item.length > sizeof(payload)) {
+        skipKeyboardStream(l.stream, item.length);
+        return;
+      }
+      readKeyboardStream(l.stream, payload, item.length);
+      if (item.type == KEY_CODES) {
+        sendKeycode(payload, item.length, item.profile);
+      } else if (item.length > 0) {
+        applyKeyboardLayout(payload, item.length);
+      }
+      break;
+
+    case KEY_TEXT:
+      if (l.jobChars == 0) l.jobStart = esp_timer_get_time();
+      l.jobChars += typeStream(lane, item);
+      break;
+  }
+  pipelineRecord(l.outStage, pipelineNowUs() - t0);
+}
+
+// Interactive input that may cut into bulk text. A layout switch waits for the string
+// in progress to finish, and holds back the interactive items behind it.
+static bool interactivePending()
+{
+  QueueKeyItem next;
+  return xQueuePeek(keyLanes[LANE_INTERACTIVE].queue, &next, 0) == pdTRUE && next.type != KEY_LAYOUT;
+}
+
+static void typeInteractive()
+{
+  QueueKeyItem item;
+  while (interactivePending() && xQueueReceive(keyLanes[LANE_INTERACTIVE].queue, &item, 0) == pdTRUE) {
+    runKeyItem(LANE_INTERACTIVE, item);
+  }
+}
+
+// Empty the bulk lane. Producers are held off so the stream and queue are cleared together.
+static void flushBulkLane()
+{
+  KeyLaneState& l = keyLanes[LANE_BULK];
+  xSemaphoreTake(keyboardProducerLock, portMAX_DELAY);
+  UBaseType_t dropped = uxQueueMessagesWaiting(l.queue);
+  xQueueReset(l.queue);
+  xStreamBufferReset(l.stream);
+  bulkCancelRequested = false;
+  xSemaphoreGive(keyboardProducerLock);
+
+  ESP_LOGI(TAG, "Bulk keyboard cancelled: %u chars typed, %u items dropped", (unsigned)l.jobChars, (unsigned)dropped);
+  l.jobChars = 0;
+}
+
 void keyboardTask(void* params)
 {
-  QueueStringItem item;
-  
+  QueueKeyItem item;
+
   while (keyboardStarted) {
-    if(xQueueReceive(reportQueue, &item, portMAX_DELAY) == pdTRUE){
-      sendStringSlow(item.data, SLOWMODE_DELAY_MS);
+    if (bulkCancelRequested) flushBulkLane();
+
+    if (xQueueReceive(keyLanes[LANE_INTERACTIVE].queue, &item, 0) == pdTRUE) {
+      runKeyItem(LANE_INTERACTIVE, item);
+    }
+    else if (xQueueReceive(keyLanes[LANE_BULK].queue, &item, 0) == pdTRUE) {
+      bulkTyping = true;
+      runKeyItem(LANE_BULK, item);
+      bulkTyping = false;
+    }
+    else {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);  // Producers notify after queueing
     }
   }
   // Task exits gracefully when flag is set to false
   vTaskDelete(NULL);  // Delete self
 }
 
-// Start the persistent keyboard queue task
-void startKeyboardTask()
+// Play the overflow once nothing queued is ahead of it: each segment's motion in
+// frame-sized pieces, then its button change
+static void playMouseOverflow()
+{
+  if (uxQueueMessagesWaiting(mouseQueue) != 0) return;
+
+  MouseOverflow overflow;
+  if (!takeMouseOverflow(&overflow)) return;
+  for (uint8_t i = 0; i < overflow.count; i++) {
+    MouseOverflowSegment& segment = overflow.segments[i];
+    int32_t x, y, wheel;
+    while (nextOverflowFrame(&segment, &x, &y, &wheel)) {
+      playMotion(x, y, wheel);
+    }
+    if (segmentClosed(segment)) moveMouse(0, 0, segment.lClick, segment.rClick, 0);
+  }
+}
+
+void mouseTask(void* params)
+{
+  QueueMouseItem item;
+
+  while (true) {
+    // Timed so overflow merged just as the queue drained is not left waiting for new input
+    if (xQueueReceive(mouseQueue, &item, pdMS_TO_TICKS(HID_ENQUEUE_WAIT_MS)) == pdTRUE) {
+      uint32_t t0 = pipelineNowUs();
+      pipelineRecord(STAGE_MOUSE_WAIT, t0 - item.queuedUs);
+      if (bulkBusy()) pipelineRecord(STAGE_MOUSE_WAIT_PASTE, t0 - item.queuedUs);
+      if (item.absolute) movePointer(item.pointer);
+      else moveMouse(item.packet);
+      pipelineRecord(STAGE_MOUSE_OUT, pipelineNowUs() - t0);
+    }
+    playMouseOverflow();
+  }
+}
+
+void consumerTask(void* params)
+{
+  QueueConsumerItem item;
+
+  while (true) {
+    if (xQueueReceive(consumerQueue, &item, portMAX_DELAY) == pdTRUE) {
+      uint32_t t0 = pipelineNowUs();
+      pipelineRecord(STAGE_CONSUMER_WAIT, t0 - item.queuedUs);
+      consumerControlPress(item.packet);
+      pipelineRecord(STAGE_CONSUMER_OUT, pipelineNowUs() - t0);
+    }
+  }
+}
+
+// Stream behind a keyboard lane's queue. The bulk stream goes to PSRAM when configured
+// and available.
+static void createKeyboardStream(KeyLaneState& l, bool psram)
+{
+#ifdef CONFIG_TOOTHPASTE_HID_STREAM_PSRAM
+  static StaticStreamBuffer_t streamState;
+  if (psram) {
+    uint8_t* storage = (uint8_t*)heap_caps_malloc(l.streamSize + 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (storage != nullptr) {
+      l.stream = xStreamBufferCreateStatic(l.streamSize, 1, storage, &streamState);
+    } else {
+      ESP_LOGW(TAG, "No PSRAM for the %s keyboard stream, using internal RAM", l.name);
+    }
+  }
+#endif
+  if (l.stream == nullptr) {
+    l.stream = xStreamBufferCreate(l.streamSize, 1);
+  }
+  if (l.stream == nullptr) {
+    ESP_LOGE(TAG, "Keyboard %s stream allocation failed (%u B)", l.name, (unsigned)l.streamSize);
+  }
+}
+
+// Start the persistent HID output workers, one per interface, on the TinyUSB core.
+// SendReport() only blocks while its own interface's FIFO is full, so one slow
+// interface doesn't hold up the others.
+void startHidTasks()
 {
+  if (keyLanes[LANE_INTERACTIVE].stream == nullptr) {
+    createKeyboardStream(keyLanes[LANE_INTERACTIVE], false);
+  }
+  if (keyLanes[LANE_BULK].stream == nullptr) {
+    createKeyboardStream(keyLanes[LANE_BULK], true);
+  }
+
   if (keyboardTaskHandle == nullptr) {
     keyboardStarted = true;  // Set flag before creating task
     xTaskCreatePinnedToCore(
@@ -252,9 +1092,33 @@ void startKeyboardTask()
       "KeyboardWorker",
       8096,
       nullptr,
-      1,
+      KEYBOARD_TASK_PRIORITY,
       &keyboardTaskHandle,
-      1
+      HID_OUTPUT_CORE
+    );
+  }
+
+  if (mouseTaskHandle == nullptr) {
+    xTaskCreatePinnedToCore(
+      mouseTask,
+      "MouseWorker",
+      3072,
+      nullptr,
+      MOUSE_TASK_PRIORITY,
+      &mouseTaskHandle,
+      HID_OUTPUT_CORE
+    );
+  }
+
+  if (consumerTaskHandle == nullptr) {
+    xTaskCreatePinnedToCore(
+      consumerTask,
+      "ConsumerWorker",
+      3072,
+      nullptr,
+      CONSUMER_TASK_PRIORITY,
+      &consumerTaskHandle,
+      HID_OUTPUT_CORE
     );
   }
 }
@@ -316,32 +1180,3 @@ void sendStringDelay(void *arg, int delayms){
     esp_timer_create(&timer_args, &oneShotTimer);
     esp_timer_start_once(oneShotTimer, delayms*1000); // Delay uses ms
 }
-
-//------------------------TINYUSB Callbacks------------------------------//
-
-// Callback triggered by TinyUSB once the HOST consumes the current report
-// TODO: Actually use this callback to manage report sending state, for now this blocks forever if the host is not ready
-
-
-// void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len) {
-//   ESP_LOGD(TAG, "Report complete callback entered");
-//   switch(instance){
-//     case 0:
-//       // keyboard0.unlock();
-//       ESP_LOGI("HID", "Interface 0 report complete");
-//       break;
-
-//     case 1:
-//       // keyboard0.unlock();
-//       ESP_LOGI("HID", "Interface 1 report complete");
-//       break;
-
-//     case 2:
-//       // control.unlock();
-//       ESP_LOGI("HID", "Interface 2 report complete");
-//       break;
-
-//     default:
-//       break;
-//   }
-// }
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "toothpacket.pb.h"
+#include "ReportCompiler.h"
 
 // #define CFG_TUD_CDC        
 // #define CONFIG_TINYUSB_CDC_ENABLED
@@ -7,31 +8,101 @@
 #define USB_PRODUCT        "ToothPaste Receiver"
 #define USB_SERIAL         "" // Empty string for MAC adddress
 
-#define SLOWMODE_DELAY_MS 5
+// Keystroke timing per toothpaste_TypingProfile: how long each key is held and the gap
+// before the next press, in ms (one USB frame each at bInterval = 1). Full speed adds no
+// delay and is paced only by the report FIFO, i.e. one report per frame.
+#define TYPING_STANDARD_HOLD_MS       2
+#define TYPING_STANDARD_GAP_MS        2
+#define TYPING_CONSERVATIVE_HOLD_MS   10
+#define TYPING_CONSERVATIVE_GAP_MS    10
+
+// Keyboard stage payloads share one byte stream per lane: bulk text gets
+// CONFIG_TOOTHPASTE_HID_STREAM_SIZE, interactive input a small fixed one. Text items
+// above a quarter of the stream are split so one paste cannot need all of it at once;
+// the worker compiles text HID_TEXT_CHUNK bytes at a time.
+#define HID_STREAM_SIZE               CONFIG_TOOTHPASTE_HID_STREAM_SIZE
+#define HID_INTERACTIVE_STREAM_SIZE   2048
+#define HID_TEXT_CHUNK    64
+#define HID_KEYCODE_MAX   255   // Most keys one keycode item presses together
+
+// HID output stage: one worker per interface on the TinyUSB core (CONFIG_TINYUSB_TASK_AFFINITY),
+// fed by bounded queues from PacketWorker. Mouse runs highest since pointer lag is most visible.
+#define HID_OUTPUT_CORE         1
+#define KEYBOARD_TASK_PRIORITY  2
+#define MOUSE_TASK_PRIORITY     3
+#define CONSUMER_TASK_PRIORITY  2
+#define KEYBOARD_QUEUE_DEPTH    32
+#define MOUSE_QUEUE_DEPTH       8
+#define CONSUMER_QUEUE_DEPTH    4
+#define HID_ENQUEUE_WAIT_MS     20
+#define MOUSE_OVERFLOW_SEGMENTS 8     // Mouse overflow: up to 7 parked button changes plus the open motion
+
+// Pointer speed applied to relative mouse frames, in MouseMotion's 8.8 fixed point
+#define MOUSE_SPEED_SCALE       (CONFIG_TOOTHPASTE_MOUSE_SPEED_PERCENT * MOUSE_SCALE_ONE / 100)
+
+// Absolute pointer coordinates run 0..POINTER_AXIS_MAX across the host screen on each axis
+#define POINTER_AXIS_MAX        32767
 
 #ifndef HID_H
 #define HID_H
 
+// Keyboard lanes: interactive input (live typing, shortcuts) is typed ahead of bulk text
+// (pastes, scripts), which it interrupts between characters. Each lane keeps its own order.
+enum KeyLane : uint8_t {
+  LANE_INTERACTIVE,
+  LANE_BULK,
+  KEY_LANE_COUNT
+};
+
 
 void hidSetup();
 
+// Typing profile for a packet: an explicit profile wins, then slowMode, then the build default
+toothpaste_TypingProfile resolveTypingProfile(toothpaste_TypingProfile requested, bool slowMode);
+const char* typingProfileName(toothpaste_TypingProfile profile);
+
+// Host method for characters the layout cannot type (build default from Kconfig)
+void setUnicodeInput(UnicodeInput input);
+UnicodeInput unicodeInput();
+
 // Keyboard String Functions
 void sendString(const char* str, bool slowMode = true);
-void sendString(const char *str, uint8_t stringLen, bool slowMode);
+void sendString(const char *str, size_t stringLen, bool slowMode);
+void sendString(const char *str, size_t stringLen, toothpaste_TypingProfile profile,
+                KeyLane lane = LANE_INTERACTIVE);
+size_t typeString(const char *str, size_t len, toothpaste_TypingProfile profile);
 void sendStringDelay(void *arg, int delay);
+void endStringJob(KeyLane lane = LANE_INTERACTIVE, int64_t requestedUs = 0);
+void cancelBulkKeyboard();
+size_t hidQueueSpaces(KeyLane lane, size_t bytesPerWrite);
+
+// Keyboard layout: switched in order with queued text and kept in NVS
+const uint8_t* loadKeyboardLayout();
+bool queueKeyboardLayout(toothpaste_KeyboardLayoutPacket_LayoutID id, const uint8_t* customTable, size_t customLen,
+                         KeyLane lane = LANE_INTERACTIVE);
+
+// Stage hand-off: queue work for the per-interface HID workers
+void queueKeycode(const uint8_t* keys, size_t count, toothpaste_TypingProfile profile,
+                  KeyLane lane = LANE_INTERACTIVE);
+void queueMouse(const toothpaste_MousePacket& packet);
+void queuePointer(const toothpaste_PointerPacket& packet);
+bool pointerAvailable();   // Absolute pointer interface built in; reported to the client in every response
+void cancelQueuedMouse();
+void queueConsumerControl(const toothpaste_ConsumerControlPacket& packet);
 
 // Keycode Functions
-void sendKeycode(uint8_t* keys, bool slowMode, bool autoRelease);
+void sendKeycode(uint8_t* keys, size_t count, toothpaste_TypingProfile profile);
 bool keycodePacketCallback(pb_istream_t *stream, const pb_field_t *field, void **arg);
 
 void stringTest();
 void genericInput();
-void startKeyboardTask();
+void startHidTasks();
 
 //Mouse functions
 void moveMouse(int32_t x, int32_t y, int32_t LClick, int32_t RClick, int32_t wheel);
 void moveMouse(uint8_t* mousePacket);
 void moveMouse(toothpaste_MousePacket&);
+void movePointer(toothpaste_PointerPacket&);
 void smoothMoveMouse(int dx, int dy, int steps, int interval);
 void startJiggle();
 void stopJiggle();
@@ -4,9 +4,29 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
-
-
-#define TUSB_DESC_TOTAL_LEN      (TUD_CONFIG_DESC_LEN + CFG_TUD_HID * TUD_HID_DESC_LEN)
+#include "sdkconfig.h"
+#include "IDFHIDNkroKeyboard.h"
+
+// Interface 3 is optional and holds either the NKRO keyboard or the absolute pointer (Kconfig
+// keeps them exclusive): each HID interface needs its own IN endpoint, and the ESP32-S3 has
+// only four besides EP0
+#define HID_ITF_NKRO_KEYBOARD 3
+#define HID_ITF_ABS_MOUSE 3
+#if defined(CONFIG_TOOTHPASTE_HID_NKRO) || defined(CONFIG_TOOTHPASTE_HID_ABS_MOUSE)
+#define HID_ITF_COUNT 4
+#else
+#define HID_ITF_COUNT 3
+#endif
+
+#if defined(CONFIG_TOOTHPASTE_HID_NKRO) && defined(CONFIG_TOOTHPASTE_HID_ABS_MOUSE)
+#error "The NKRO keyboard and the absolute pointer both need interface 3; enable only one"
+#endif
+
+#if CFG_TUD_HID < HID_ITF_COUNT
+#error "CONFIG_TINYUSB_HID_COUNT is lower than the number of HID interfaces in the descriptor"
+#endif
+
+#define TUSB_DESC_TOTAL_LEN      (TUD_CONFIG_DESC_LEN + HID_ITF_COUNT * TUD_HID_DESC_LEN)
 
 static const char *TAG = "hid_keyboard";
 
@@ -30,6 +50,17 @@ uint8_t const desc_consumerControl[] =
       TUD_HID_REPORT_DESC_CONSUMER(),
 };
 
+uint8_t const desc_nkro_keyboard[] =
+{
+      TUD_HID_REPORT_DESC_NKRO_KEYBOARD(),
+};
+
+// No report ID: IDFHID sends every report with ID 0
+uint8_t const desc_abs_mouse[] =
+{
+      TUD_HID_REPORT_DESC_ABSMOUSE(),
+};
+
 uint8_t const desc_systemControl[] =
 {
     //TUD_HID_REPORT_DESC_KEYBOARD( HID_REPORT_ID(1         )),
@@ -37,7 +68,7 @@ uint8_t const desc_systemControl[] =
 };
 
 
-const char *hid_string_descriptor[7] = {
+const char *hid_string_descriptor[9] = {
     // array of pointer to string descriptors
     (char[]){0x09, 0x04},     // 0: is supported language is English (0x0409)
     "Brisk4t",                // 1: Manufacturer
@@ -46,6 +77,8 @@ const char *hid_string_descriptor[7] = {
     "ToothPaste Boot Keyboard",   // 4: HID
     "ToothPaste Boot Mouse",      // 5: HID
     "ToothPaste Generic Input",   // 6: HID
+    "ToothPaste NKRO Keyboard",   // 7: HID
+    "ToothPaste Absolute Pointer", // 8: HID
 };
 
 tusb_desc_device_t const desc_device =
@@ -71,12 +104,18 @@ tusb_desc_device_t const desc_device =
 
 static const uint8_t hid_configuration_descriptor[] = {
     // Configuration number, interface count, string index, total length, attribute, power in mA
-    TUD_CONFIG_DESCRIPTOR(1, 3, 0, TUSB_DESC_TOTAL_LEN, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 500),
+    TUD_CONFIG_DESCRIPTOR(1, HID_ITF_COUNT, 0, TUSB_DESC_TOTAL_LEN, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 500),
 
     // Interface number, string index, boot protocol (none/boot keyboard/boot mouse), report descriptor len, EP In address, size & polling interval
     TUD_HID_DESCRIPTOR(0, 4, HID_ITF_PROTOCOL_KEYBOARD, sizeof(desc_boot_keyboard), 0x81, 64, 1),
     TUD_HID_DESCRIPTOR(1, 5, HID_ITF_PROTOCOL_MOUSE, sizeof(desc_boot_mouse), 0x82, 64, 1),
     TUD_HID_DESCRIPTOR(2, 6, HID_ITF_PROTOCOL_NONE, sizeof(desc_consumerControl), 0x83, 64, 1),
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+    TUD_HID_DESCRIPTOR(HID_ITF_NKRO_KEYBOARD, 7, HID_ITF_PROTOCOL_NONE, sizeof(desc_nkro_keyboard), 0x81 + HID_ITF_NKRO_KEYBOARD, 64, 1),
+#endif
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+    TUD_HID_DESCRIPTOR(HID_ITF_ABS_MOUSE, 8, HID_ITF_PROTOCOL_NONE, sizeof(desc_abs_mouse), 0x81 + HID_ITF_ABS_MOUSE, 64, 1),
+#endif
     //TUD_HID_DESCRIPTOR(3, 6, HID_ITF_PROTOCOL_NONE, sizeof(desc_systemControl), 0x84, 64, 1),
 };
 
@@ -180,6 +219,18 @@ uint8_t const * tud_hid_descriptor_report_cb(uint8_t itf)
   {
     return desc_consumerControl;
   }
+#ifdef CONFIG_TOOTHPASTE_HID_NKRO
+  else if (itf == HID_ITF_NKRO_KEYBOARD)
+  {
+    return desc_nkro_keyboard;
+  }
+#endif
+#ifdef CONFIG_TOOTHPASTE_HID_ABS_MOUSE
+  else if (itf == HID_ITF_ABS_MOUSE)
+  {
+    return desc_abs_mouse;
+  }
+#endif
   // else if (itf == 3)
   // {
   //   return desc_systemControl;
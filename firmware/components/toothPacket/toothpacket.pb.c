@@ -36,6 +36,18 @@ PB_BIND(toothpaste_ConsumerControlPacket, toothpaste_ConsumerControlPacket, AUTO
 PB_BIND(toothpaste_MouseJigglePacket, toothpaste_MouseJigglePacket, AUTO)
 
 
+PB_BIND(toothpaste_CompositePacket, toothpaste_CompositePacket, AUTO)
+
+
+PB_BIND(toothpaste_KeyboardLayoutPacket, toothpaste_KeyboardLayoutPacket, AUTO)
+
+
+PB_BIND(toothpaste_CancelPacket, toothpaste_CancelPacket, AUTO)
+
+
+PB_BIND(toothpaste_PointerPacket, toothpaste_PointerPacket, AUTO)
+
+
 
 
 
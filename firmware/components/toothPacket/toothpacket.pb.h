@@ -10,6 +10,14 @@
 #endif
 
 /* Enum definitions */
+/* Keystroke pacing for typed text and keycodes */
+typedef enum _toothpaste_TypingProfile {
+    toothpaste_TypingProfile_TYPING_DEFAULT = 0, /* slowMode picks CONSERVATIVE, otherwise the receiver's default */
+    toothpaste_TypingProfile_TYPING_FULL_SPEED = 1, /* one report per USB frame */
+    toothpaste_TypingProfile_TYPING_STANDARD = 2, /* short hold and gap, safe for desktop OSes */
+    toothpaste_TypingProfile_TYPING_CONSERVATIVE = 3 /* long hold and gap for BIOS / KVM targets */
+} toothpaste_TypingProfile;
+
 /* Packet.Header */
 typedef enum _toothpaste_DataPacket_PacketID {
     toothpaste_DataPacket_PacketID_DATA_PACKET = 0,
@@ -23,7 +31,10 @@ typedef enum _toothpaste_EncryptedData_PacketType {
     toothpaste_EncryptedData_PacketType_MOUSE = 2,
     toothpaste_EncryptedData_PacketType_RENAME = 3,
     toothpaste_EncryptedData_PacketType_CONSUMER_CONTROL = 4,
-    toothpaste_EncryptedData_PacketType_COMPOSITE = 5
+    toothpaste_EncryptedData_PacketType_COMPOSITE = 5,
+    toothpaste_EncryptedData_PacketType_KEYBOARD_LAYOUT = 6,
+    toothpaste_EncryptedData_PacketType_CANCEL = 7,
+    toothpaste_EncryptedData_PacketType_POINTER = 8
 } toothpaste_EncryptedData_PacketType;
 
 /* Indicate the notification type */
@@ -31,13 +42,30 @@ typedef enum _toothpaste_ResponsePacket_ResponseType {
     toothpaste_ResponsePacket_ResponseType_KEEPALIVE = 0,
     toothpaste_ResponsePacket_ResponseType_PEER_UNKNOWN = 1,
     toothpaste_ResponsePacket_ResponseType_PEER_KNOWN = 2,
-    toothpaste_ResponsePacket_ResponseType_CHALLENGE = 3
+    toothpaste_ResponsePacket_ResponseType_CHALLENGE = 3,
+    toothpaste_ResponsePacket_ResponseType_RECV_READY = 4, /* creditLimit raised, client may send up to it */
+    toothpaste_ResponsePacket_ResponseType_RECV_NOT_READY = 5 /* receiver full, hold writes until the next RECV_READY */
 } toothpaste_ResponsePacket_ResponseType;
 
+typedef enum _toothpaste_KeyboardLayoutPacket_LayoutID {
+    toothpaste_KeyboardLayoutPacket_LayoutID_EN_US = 0,
+    toothpaste_KeyboardLayoutPacket_LayoutID_DE_DE = 1,
+    toothpaste_KeyboardLayoutPacket_LayoutID_ES_ES = 2,
+    toothpaste_KeyboardLayoutPacket_LayoutID_FR_FR = 3,
+    toothpaste_KeyboardLayoutPacket_LayoutID_IT_IT = 4,
+    toothpaste_KeyboardLayoutPacket_LayoutID_PT_PT = 5,
+    toothpaste_KeyboardLayoutPacket_LayoutID_SV_SE = 6,
+    toothpaste_KeyboardLayoutPacket_LayoutID_DA_DK = 7,
+    toothpaste_KeyboardLayoutPacket_LayoutID_HU_HU = 8,
+    toothpaste_KeyboardLayoutPacket_LayoutID_PT_BR = 9,
+    toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM = 10 /* customTable, uploaded by the client */
+} toothpaste_KeyboardLayoutPacket_LayoutID;
+
 /* Struct definitions */
 typedef PB_BYTES_ARRAY_T(12) toothpaste_DataPacket_iv_t;
 typedef PB_BYTES_ARRAY_T(200) toothpaste_DataPacket_encryptedData_t;
 typedef PB_BYTES_ARRAY_T(16) toothpaste_DataPacket_tag_t;
+typedef PB_BYTES_ARRAY_T(8) toothpaste_DataPacket_resumeTicket_t;
 /* Total permissible size of DataPacket must be < 253 bytes on the wire (over BLE) */
 typedef struct _toothpaste_DataPacket {
     toothpaste_DataPacket_PacketID packetID; /* 1 - 4 bytes */
@@ -49,6 +77,11 @@ typedef struct _toothpaste_DataPacket {
     uint32_t dataLen; /* 4 bytes */
     toothpaste_DataPacket_encryptedData_t encryptedData; /* 200 bytes */
     toothpaste_DataPacket_tag_t tag; /* 16 bytes */
+    toothpaste_TypingProfile typingProfile; /* 1 - 2 bytes, overrides slowMode when set */
+    bool bulk; /* 1 byte, paste / script text that live input may overtake */
+    bool resume; /* 1 byte, AUTH only: client keeps a resumption ticket for this receiver */
+    toothpaste_DataPacket_resumeTicket_t resumeTicket; /* 8 bytes, AUTH only: ID of the ticket held, empty for none */
+    uint32_t credits; /* 1 - 2 bytes, input credits this write spent: one per CompositePacket command, 0 means 1 */
 } toothpaste_DataPacket;
 
 typedef PB_BYTES_ARRAY_T(150) toothpaste_ResponsePacket_challengeData_t;
@@ -57,6 +90,14 @@ typedef struct _toothpaste_ResponsePacket {
     toothpaste_ResponsePacket_ResponseType responseType;
     toothpaste_ResponsePacket_challengeData_t challengeData; /* 150 bytes max */
     char firmwareVersion[50]; /* 50 bytes max */
+    uint32_t creditLimit; /* total input credits the client may have sent since connecting */
+    uint32_t attMtu; /* negotiated ATT MTU */
+    uint32_t maxPayload; /* largest DataPacket.encryptedData the receiver accepts on this link */
+    uint32_t phy; /* 1 = LE 1M, 2 = LE 2M, 3 = LE Coded, 0 = unknown */
+    uint32_t connInterval; /* current connection interval in 1.25 ms units */
+    bool resumed; /* CHALLENGE only: session key derived from the resumption ticket, not ECDH */
+    uint32_t bulkCreditLimit; /* lower limit for bulk writes, so a paste leaves room for live input; 0 = creditLimit */
+    bool absolutePointer; /* receiver has the absolute pointer interface; false: PointerPacket is ignored, move with MousePacket frames */
 } toothpaste_ResponsePacket;
 
 /* Arbitrary String Data (processed based on packet type byte) */
@@ -105,6 +146,32 @@ typedef struct _toothpaste_MouseJigglePacket {
     bool enable;
 } toothpaste_MouseJigglePacket;
 
+/* Ordered batch of commands executed from a single encrypted DataPacket */
+typedef struct _toothpaste_CompositePacket {
+    pb_callback_t commands; /* run in order, nested batches are rejected */
+} toothpaste_CompositePacket;
+
+typedef PB_BYTES_ARRAY_T(128) toothpaste_KeyboardLayoutPacket_customTable_t;
+/* Select the layout the receiver types with; kept across reboots */
+typedef struct _toothpaste_KeyboardLayoutPacket {
+    toothpaste_KeyboardLayoutPacket_LayoutID layout;
+    toothpaste_KeyboardLayoutPacket_customTable_t customTable; /* 128 bytes, one entry per ASCII character (firmware KeyboardLayout.h encoding) */
+} toothpaste_KeyboardLayoutPacket;
+
+/* Drop queued bulk keyboard text and lift any keys it holds; live input is kept */
+typedef struct _toothpaste_CancelPacket {
+    bool mouse; /* also drop queued mouse movement */
+} toothpaste_CancelPacket;
+
+/* Absolute cursor position on the host screen, sent in a single report */
+typedef struct _toothpaste_PointerPacket {
+    uint32_t x; /* 0 (left edge) - 32767 (right edge) */
+    uint32_t y; /* 0 (top edge) - 32767 (bottom edge) */
+    int32_t l_click; /* left click state, as in MousePacket */
+    int32_t r_click; /* right click state */
+    int32_t wheel; /* wheel movement */
+} toothpaste_PointerPacket;
+
 typedef struct _toothpaste_EncryptedData {
     toothpaste_EncryptedData_PacketType packetType;
     pb_size_t which_packetData;
@@ -115,6 +182,10 @@ typedef struct _toothpaste_EncryptedData {
         toothpaste_RenamePacket renamePacket;
         toothpaste_ConsumerControlPacket consumerControlPacket;
         toothpaste_MouseJigglePacket mouseJigglePacket;
+        toothpaste_CompositePacket compositePacket;
+        toothpaste_KeyboardLayoutPacket keyboardLayoutPacket;
+        toothpaste_CancelPacket cancelPacket;
+        toothpaste_PointerPacket pointerPacket;
     } packetData;
 } toothpaste_EncryptedData;
 
@@ -124,19 +195,28 @@ extern "C" {
 #endif
 
 /* Helper constants for enums */
+#define _toothpaste_TypingProfile_MIN toothpaste_TypingProfile_TYPING_DEFAULT
+#define _toothpaste_TypingProfile_MAX toothpaste_TypingProfile_TYPING_CONSERVATIVE
+#define _toothpaste_TypingProfile_ARRAYSIZE ((toothpaste_TypingProfile)(toothpaste_TypingProfile_TYPING_CONSERVATIVE+1))
+
 #define _toothpaste_DataPacket_PacketID_MIN toothpaste_DataPacket_PacketID_DATA_PACKET
 #define _toothpaste_DataPacket_PacketID_MAX toothpaste_DataPacket_PacketID_AUTH_PACKET
 #define _toothpaste_DataPacket_PacketID_ARRAYSIZE ((toothpaste_DataPacket_PacketID)(toothpaste_DataPacket_PacketID_AUTH_PACKET+1))
 
 #define _toothpaste_EncryptedData_PacketType_MIN toothpaste_EncryptedData_PacketType_KEYBOARD_STRING
-#define _toothpaste_EncryptedData_PacketType_MAX toothpaste_EncryptedData_PacketType_COMPOSITE
-#define _toothpaste_EncryptedData_PacketType_ARRAYSIZE ((toothpaste_EncryptedData_PacketType)(toothpaste_EncryptedData_PacketType_COMPOSITE+1))
+#define _toothpaste_EncryptedData_PacketType_MAX toothpaste_EncryptedData_PacketType_POINTER
+#define _toothpaste_EncryptedData_PacketType_ARRAYSIZE ((toothpaste_EncryptedData_PacketType)(toothpaste_EncryptedData_PacketType_POINTER+1))
 
 #define _toothpaste_ResponsePacket_ResponseType_MIN toothpaste_ResponsePacket_ResponseType_KEEPALIVE
-#define _toothpaste_ResponsePacket_ResponseType_MAX toothpaste_ResponsePacket_ResponseType_CHALLENGE
-#define _toothpaste_ResponsePacket_ResponseType_ARRAYSIZE ((toothpaste_ResponsePacket_ResponseType)(toothpaste_ResponsePacket_ResponseType_CHALLENGE+1))
+#define _toothpaste_ResponsePacket_ResponseType_MAX toothpaste_ResponsePacket_ResponseType_RECV_NOT_READY
+#define _toothpaste_ResponsePacket_ResponseType_ARRAYSIZE ((toothpaste_ResponsePacket_ResponseType)(toothpaste_ResponsePacket_ResponseType_RECV_NOT_READY+1))
+
+#define _toothpaste_KeyboardLayoutPacket_LayoutID_MIN toothpaste_KeyboardLayoutPacket_LayoutID_EN_US
+#define _toothpaste_KeyboardLayoutPacket_LayoutID_MAX toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM
+#define _toothpaste_KeyboardLayoutPacket_LayoutID_ARRAYSIZE ((toothpaste_KeyboardLayoutPacket_LayoutID)(toothpaste_KeyboardLayoutPacket_LayoutID_CUSTOM+1))
 
 #define toothpaste_DataPacket_packetID_ENUMTYPE toothpaste_DataPacket_PacketID
+#define toothpaste_DataPacket_typingProfile_ENUMTYPE toothpaste_TypingProfile
 
 #define toothpaste_EncryptedData_packetType_ENUMTYPE toothpaste_EncryptedData_PacketType
 
@@ -149,11 +229,14 @@ extern "C" {
 
 
 
+#define toothpaste_KeyboardLayoutPacket_layout_ENUMTYPE toothpaste_KeyboardLayoutPacket_LayoutID
+
+
 
 /* Initializer values for message structs */
-#define toothpaste_DataPacket_init_default       {_toothpaste_DataPacket_PacketID_MIN, 0, 0, 0, {0, {0}}, 0, {0, {0}}, {0, {0}}}
+#define toothpaste_DataPacket_init_default       {_toothpaste_DataPacket_PacketID_MIN, 0, 0, 0, {0, {0}}, 0, {0, {0}}, {0, {0}}, _toothpaste_TypingProfile_MIN, 0, 0, {0, {0}}, 0}
 #define toothpaste_EncryptedData_init_default    {_toothpaste_EncryptedData_PacketType_MIN, 0, {toothpaste_KeyboardPacket_init_default}}
-#define toothpaste_ResponsePacket_init_default   {_toothpaste_ResponsePacket_ResponseType_MIN, {0, {0}}, ""}
+#define toothpaste_ResponsePacket_init_default   {_toothpaste_ResponsePacket_ResponseType_MIN, {0, {0}}, "", 0, 0, 0, 0, 0, 0, 0, 0}
 #define toothpaste_KeyboardPacket_init_default   {"", 0}
 #define toothpaste_RenamePacket_init_default     {"", 0}
 #define toothpaste_KeycodePacket_init_default    {{0, {0}}, 0}
@@ -161,9 +244,13 @@ extern "C" {
 #define toothpaste_MousePacket_init_default      {0, 0, {toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default, toothpaste_Frame_init_default}, 0, 0, 0}
 #define toothpaste_ConsumerControlPacket_init_default {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
 #define toothpaste_MouseJigglePacket_init_default {0}
-#define toothpaste_DataPacket_init_zero          {_toothpaste_DataPacket_PacketID_MIN, 0, 0, 0, {0, {0}}, 0, {0, {0}}, {0, {0}}}
+#define toothpaste_CompositePacket_init_default  {{{NULL}, NULL}}
+#define toothpaste_KeyboardLayoutPacket_init_default {_toothpaste_KeyboardLayoutPacket_LayoutID_MIN, {0, {0}}}
+#define toothpaste_CancelPacket_init_default     {0}
+#define toothpaste_PointerPacket_init_default    {0, 0, 0, 0, 0}
+#define toothpaste_DataPacket_init_zero          {_toothpaste_DataPacket_PacketID_MIN, 0, 0, 0, {0, {0}}, 0, {0, {0}}, {0, {0}}, _toothpaste_TypingProfile_MIN, 0, 0, {0, {0}}, 0}
 #define toothpaste_EncryptedData_init_zero       {_toothpaste_EncryptedData_PacketType_MIN, 0, {toothpaste_KeyboardPacket_init_zero}}
-#define toothpaste_ResponsePacket_init_zero      {_toothpaste_ResponsePacket_ResponseType_MIN, {0, {0}}, ""}
+#define toothpaste_ResponsePacket_init_zero      {_toothpaste_ResponsePacket_ResponseType_MIN, {0, {0}}, "", 0, 0, 0, 0, 0, 0, 0, 0}
 #define toothpaste_KeyboardPacket_init_zero      {"", 0}
 #define toothpaste_RenamePacket_init_zero        {"", 0}
 #define toothpaste_KeycodePacket_init_zero       {{0, {0}}, 0}
@@ -171,6 +258,10 @@ extern "C" {
 #define toothpaste_MousePacket_init_zero         {0, 0, {toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero, toothpaste_Frame_init_zero}, 0, 0, 0}
 #define toothpaste_ConsumerControlPacket_init_zero {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
 #define toothpaste_MouseJigglePacket_init_zero   {0}
+#define toothpaste_CompositePacket_init_zero     {{{NULL}, NULL}}
+#define toothpaste_KeyboardLayoutPacket_init_zero {_toothpaste_KeyboardLayoutPacket_LayoutID_MIN, {0, {0}}}
+#define toothpaste_CancelPacket_init_zero        {0}
+#define toothpaste_PointerPacket_init_zero       {0, 0, 0, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define toothpaste_DataPacket_packetID_tag       1
@@ -181,9 +272,22 @@ extern "C" {
 #define toothpaste_DataPacket_dataLen_tag        6
 #define toothpaste_DataPacket_encryptedData_tag  7
 #define toothpaste_DataPacket_tag_tag            8
+#define toothpaste_DataPacket_typingProfile_tag  9
+#define toothpaste_DataPacket_bulk_tag           10
+#define toothpaste_DataPacket_resume_tag         11
+#define toothpaste_DataPacket_resumeTicket_tag   12
+#define toothpaste_DataPacket_credits_tag        13
 #define toothpaste_ResponsePacket_responseType_tag 1
 #define toothpaste_ResponsePacket_challengeData_tag 2
 #define toothpaste_ResponsePacket_firmwareVersion_tag 3
+#define toothpaste_ResponsePacket_creditLimit_tag 4
+#define toothpaste_ResponsePacket_attMtu_tag 5
+#define toothpaste_ResponsePacket_maxPayload_tag 6
+#define toothpaste_ResponsePacket_phy_tag 7
+#define toothpaste_ResponsePacket_connInterval_tag 8
+#define toothpaste_ResponsePacket_resumed_tag    9
+#define toothpaste_ResponsePacket_bulkCreditLimit_tag 10
+#define toothpaste_ResponsePacket_absolutePointer_tag 11
 #define toothpaste_KeyboardPacket_message_tag    1
 #define toothpaste_KeyboardPacket_length_tag     2
 #define toothpaste_RenamePacket_message_tag      1
@@ -200,6 +304,15 @@ extern "C" {
 #define toothpaste_ConsumerControlPacket_code_tag 1
 #define toothpaste_ConsumerControlPacket_length_tag 2
 #define toothpaste_MouseJigglePacket_enable_tag  1
+#define toothpaste_CompositePacket_commands_tag  1
+#define toothpaste_KeyboardLayoutPacket_layout_tag 1
+#define toothpaste_KeyboardLayoutPacket_customTable_tag 2
+#define toothpaste_CancelPacket_mouse_tag        1
+#define toothpaste_PointerPacket_x_tag           1
+#define toothpaste_PointerPacket_y_tag           2
+#define toothpaste_PointerPacket_l_click_tag     3
+#define toothpaste_PointerPacket_r_click_tag     4
+#define toothpaste_PointerPacket_wheel_tag       5
 #define toothpaste_EncryptedData_packetType_tag  1
 #define toothpaste_EncryptedData_keyboardPacket_tag 2
 #define toothpaste_EncryptedData_keycodePacket_tag 3
@@ -207,6 +320,10 @@ extern "C" {
 #define toothpaste_EncryptedData_renamePacket_tag 5
 #define toothpaste_EncryptedData_consumerControlPacket_tag 6
 #define toothpaste_EncryptedData_mouseJigglePacket_tag 7
+#define toothpaste_EncryptedData_compositePacket_tag 8
+#define toothpaste_EncryptedData_keyboardLayoutPacket_tag 9
+#define toothpaste_EncryptedData_cancelPacket_tag 10
+#define toothpaste_EncryptedData_pointerPacket_tag 11
 
 /* Struct field encoding specification for nanopb */
 #define toothpaste_DataPacket_FIELDLIST(X, a) \
@@ -217,7 +334,12 @@ X(a, STATIC,   SINGULAR, BOOL,     slowMode,          4) \
 X(a, STATIC,   SINGULAR, BYTES,    iv,                5) \
 X(a, STATIC,   SINGULAR, UINT32,   dataLen,           6) \
 X(a, STATIC,   SINGULAR, BYTES,    encryptedData,     7) \
-X(a, STATIC,   SINGULAR, BYTES,    tag,               8)
+X(a, STATIC,   SINGULAR, BYTES,    tag,               8) \
+X(a, STATIC,   SINGULAR, UENUM,    typingProfile,     9) \
+X(a, STATIC,   SINGULAR, BOOL,     bulk,             10) \
+X(a, STATIC,   SINGULAR, BOOL,     resume,           11) \
+X(a, STATIC,   SINGULAR, BYTES,    resumeTicket,     12) \
+X(a, STATIC,   SINGULAR, UINT32,   credits,          13)
 #define toothpaste_DataPacket_CALLBACK NULL
 #define toothpaste_DataPacket_DEFAULT NULL
 
@@ -228,7 +350,11 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,keycodePacket,packetData.keycodeP
 X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,mousePacket,packetData.mousePacket),   4) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,renamePacket,packetData.renamePacket),   5) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,consumerControlPacket,packetData.consumerControlPacket),   6) \
-X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,mouseJigglePacket,packetData.mouseJigglePacket),   7)
+X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,mouseJigglePacket,packetData.mouseJigglePacket),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,compositePacket,packetData.compositePacket),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,keyboardLayoutPacket,packetData.keyboardLayoutPacket),   9) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,cancelPacket,packetData.cancelPacket),  10) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,pointerPacket,packetData.pointerPacket),  11)
 #define toothpaste_EncryptedData_CALLBACK NULL
 #define toothpaste_EncryptedData_DEFAULT NULL
 #define toothpaste_EncryptedData_packetData_keyboardPacket_MSGTYPE toothpaste_KeyboardPacket
@@ -237,11 +363,23 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (packetData,mouseJigglePacket,packetData.mous
 #define toothpaste_EncryptedData_packetData_renamePacket_MSGTYPE toothpaste_RenamePacket
 #define toothpaste_EncryptedData_packetData_consumerControlPacket_MSGTYPE toothpaste_ConsumerControlPacket
 #define toothpaste_EncryptedData_packetData_mouseJigglePacket_MSGTYPE toothpaste_MouseJigglePacket
+#define toothpaste_EncryptedData_packetData_compositePacket_MSGTYPE toothpaste_CompositePacket
+#define toothpaste_EncryptedData_packetData_keyboardLayoutPacket_MSGTYPE toothpaste_KeyboardLayoutPacket
+#define toothpaste_EncryptedData_packetData_cancelPacket_MSGTYPE toothpaste_CancelPacket
+#define toothpaste_EncryptedData_packetData_pointerPacket_MSGTYPE toothpaste_PointerPacket
 
 #define toothpaste_ResponsePacket_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UENUM,    responseType,      1) \
 X(a, STATIC,   SINGULAR, BYTES,    challengeData,     2) \
-X(a, STATIC,   SINGULAR, STRING,   firmwareVersion,   3)
+X(a, STATIC,   SINGULAR, STRING,   firmwareVersion,   3) \
+X(a, STATIC,   SINGULAR, UINT32,   creditLimit,       4) \
+X(a, STATIC,   SINGULAR, UINT32,   attMtu,            5) \
+X(a, STATIC,   SINGULAR, UINT32,   maxPayload,        6) \
+X(a, STATIC,   SINGULAR, UINT32,   phy,               7) \
+X(a, STATIC,   SINGULAR, UINT32,   connInterval,      8) \
+X(a, STATIC,   SINGULAR, BOOL,     resumed,           9) \
+X(a, STATIC,   SINGULAR, UINT32,   bulkCreditLimit,  10) \
+X(a, STATIC,   SINGULAR, BOOL,     absolutePointer,  11)
 #define toothpaste_ResponsePacket_CALLBACK NULL
 #define toothpaste_ResponsePacket_DEFAULT NULL
 
@@ -290,6 +428,32 @@ X(a, STATIC,   SINGULAR, BOOL,     enable,            1)
 #define toothpaste_MouseJigglePacket_CALLBACK NULL
 #define toothpaste_MouseJigglePacket_DEFAULT NULL
 
+#define toothpaste_CompositePacket_FIELDLIST(X, a) \
+X(a, CALLBACK, REPEATED, MESSAGE,  commands,          1)
+#define toothpaste_CompositePacket_CALLBACK pb_default_field_callback
+#define toothpaste_CompositePacket_DEFAULT NULL
+#define toothpaste_CompositePacket_commands_MSGTYPE toothpaste_EncryptedData
+
+#define toothpaste_KeyboardLayoutPacket_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    layout,            1) \
+X(a, STATIC,   SINGULAR, BYTES,    customTable,       2)
+#define toothpaste_KeyboardLayoutPacket_CALLBACK NULL
+#define toothpaste_KeyboardLayoutPacket_DEFAULT NULL
+
+#define toothpaste_CancelPacket_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, BOOL,     mouse,             1)
+#define toothpaste_CancelPacket_CALLBACK NULL
+#define toothpaste_CancelPacket_DEFAULT NULL
+
+#define toothpaste_PointerPacket_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   x,                 1) \
+X(a, STATIC,   SINGULAR, UINT32,   y,                 2) \
+X(a, STATIC,   SINGULAR, INT32,    l_click,           3) \
+X(a, STATIC,   SINGULAR, INT32,    r_click,           4) \
+X(a, STATIC,   SINGULAR, INT32,    wheel,             5)
+#define toothpaste_PointerPacket_CALLBACK NULL
+#define toothpaste_PointerPacket_DEFAULT NULL
+
 extern const pb_msgdesc_t toothpaste_DataPacket_msg;
 extern const pb_msgdesc_t toothpaste_EncryptedData_msg;
 extern const pb_msgdesc_t toothpaste_ResponsePacket_msg;
@@ -300,6 +464,10 @@ extern const pb_msgdesc_t toothpaste_Frame_msg;
 extern const pb_msgdesc_t toothpaste_MousePacket_msg;
 extern const pb_msgdesc_t toothpaste_ConsumerControlPacket_msg;
 extern const pb_msgdesc_t toothpaste_MouseJigglePacket_msg;
+extern const pb_msgdesc_t toothpaste_CompositePacket_msg;
+extern const pb_msgdesc_t toothpaste_KeyboardLayoutPacket_msg;
+extern const pb_msgdesc_t toothpaste_CancelPacket_msg;
+extern const pb_msgdesc_t toothpaste_PointerPacket_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define toothpaste_DataPacket_fields &toothpaste_DataPacket_msg
@@ -312,19 +480,27 @@ extern const pb_msgdesc_t toothpaste_MouseJigglePacket_msg;
 #define toothpaste_MousePacket_fields &toothpaste_MousePacket_msg
 #define toothpaste_ConsumerControlPacket_fields &toothpaste_ConsumerControlPacket_msg
 #define toothpaste_MouseJigglePacket_fields &toothpaste_MouseJigglePacket_msg
+#define toothpaste_CompositePacket_fields &toothpaste_CompositePacket_msg
+#define toothpaste_KeyboardLayoutPacket_fields &toothpaste_KeyboardLayoutPacket_msg
+#define toothpaste_CancelPacket_fields &toothpaste_CancelPacket_msg
+#define toothpaste_PointerPacket_fields &toothpaste_PointerPacket_msg
 
 /* Maximum encoded size of messages (where known) */
-#define TOOTHPASTE_TOOTHPACKET_PB_H_MAX_SIZE     toothpaste_EncryptedData_size
+/* toothpaste_EncryptedData_size depends on runtime parameters */
+/* toothpaste_CompositePacket_size depends on runtime parameters */
+#define TOOTHPASTE_TOOTHPACKET_PB_H_MAX_SIZE     toothpaste_MousePacket_size
+#define toothpaste_CancelPacket_size             2
 #define toothpaste_ConsumerControlPacket_size    66
-#define toothpaste_DataPacket_size               257
-#define toothpaste_EncryptedData_size            524
+#define toothpaste_DataPacket_size               279
 #define toothpaste_Frame_size                    22
+#define toothpaste_KeyboardLayoutPacket_size     133
 #define toothpaste_KeyboardPacket_size           198
 #define toothpaste_KeycodePacket_size            199
 #define toothpaste_MouseJigglePacket_size        2
 #define toothpaste_MousePacket_size              519
+#define toothpaste_PointerPacket_size            45
 #define toothpaste_RenamePacket_size             198
-#define toothpaste_ResponsePacket_size           206
+#define toothpaste_ResponsePacket_size           246
 
 #ifdef __cplusplus
 } /* extern "C" */
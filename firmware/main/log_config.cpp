@@ -15,7 +15,11 @@ void configure_log_levels()
     esp_log_level_set("BLE",          ESP_LOG_VERBOSE);
     esp_log_level_set("BLE_AUTH",     ESP_LOG_VERBOSE);
     esp_log_level_set("BLE_TASK",     ESP_LOG_VERBOSE);
+    esp_log_level_set("BLE_FLOW",     ESP_LOG_VERBOSE);
+    esp_log_level_set("PIPELINE",     ESP_LOG_VERBOSE);
+    esp_log_level_set("IDFHID",       ESP_LOG_VERBOSE);
     esp_log_level_set("SESSION",      ESP_LOG_VERBOSE);
+    esp_log_level_set("CRYPTO_BENCH", ESP_LOG_VERBOSE);
     esp_log_level_set("HWUI",         ESP_LOG_VERBOSE);
     esp_log_level_set("STATE",        ESP_LOG_VERBOSE);
     esp_log_level_set("hid_keyboard", ESP_LOG_VERBOSE);
@@ -27,11 +31,15 @@ void configure_log_levels()
     esp_log_level_set("MAIN",         ESP_LOG_INFO);
     esp_log_level_set("BLE",          ESP_LOG_INFO);
     esp_log_level_set("BLE_TASK",     ESP_LOG_INFO);
+    esp_log_level_set("BLE_FLOW",     ESP_LOG_INFO);
+    esp_log_level_set("PIPELINE",     ESP_LOG_INFO);
+    esp_log_level_set("IDFHID",       ESP_LOG_INFO);
     esp_log_level_set("HWUI",         ESP_LOG_INFO);
     esp_log_level_set("STATE",        ESP_LOG_INFO);
     esp_log_level_set("hid_keyboard", ESP_LOG_INFO);
     esp_log_level_set("SESSION",      ESP_LOG_ERROR);
     esp_log_level_set("BLE_AUTH",     ESP_LOG_ERROR);
+    esp_log_level_set("CRYPTO_BENCH", ESP_LOG_INFO);
 
 #elif defined(LOG_BUILD_PROD)
     // Errors only across the board.
@@ -40,6 +48,9 @@ void configure_log_levels()
     esp_log_level_set("BLE",          ESP_LOG_ERROR);
     esp_log_level_set("BLE_AUTH",     ESP_LOG_ERROR);
     esp_log_level_set("BLE_TASK",     ESP_LOG_ERROR);
+    esp_log_level_set("BLE_FLOW",     ESP_LOG_ERROR);
+    esp_log_level_set("PIPELINE",     ESP_LOG_ERROR);
+    esp_log_level_set("IDFHID",       ESP_LOG_ERROR);
     esp_log_level_set("SESSION",      ESP_LOG_ERROR);
     esp_log_level_set("HWUI",         ESP_LOG_ERROR);
     esp_log_level_set("STATE",        ESP_LOG_ERROR);
@@ -38,6 +38,11 @@ extern "C" void app_main() {
     bleSetup(&sec);      // BLE device with secure session
     sec.init();          // Secure session
 
+#ifdef CONFIG_TOOTHPASTE_CRYPTO_BENCHMARK
+    runCipherBenchmark();
+    runCompositeBenchmark();
+#endif
+
     // Register button callbacks — any component can call registerButtonCallback() to hook in
 
     // Single press callback
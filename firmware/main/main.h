@@ -1,6 +1,8 @@
 
 #include "NeoPixelRMT.h"
 #include "SecureSession.h"
+#include "CipherBenchmark.h"
+#include "CompositeBenchmark.h"
 #include "hwUI.h"
 #include "StateManager.h"
 
@@ -0,0 +1,182 @@
+// Counts heap allocations made by SecureSession's reconnect path on the task that runs it,
+// as the crypto worker does: peerLabel(), hkdf_sha256(), resumeIfTicketed() and
+// loadIfEnrolled() must make none. mbedTLS / PSA allocations come from the handshake
+// arena once the task is bound, which the heap hooks do not see.
+#include <Arduino.h>
+#include <Preferences.h>
+#include <string.h>
+#include <esp_attr.h>
+#include <nvs_flash.h>
+#include <psa/crypto.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/md.h>
+#include <unity.h>
+
+#include "SecureSession.h"
+
+// Heap allocations made by the task under test while counting is on
+static TaskHandle_t volatile countedTask = nullptr;
+static volatile uint32_t countedAllocs = 0;
+
+extern "C" IRAM_ATTR void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps)
+{
+    if (countedTask != nullptr && xTaskGetCurrentTaskHandle() == countedTask) countedAllocs++;
+}
+
+extern "C" IRAM_ATTR void esp_heap_trace_free_hook(void* ptr)
+{
+}
+
+static void startCounting()
+{
+    countedAllocs = 0;
+    countedTask = xTaskGetCurrentTaskHandle();
+}
+
+static uint32_t stopCounting()
+{
+    countedTask = nullptr;
+    return countedAllocs;
+}
+
+// One session with a client that has paired and holds a resumption ticket
+static SecureSession* session = nullptr;
+static uint8_t clientKey[65];                   // Uncompressed P-256 point, as AUTH carries it
+static char clientB64[70];                      // Truncated like CryptoWorker::Request::base64pubKey
+static uint8_t ticketId[SecureSession::TICKET_ID_SIZE];
+
+// The client side of the ticket ID: HKDF-SHA256(salt = 0, ticket secret, "toothpaste-ticket-id")
+static void deriveTicketId(const uint8_t secret[SecureSession::ENC_KEYSIZE], uint8_t out[SecureSession::TICKET_ID_SIZE])
+{
+    static const uint8_t info[] = "toothpaste-ticket-id";
+    const mbedtls_md_info_t* sha256 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    uint8_t salt[32] = {0};
+    uint8_t prk[32];
+    uint8_t t[32];
+    uint8_t counter = 1;
+
+    TEST_ASSERT_EQUAL(0, mbedtls_md_hmac(sha256, salt, sizeof(salt), secret, SecureSession::ENC_KEYSIZE, prk));
+
+    mbedtls_md_context_t ctx;
+    mbedtls_md_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_md_setup(&ctx, sha256, 1));
+    TEST_ASSERT_EQUAL(0, mbedtls_md_hmac_starts(&ctx, prk, sizeof(prk)));
+    TEST_ASSERT_EQUAL(0, mbedtls_md_hmac_update(&ctx, info, sizeof(info) - 1));
+    TEST_ASSERT_EQUAL(0, mbedtls_md_hmac_update(&ctx, &counter, 1));
+    TEST_ASSERT_EQUAL(0, mbedtls_md_hmac_finish(&ctx, t));
+    mbedtls_md_free(&ctx);
+    memcpy(out, t, SecureSession::TICKET_ID_SIZE);
+}
+
+// The peer's NVS label: the first 12 hex digits of MD5(base64 key)
+static void labelFor(const char* base64, char label[SlotManager::LABEL_LEN + 1])
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    uint8_t hash[16];
+    TEST_ASSERT_EQUAL(0, mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_MD5),
+                                    (const unsigned char*)base64, strlen(base64), hash));
+    for (size_t i = 0; i < SlotManager::LABEL_LEN / 2; i++) {
+        label[i * 2] = HEX_DIGITS[hash[i] >> 4];
+        label[i * 2 + 1] = HEX_DIGITS[hash[i] & 0x0f];
+    }
+    label[SlotManager::LABEL_LEN] = '\0';
+}
+
+// Pair a fresh client through the real handshake and read back the ticket it was issued.
+// Runs once; setup allocates freely, only the calls under test are counted.
+static void pairClient()
+{
+    if (session != nullptr) return;
+
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_erase());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+    session = new SecureSession();
+    TEST_ASSERT_EQUAL(0, session->init());
+    SecureSession::bindHandshakeTask(xTaskGetCurrentTaskHandle());
+
+    uint8_t devicePub[SecureSession::PUBKEY_SIZE];
+    size_t devicePubLen = 0;
+    TEST_ASSERT_EQUAL(0, session->generateKeypair(devicePub, devicePubLen));
+
+    psa_key_attributes_t attrs = PSA_KEY_ATTRIBUTES_INIT;
+    psa_set_key_type(&attrs, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attrs, 256);
+    psa_set_key_usage_flags(&attrs, PSA_KEY_USAGE_DERIVE);
+    psa_set_key_algorithm(&attrs, PSA_ALG_ECDH);
+    psa_key_id_t client = 0;
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, psa_generate_key(&attrs, &client));
+    size_t keyLen = 0;
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, psa_export_public_key(client, clientKey, sizeof(clientKey), &keyLen));
+    TEST_ASSERT_EQUAL(sizeof(clientKey), keyLen);
+    psa_destroy_key(client);
+
+    char full[100];
+    size_t b64Len = 0;
+    TEST_ASSERT_EQUAL(0, mbedtls_base64_encode((unsigned char*)full, sizeof(full), &b64Len, clientKey, keyLen));
+    memcpy(clientB64, full, sizeof(clientB64) - 1);
+    clientB64[sizeof(clientB64) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL(0, session->computeSharedSecret(clientKey, keyLen, clientB64));
+    TEST_ASSERT_EQUAL(0, session->issueResumeTicket(clientB64));
+    session->persistPeerOrder();
+
+    char label[SlotManager::LABEL_LEN + 1];
+    labelFor(clientB64, label);
+    uint8_t record[SecureSession::ENC_KEYSIZE + 1];
+    Preferences tickets;
+    tickets.begin("resume", true);
+    TEST_ASSERT_EQUAL(sizeof(record), tickets.getBytes(label, record, sizeof(record)));
+    tickets.end();
+    deriveTicketId(record, ticketId);
+}
+
+TEST_CASE("loadIfEnrolled makes no heap allocations", "[handshake]")
+{
+    pairClient();
+    startCounting();
+    bool loaded = session->loadIfEnrolled(clientKey, sizeof(clientKey), clientB64);
+    uint32_t allocs = stopCounting();
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_EQUAL_UINT32(0, allocs);
+}
+
+TEST_CASE("resumeIfTicketed makes no heap allocations", "[handshake]")
+{
+    pairClient();
+    startCounting();
+    bool resumed = session->resumeIfTicketed(clientB64, ticketId, sizeof(ticketId));
+    uint32_t allocs = stopCounting();
+    TEST_ASSERT_TRUE(resumed);
+    TEST_ASSERT_TRUE(session->isSessionKeyReady());
+    TEST_ASSERT_EQUAL_UINT32(0, allocs);
+}
+
+// A stale ticket ID still runs peerLabel() and the hkdf_sha256() that derives the stored ID
+TEST_CASE("rejected ticket makes no heap allocations", "[handshake]")
+{
+    pairClient();
+    uint8_t wrongId[SecureSession::TICKET_ID_SIZE];
+    memcpy(wrongId, ticketId, sizeof(wrongId));
+    wrongId[0] ^= 0x01;
+
+    startCounting();
+    bool resumed = session->resumeIfTicketed(clientB64, wrongId, sizeof(wrongId));
+    uint32_t allocs = stopCounting();
+    TEST_ASSERT_FALSE(resumed);
+    TEST_ASSERT_EQUAL_UINT32(0, allocs);
+}
+
+// An unknown key misses the label cache, so peerLabel() hashes it with MD5
+TEST_CASE("unknown peer makes no heap allocations", "[handshake]")
+{
+    pairClient();
+    char stranger[sizeof(clientB64)];
+    memcpy(stranger, clientB64, sizeof(stranger));
+    stranger[10] = stranger[10] == 'A' ? 'B' : 'A';
+
+    startCounting();
+    bool loaded = session->loadIfEnrolled(clientKey, sizeof(clientKey), stranger);
+    uint32_t allocs = stopCounting();
+    TEST_ASSERT_FALSE(loaded);
+    TEST_ASSERT_EQUAL_UINT32(0, allocs);
+}
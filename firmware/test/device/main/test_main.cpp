@@ -0,0 +1,10 @@
+#include <Arduino.h>
+#include <unity.h>
+
+extern "C" void app_main()
+{
+    initArduino();
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    UNITY_END();
+}
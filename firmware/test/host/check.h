@@ -0,0 +1,28 @@
+#pragma once
+#include <stdio.h>
+
+// Minimal assertions for the host tests: failures are counted and reported, and main()
+// returns checkResult() so ctest sees a non-zero exit code.
+static int checkFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        checkFailures++; \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        checkFailures++; \
+        printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+    } \
+} while (0)
+
+static inline int checkResult(const char* suite)
+{
+    if (checkFailures == 0) printf("%s: all checks passed\n", suite);
+    else printf("%s: %d check(s) failed\n", suite, checkFailures);
+    return checkFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+#pragma once
+// Host stand-in for the Arduino core: only what the pure-logic modules under test include it for
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+// Host stand-in for esp_log: messages are format-checked and dropped
+__attribute__((format(printf, 2, 3))) static inline void hostLogDiscard(const char*, const char*, ...) {}
+
+#define ESP_LOGE(tag, ...) hostLogDiscard(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) hostLogDiscard(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) hostLogDiscard(tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) hostLogDiscard(tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) hostLogDiscard(tag, __VA_ARGS__)
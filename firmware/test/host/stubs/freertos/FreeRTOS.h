@@ -0,0 +1,15 @@
+#pragma once
+// Host stand-in for FreeRTOS: tasks are std::threads and queues are mutex-guarded FIFOs, for
+// modules that only hand items between tasks. Ticks are milliseconds, as CONFIG_FREERTOS_HZ=1000.
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE             0
+#define pdTRUE              1
+#define pdPASS              pdTRUE
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
@@ -0,0 +1,57 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct HostQueue {
+    size_t length;
+    size_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+typedef HostQueue* QueueHandle_t;
+
+// Wait on the queue until ready() holds or `wait` ticks pass
+template <typename Ready>
+static inline bool hostQueueWait(HostQueue* q, std::unique_lock<std::mutex>& held, TickType_t wait, Ready ready)
+{
+    if (wait == portMAX_DELAY) {
+        q->changed.wait(held, ready);
+        return true;
+    }
+    return q->changed.wait_for(held, std::chrono::milliseconds(wait), ready);
+}
+
+static inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    HostQueue* q = new HostQueue();  // Never freed: a worker task may still be waiting on it at exit
+    q->length = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+static inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> held(q->lock);
+    if (!hostQueueWait(q, held, wait, [q] { return q->items.size() < q->length; })) return pdFALSE;
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    q->items.emplace_back(bytes, bytes + q->itemSize);
+    q->changed.notify_all();
+    return pdTRUE;
+}
+
+static inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> held(q->lock);
+    if (!hostQueueWait(q, held, wait, [q] { return !q->items.empty(); })) return pdFALSE;
+    memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    q->changed.notify_all();
+    return pdTRUE;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+#include <thread>
+
+struct HostTask {
+    std::thread::id id;
+};
+typedef HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+// Runs the task on a detached thread; name, stack, priority and core are ignored
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* arg,
+                                                 UBaseType_t, TaskHandle_t* created, BaseType_t)
+{
+    std::thread thread(fn, arg);
+    HostTask* task = new HostTask{thread.get_id()};
+    thread.detach();
+    if (created != nullptr) *created = task;
+    return pdPASS;
+}
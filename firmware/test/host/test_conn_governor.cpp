@@ -0,0 +1,153 @@
+// Replays simulated packet traces through ConnGovernor the way packetTask drives it:
+// onPacket() per arrival, onTick() after every BLE_FLOW_POLL_MS without one.
+#include "ConnGovernor.h"
+#include "check.h"
+
+#include <vector>
+
+static constexpr int64_t POLL_US = 20000; // BLE_FLOW_POLL_MS
+static constexpr int64_t MS = 1000;
+
+struct Change {
+    int64_t atUs;
+    ConnGovernor::Profile profile;
+};
+
+// Feed packet arrivals (sorted, us) and idle polls up to endUs; returns each profile request
+static std::vector<Change> replay(const std::vector<int64_t>& arrivals, int64_t endUs)
+{
+    ConnGovernor governor;
+    governor.reset(0);
+    std::vector<Change> changes;
+
+    int64_t now = 0;
+    size_t next = 0;
+    while (now < endUs) {
+        if (next < arrivals.size() && arrivals[next] <= now + POLL_US) {
+            now = arrivals[next++];
+            if (governor.onPacket(now)) changes.push_back({now, governor.profile()});
+        }
+        else {
+            now += POLL_US;
+            if (governor.onTick(now)) changes.push_back({now, governor.profile()});
+        }
+    }
+    return changes;
+}
+
+// Packets every periodUs from startUs, count of them
+static void addRun(std::vector<int64_t>& trace, int64_t startUs, int64_t periodUs, int count)
+{
+    for (int i = 0; i < count; i++) trace.push_back(startUs + i * periodUs);
+}
+
+// Live typing: one packet per keystroke at ~8 keys/s goes active on the third key and
+// relaxes QUIET_US after the last one, with exactly two requests to the central
+static void testTypingBurst()
+{
+    std::vector<int64_t> trace;
+    addRun(trace, 1000 * MS, 120 * MS, 40);
+    int64_t last = trace.back();
+
+    std::vector<Change> changes = replay(trace, last + 5000 * MS);
+    CHECK_EQ(changes.size(), 2);
+    if (changes.size() != 2) return;
+
+    CHECK_EQ(changes[0].profile, ConnGovernor::ACTIVE);
+    CHECK_EQ(changes[0].atUs, trace[2]);
+    CHECK_EQ(changes[1].profile, ConnGovernor::IDLE);
+    CHECK(changes[1].atUs >= last + ConnGovernor::QUIET_US);
+    CHECK(changes[1].atUs < last + ConnGovernor::QUIET_US + POLL_US);
+}
+
+// Sparse traffic (a packet every 400 ms, e.g. a slow jiggle or keepalive) never counts as a
+// burst; the first quiet stretch settles the link on the idle profile once
+static void testSparseTrafficStaysIdle()
+{
+    std::vector<int64_t> trace;
+    addRun(trace, 4000 * MS, 400 * MS, 20);
+
+    std::vector<Change> changes = replay(trace, trace.back() + 4000 * MS);
+    CHECK_EQ(changes.size(), 1);
+    if (changes.size() != 1) return;
+    CHECK_EQ(changes[0].profile, ConnGovernor::IDLE);
+    CHECK(changes[0].atUs >= ConnGovernor::QUIET_US);
+}
+
+// Pauses shorter than QUIET_US between bursts keep the active profile: no flapping
+static void testShortPausesDoNotFlap()
+{
+    std::vector<int64_t> trace;
+    int64_t start = 500 * MS;
+    for (int burst = 0; burst < 5; burst++) {
+        addRun(trace, start, 50 * MS, 10);
+        start = trace.back() + 2500 * MS;
+    }
+
+    std::vector<Change> changes = replay(trace, trace.back() + 4000 * MS);
+    CHECK_EQ(changes.size(), 2);
+    if (changes.size() != 2) return;
+    CHECK_EQ(changes[0].profile, ConnGovernor::ACTIVE);
+    CHECK_EQ(changes[1].profile, ConnGovernor::IDLE);
+    CHECK(changes[1].atUs >= trace.back() + ConnGovernor::QUIET_US);
+}
+
+// Bursts separated by long quiet gaps go active and idle once per burst
+static void testBurstsAfterQuiet()
+{
+    std::vector<int64_t> trace;
+    addRun(trace, 200 * MS, 10 * MS, 30);   // paste
+    addRun(trace, 6000 * MS, 100 * MS, 5);  // a few keys
+    addRun(trace, 12000 * MS, 100 * MS, 2); // two keys: not a burst
+
+    std::vector<Change> changes = replay(trace, 16000 * MS);
+    CHECK_EQ(changes.size(), 4);
+    if (changes.size() != 4) return;
+    CHECK_EQ(changes[0].profile, ConnGovernor::ACTIVE);
+    CHECK_EQ(changes[0].atUs, 220 * MS);
+    CHECK_EQ(changes[1].profile, ConnGovernor::IDLE);
+    CHECK_EQ(changes[2].profile, ConnGovernor::ACTIVE);
+    CHECK_EQ(changes[2].atUs, 6200 * MS);
+    CHECK_EQ(changes[3].profile, ConnGovernor::IDLE);
+    CHECK(changes[3].atUs < 12000 * MS);
+}
+
+// Three packets spread just past BURST_WINDOW_US are not a burst; just inside, they are
+static void testBurstWindowBoundary()
+{
+    int64_t step = ConnGovernor::BURST_WINDOW_US / 2;
+    std::vector<int64_t> inside = { 100 * MS, 100 * MS + step, 100 * MS + 2 * step };
+    std::vector<Change> changes = replay(inside, 1000 * MS);
+    CHECK_EQ(changes.size(), 1);
+    if (!changes.empty()) CHECK_EQ(changes[0].profile, ConnGovernor::ACTIVE);
+
+    std::vector<int64_t> outside = { 100 * MS, 100 * MS + step, 100 * MS + 2 * step + 1 };
+    changes = replay(outside, 1000 * MS);
+    CHECK_EQ(changes.size(), 0);
+}
+
+// A reconnect forgets history: two packets before reset and one after are no burst
+static void testResetForgetsHistory()
+{
+    ConnGovernor governor;
+    governor.reset(0);
+    CHECK(!governor.onPacket(10 * MS));
+    CHECK(!governor.onPacket(20 * MS));
+    governor.reset(30 * MS);
+    CHECK_EQ(governor.profile(), ConnGovernor::NONE);
+    CHECK(!governor.onPacket(40 * MS));
+    CHECK(!governor.onPacket(50 * MS));
+    CHECK(governor.onPacket(60 * MS));
+    CHECK_EQ(governor.profile(), ConnGovernor::ACTIVE);
+}
+
+int main()
+{
+    testTypingBurst();
+    testSparseTrafficStaysIdle();
+    testShortPausesDoNotFlap();
+    testBurstsAfterQuiet();
+    testBurstWindowBoundary();
+    testResetForgetsHistory();
+    return checkResult("ConnGovernor");
+}
@@ -0,0 +1,153 @@
+// Replays AUTH handshakes through CryptoWorker and MockCryptoBackend on the host. The mock's
+// ECDH and HKDF latencies stand in for the real crypto, so the worker's own queue wait and
+// the backend time it reports can be checked (and printed) in isolation. Also covers a link
+// that closes mid-handshake: its completion is stale and issues no ticket.
+#include "CryptoWorker.h"
+#include "MockCryptoBackend.h"
+#include "PipelineStats.h"
+#include "check.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static constexpr uint32_t ECDH_US = 20000;
+static constexpr uint32_t HKDF_US = 1000;
+static constexpr TickType_t RESULT_WAIT = pdMS_TO_TICKS(2000);
+
+// PipelineStats stand-in: the worker's clock and the crypto stage samples
+static const auto epoch = std::chrono::steady_clock::now();
+static std::atomic<uint32_t> stageSamples[STAGE_COUNT];
+
+uint32_t pipelineNowUs()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void pipelineRecord(PipelineStage stage, uint32_t)
+{
+    stageSamples[stage]++;
+}
+
+static std::atomic<int> wakes{0};
+static void wake() { wakes++; }
+
+static MockCryptoBackend backend(ECDH_US, HKDF_US);
+static CryptoWorker worker;
+
+static CryptoWorker::Request reconnectRequest(bool withTicket)
+{
+    CryptoWorker::Request request = {};
+    request.kind = CryptoWorker::RECONNECT;
+    request.resume = true;
+    request.peerKeyLen = CryptoWorker::PEER_KEY_MAX;
+    strcpy(request.base64pubKey, "BAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA");
+    if (withTicket) {
+        memset(request.ticketId, 0x5a, sizeof(request.ticketId));
+        request.ticketIdLen = sizeof(request.ticketId);
+    }
+    return request;
+}
+
+// Wait for the work the worker does after posting a completion (ticket, persist)
+static bool waitFor(uint32_t persists)
+{
+    for (int i = 0; i < 2000 && backend.persists() < persists; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return backend.persists() >= persists;
+}
+
+static CryptoWorker::Result run(CryptoWorker::Request request)
+{
+    CryptoWorker::Result result = {};
+    CHECK(!worker.busy());
+    worker.submit(request);
+    CHECK(worker.busy());
+    CHECK(worker.poll(&result, RESULT_WAIT));
+    CHECK(!worker.busy());
+    CHECK(!worker.stale(result));
+    return result;
+}
+
+static void report(const char* path, const CryptoWorker::Result& result)
+{
+    printf("  %-14s queued %5lu us, backend %6lu us\n", path, (unsigned long)result.waitUs,
+           (unsigned long)result.runUs);
+}
+
+// A first reconnect runs ECDH and earns a ticket; the next one is keyed from it
+static void testReconnectThenResume()
+{
+    CryptoWorker::Result ecdh = run(reconnectRequest(false));
+    CHECK(ecdh.ok);
+    CHECK(!ecdh.resumed);
+    CHECK(ecdh.runUs >= ECDH_US);
+    report("reconnect/ECDH", ecdh);
+    CHECK(waitFor(1));
+    CHECK(backend.ticketed());
+
+    CryptoWorker::Result ticket = run(reconnectRequest(true));
+    CHECK(ticket.ok);
+    CHECK(ticket.resumed);
+    CHECK(ticket.runUs >= HKDF_US && ticket.runUs < ECDH_US);
+    CHECK(memcmp(ticket.salt, ecdh.salt, sizeof(ticket.salt)) != 0);   // Every session gets a new salt
+    report("reconnect/ticket", ticket);
+    CHECK(waitFor(2));
+
+    CHECK(stageSamples[STAGE_CRYPTO_WAIT] == 2);
+    CHECK(stageSamples[STAGE_CRYPTO_OUT] == 2);
+    CHECK(wakes == 2);
+}
+
+// A refused handshake is answered but persists nothing
+static void testRejected()
+{
+    backend.setAccept(false);
+    uint32_t persists = backend.persists();
+    CryptoWorker::Result result = run(reconnectRequest(false));
+    CHECK(!result.ok);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK_EQ(backend.persists(), persists);
+    backend.setAccept(true);
+}
+
+// The client disconnects while ECDH runs: the completion still arrives, marked stale, and no
+// ticket is issued for it. The next link's handshake runs normally.
+static void testLinkClosedMidHandshake()
+{
+    uint32_t persists = backend.persists();
+    uint32_t calls = backend.calls();
+
+    CryptoWorker::Request request = reconnectRequest(false);
+    worker.submit(request);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    worker.newLink();   // onDisconnect()
+    CHECK(worker.busyWithOldLink());
+    worker.newLink();   // onConnect() of the next client
+
+    CryptoWorker::Result stale = {};
+    CHECK(worker.poll(&stale, RESULT_WAIT));
+    CHECK(worker.stale(stale));
+    CHECK(!worker.busy());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK_EQ(backend.persists(), persists);
+    CHECK_EQ(backend.calls(), calls + 1);   // The ECDH, no issueTicket()
+
+    CryptoWorker::Result next = run(reconnectRequest(false));
+    CHECK(next.ok);
+    CHECK(waitFor(persists + 1));
+}
+
+int main()
+{
+    CHECK(worker.begin(&backend, wake, 2, 0));
+    printf("CryptoWorker with mock ECDH %lu us, HKDF %lu us:\n", (unsigned long)ECDH_US, (unsigned long)HKDF_US);
+    testReconnectThenResume();
+    testRejected();
+    testLinkClosedMidHandshake();
+    return checkResult("CryptoWorker");
+}
@@ -0,0 +1,233 @@
+// Checks HandshakeArena as SecureSession uses it: behind a calloc/free shim that hands the
+// arena's allocations to mbedTLS and counts every one that falls through to the system
+// heap. A replayed handshake allocation pattern (bignums growing limb by limb, an imported
+// key, a session cipher that outlives the handshake) must never reach the heap.
+#include "HandshakeArena.h"
+#include "check.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+static constexpr size_t ARENA_SIZE = 8192;  // CONFIG_TOOTHPASTE_HANDSHAKE_ARENA_SIZE default
+alignas(8) static uint8_t arenaBuffer[ARENA_SIZE];
+static HandshakeArena arena(arenaBuffer, sizeof(arenaBuffer));
+
+// The shim mbedtls_platform_set_calloc_free() gets: arena first, heap (counted) when full
+static int heapAllocs = 0;
+
+static void* shimCalloc(size_t n, size_t size)
+{
+    void* p = arena.allocate(n, size);
+    if (p != nullptr) return p;
+    heapAllocs++;
+    return calloc(n, size);
+}
+
+static void shimFree(void* p)
+{
+    if (p != nullptr && !arena.release(p)) free(p);
+}
+
+static bool allZero(const void* p, size_t len)
+{
+    const uint8_t* b = (const uint8_t*)p;
+    for (size_t i = 0; i < len; i++) if (b[i] != 0) return false;
+    return true;
+}
+
+static void testZeroedAndAligned()
+{
+    for (size_t size : {1, 7, 8, 9, 31, 32, 33, 100, 255}) {
+        uint8_t* p = (uint8_t*)arena.allocate(1, size);
+        CHECK(p != nullptr);
+        if (p == nullptr) continue;
+        CHECK_EQ((uintptr_t)p % HandshakeArena::ALIGN, 0);
+        CHECK(allZero(p, size));
+        memset(p, 0xA5, size);
+        CHECK(arena.release(p));
+
+        // The same block comes back zeroed, not with the last owner's bytes
+        uint8_t* again = (uint8_t*)arena.allocate(size, 1);
+        CHECK(again == p);
+        if (again != nullptr) CHECK(allZero(again, size));
+        arena.release(again);
+    }
+    CHECK_EQ(arena.used(), 0);
+}
+
+// Exhaust the arena, then free everything: the merged free space serves one block again
+static void testExhaustionAndMerge()
+{
+    std::vector<void*> blocks;
+    void* p;
+    while ((p = arena.allocate(1, 24)) != nullptr) blocks.push_back(p);
+    CHECK(blocks.size() > ARENA_SIZE / 64);
+    CHECK(arena.allocate(1, 1) == nullptr);
+
+    // Free every other block: lots of room, none of it contiguous
+    for (size_t i = 0; i < blocks.size(); i += 2) arena.release(blocks[i]);
+    CHECK(arena.allocate(1, 64) == nullptr);
+    for (size_t i = 1; i < blocks.size(); i += 2) arena.release(blocks[i]);
+    CHECK_EQ(arena.used(), 0);
+
+    void* whole = arena.allocate(1, ARENA_SIZE - 8);
+    CHECK(whole != nullptr);
+    arena.release(whole);
+    CHECK(arena.allocate(1, ARENA_SIZE) == nullptr);
+}
+
+static void testEdgeCases()
+{
+    // calloc(0) and overflowing counts
+    void* empty = arena.allocate(0, 16);
+    void* empty2 = arena.allocate(16, 0);
+    CHECK(empty != nullptr && empty2 != nullptr && empty != empty2);
+    arena.release(empty);
+    arena.release(empty2);
+    CHECK(arena.allocate(SIZE_MAX / 2, 4) == nullptr);
+
+    // Foreign pointers are left to the heap; a second release changes nothing
+    int onStack = 0;
+    CHECK(!arena.release(&onStack));
+    CHECK(!arena.release(nullptr));
+    CHECK(!arena.owns(arenaBuffer + ARENA_SIZE));
+    void* p = arena.allocate(1, 40);
+    size_t used = arena.used();
+    CHECK(arena.release(p));
+    CHECK(arena.release(p));
+    CHECK_EQ(arena.used(), used - 48);
+
+    // A buffer too small for one block owns nothing
+    uint8_t tiny[12];
+    HandshakeArena none(tiny, sizeof(tiny));
+    CHECK_EQ(none.capacity(), 0);
+    CHECK(none.allocate(1, 1) == nullptr);
+    CHECK(!none.owns(tiny + 8));
+}
+
+// Random lifetimes: live blocks never overlap and keep their contents
+static void testRandomLifetimes()
+{
+    struct Live {
+        uint8_t* p;
+        size_t len;
+        uint8_t fill;
+    };
+    std::vector<Live> live;
+    srand(7);
+    for (int step = 0; step < 20000; step++) {
+        if (live.size() < 40 && rand() % 3 != 0) {
+            size_t len = 1 + rand() % 300;
+            uint8_t* p = (uint8_t*)arena.allocate(1, len);
+            if (p == nullptr) continue;
+            CHECK(allZero(p, len));
+            uint8_t fill = (uint8_t)(1 + rand() % 255);
+            memset(p, fill, len);
+            live.push_back({p, len, fill});
+        }
+        else if (!live.empty()) {
+            size_t i = rand() % live.size();
+            bool intact = true;
+            for (size_t j = 0; j < live[i].len; j++) intact = intact && live[i].p[j] == live[i].fill;
+            CHECK(intact);
+            arena.release(live[i].p);
+            live.erase(live.begin() + i);
+        }
+    }
+    for (Live& l : live) arena.release(l.p);
+    CHECK_EQ(arena.used(), 0);
+}
+
+// A P-256 bignum grows limb by limb the way mbedtls_mpi_grow() does it: allocate the new
+// size, copy, free the old
+struct Mpi {
+    uint64_t* limbs = nullptr;
+    size_t n = 0;
+
+    void grow(size_t want)
+    {
+        if (want <= n) return;
+        uint64_t* bigger = (uint64_t*)shimCalloc(want, sizeof(uint64_t));
+        if (limbs != nullptr) {
+            memcpy(bigger, limbs, n * sizeof(uint64_t));
+            shimFree(limbs);
+        }
+        limbs = bigger;
+        n = want;
+    }
+
+    void clear()
+    {
+        shimFree(limbs);
+        limbs = nullptr;
+        n = 0;
+    }
+};
+
+// One reconnect: import the stored private key, load the curve, run a comb multiplication
+// with scratch bignums, drop it all, and key the session cipher over the previous one
+static void replayHandshake(void** cipherCtx)
+{
+    void* keyMaterial = shimCalloc(1, 32);    // psa_import_key()
+    void* keypair = shimCalloc(1, 232);       // mbedtls_ecp_keypair for the agreement
+
+    Mpi group[12];                            // Curve parameters and the peer point
+    for (int limb = 1; limb <= 4; limb++) {
+        for (Mpi& m : group) m.grow(limb);
+    }
+
+    Mpi comb[8 * 3];                          // Precomputed points, X/Y/Z each
+    Mpi scratch[6];
+    for (int round = 0; round < 64; round++) {
+        Mpi& t = scratch[round % 6];
+        t.grow(1 + round % 9);                // Products run to twice the limbs
+        if (round % 5 == 4) t.clear();
+        if (round < 24) comb[round].grow(4);
+    }
+    for (Mpi& m : scratch) m.clear();
+    for (int i = 23; i >= 0; i--) comb[i].clear();
+    for (Mpi& m : group) m.clear();
+    shimFree(keypair);
+    shimFree(keyMaterial);                    // psa_destroy_key() right after ECDH
+
+    // keySessionCipher(): the new context replaces the last session's
+    shimFree(*cipherCtx);
+    *cipherCtx = shimCalloc(1, 392);
+}
+
+static void testHandshakeMakesNoHeapAllocations()
+{
+    heapAllocs = 0;
+    arena.resetPeak();
+    void* cipherCtx = nullptr;
+    for (int i = 0; i < 200; i++) {
+        replayHandshake(&cipherCtx);
+        CHECK_EQ(arena.used(), 400);          // Only the live session cipher is left
+    }
+    CHECK(arena.peak() > 400 && arena.peak() < ARENA_SIZE / 2);
+    CHECK_EQ(heapAllocs, 0);
+
+    // endSession() from another task frees the cipher back into the arena
+    shimFree(cipherCtx);
+    CHECK_EQ(arena.used(), 0);
+
+    // Once the arena is full the shim falls back to the heap and the count catches it
+    void* hog = arena.allocate(1, ARENA_SIZE - 8);
+    void* spill = shimCalloc(1, 16);
+    CHECK_EQ(heapAllocs, 1);
+    shimFree(spill);
+    shimFree(hog);
+    CHECK_EQ(arena.used(), 0);
+}
+
+int main()
+{
+    testZeroedAndAligned();
+    testExhaustionAndMerge();
+    testEdgeCases();
+    testRandomLifetimes();
+    testHandshakeMakesNoHeapAllocations();
+    return checkResult("HandshakeArena");
+}
@@ -0,0 +1,197 @@
+// Runs random and boundary delta sequences through MouseMotion and checks that the HID
+// reports add up to exactly what was asked for: at unity scale the report sums equal the
+// input sums, at other scales they differ only by the fraction still carried (under one
+// count, in the 8.8 fixed-point split), and the wheel is never scaled.
+#include "MouseMotion.h"
+#include "check.h"
+
+#include <stdlib.h>
+#include <vector>
+
+struct Delta {
+    int32_t x, y, wheel;
+};
+
+struct Sums {
+    int64_t x = 0, y = 0, wheel = 0;
+    size_t reports = 0;
+    bool inRange = true;   // Every report within +-MOUSE_STEP_MAX
+};
+
+static int32_t clampFrame(int32_t v)
+{
+    return v > MOUSE_FRAME_MAX ? MOUSE_FRAME_MAX : v < -MOUSE_FRAME_MAX ? -MOUSE_FRAME_MAX : v;
+}
+
+static void take(MouseMotion& motion, Sums& sums, size_t maxSteps)
+{
+    MouseStep step;
+    for (size_t i = 0; i < maxSteps && motion.next(&step); i++) {
+        sums.x += step.x;
+        sums.y += step.y;
+        sums.wheel += step.wheel;
+        sums.reports++;
+        // int8_t fields, so -128 is the only way out of range
+        if (step.x < -MOUSE_STEP_MAX || step.y < -MOUSE_STEP_MAX || step.wheel < -MOUSE_STEP_MAX) {
+            sums.inRange = false;
+        }
+    }
+}
+
+// Play deltas, draining each frame fully (partial = false) or only partly before the next
+// add() folds the rest in (partial = true), then drain what is left
+static Sums play(uint16_t scale, const std::vector<Delta>& deltas, bool partial)
+{
+    MouseMotion motion(scale);
+    Sums sums;
+    for (const Delta& d : deltas) {
+        motion.add(d.x, d.y, d.wheel);
+        take(motion, sums, partial ? (size_t)(rand() % 4) : SIZE_MAX);
+    }
+    take(motion, sums, SIZE_MAX);
+    return sums;
+}
+
+// Check one sequence at one scale: exact wheel, and pointer sums within the carried fraction
+static void checkSequence(uint16_t scale, const std::vector<Delta>& deltas, bool partial)
+{
+    int64_t inX = 0, inY = 0, inWheel = 0;
+    bool sameSignX = true, sameSignY = true;
+    for (const Delta& d : deltas) {
+        inX += clampFrame(d.x);
+        inY += clampFrame(d.y);
+        inWheel += clampFrame(d.wheel);
+        sameSignX = sameSignX && (d.x >= 0) == (deltas[0].x >= 0);
+        sameSignY = sameSignY && (d.y >= 0) == (deltas[0].y >= 0);
+    }
+
+    Sums out = play(scale, deltas, partial);
+    CHECK(out.inRange);
+    CHECK_EQ(out.wheel, inWheel);
+
+    // What the 8.8 split still holds back is under one count on each axis
+    int64_t restX = inX * scale - out.x * MOUSE_SCALE_ONE;
+    int64_t restY = inY * scale - out.y * MOUSE_SCALE_ONE;
+    CHECK(restX > -MOUSE_SCALE_ONE && restX < MOUSE_SCALE_ONE);
+    CHECK(restY > -MOUSE_SCALE_ONE && restY < MOUSE_SCALE_ONE);
+
+    if (scale == MOUSE_SCALE_ONE) {
+        CHECK_EQ(out.x, inX);
+        CHECK_EQ(out.y, inY);
+    }
+
+    // Motion in one direction truncates toward zero exactly once, however it was split
+    if (sameSignX) CHECK_EQ(out.x, inX * scale / MOUSE_SCALE_ONE);
+    if (sameSignY) CHECK_EQ(out.y, inY * scale / MOUSE_SCALE_ONE);
+}
+
+static const uint16_t SCALES[] = { 1, 64, 128, 255, 256, 257, 384, 511, 512, 1000, 65535 };
+
+// Deltas either side of every step and fixed-point boundary
+static void testBoundaries()
+{
+    const int32_t edges[] = {
+        0, 1, 2, 126, 127, 128, 129, 254, 255, 256, 257, 381, 508, 32766, 32767, 32768, 100000
+    };
+    for (uint16_t scale : SCALES) {
+        for (int32_t e : edges) {
+            for (int sign : {1, -1}) {
+                int32_t v = e * sign;
+                checkSequence(scale, {{v, 0, 0}}, false);
+                checkSequence(scale, {{0, v, v}}, false);
+                checkSequence(scale, {{v, -v, v}}, false);
+                checkSequence(scale, {{v, v, 0}, {v, v, 0}, {v, v, 0}}, false);
+            }
+        }
+    }
+}
+
+// Many sub-count moves at a low speed still add up instead of rounding away
+static void testSlowMotionAccumulates()
+{
+    std::vector<Delta> deltas(1000, Delta{1, -1, 0});
+    Sums out = play(MOUSE_SCALE_ONE / 4, deltas, false);
+    CHECK_EQ(out.x, 250);
+    CHECK_EQ(out.y, -250);
+
+    // Back and forth at half speed ends where it started
+    std::vector<Delta> wiggle;
+    for (int i = 0; i < 500; i++) wiggle.push_back(i % 2 ? Delta{-3, 5, 0} : Delta{3, -5, 0});
+    out = play(MOUSE_SCALE_ONE / 2, wiggle, false);
+    CHECK_EQ(out.x, 0);
+    CHECK_EQ(out.y, 0);
+}
+
+// A frame splits into the fewest reports that keep each axis within +-127
+static void testReportCount()
+{
+    MouseMotion motion;
+    Sums sums;
+    motion.add(127, 0, 0);
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.reports, 1);
+
+    sums = Sums();
+    motion.add(128, -5, 0);
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.reports, 2);
+
+    sums = Sums();
+    motion.add(0, 0, 0);
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.reports, 0);
+
+    sums = Sums();
+    motion.add(-MOUSE_FRAME_MAX, 0, 0);
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.reports, (MOUSE_FRAME_MAX + MOUSE_STEP_MAX - 1) / MOUSE_STEP_MAX);
+    CHECK_EQ(sums.x, -MOUSE_FRAME_MAX);
+}
+
+static int32_t randomDelta()
+{
+    switch (rand() % 5) {
+        case 0:  return rand() % 7 - 3;                          // Sub-count jitter
+        case 1:  return rand() % 511 - 255;                      // Around one report
+        case 2:  return (rand() % 3 - 1) * (127 + rand() % 3);   // On the step boundary
+        case 3:  return rand() % 20001 - 10000;                  // Big flicks
+        default: return rand() % (2 * MOUSE_FRAME_MAX + 1001) - MOUSE_FRAME_MAX - 500;  // Past the clamp
+    }
+}
+
+static void testRandomSequences()
+{
+    srand(42);
+    for (int run = 0; run < 2000; run++) {
+        std::vector<Delta> deltas(1 + rand() % 40);
+        for (Delta& d : deltas) d = { randomDelta(), randomDelta(), rand() % 4 ? 0 : randomDelta() };
+        uint16_t scale = (run % 3 == 0) ? SCALES[rand() % (sizeof(SCALES) / sizeof(SCALES[0]))]
+                                        : (uint16_t)(1 + rand() % 1024);
+        checkSequence(scale, deltas, run % 2 == 1);
+    }
+}
+
+// reset() forgets carried fractions and untaken reports
+static void testReset()
+{
+    MouseMotion motion(MOUSE_SCALE_ONE / 2);
+    motion.add(1, 1, 0);    // Half a count carried
+    motion.add(1000, 0, 0); // Reports left untaken
+    motion.reset();
+    Sums sums;
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.reports, 0);
+    motion.add(1, 0, 0);
+    take(motion, sums, SIZE_MAX);
+    CHECK_EQ(sums.x, 0);    // The earlier half count is gone
+}
+
+int main()
+{
+    testBoundaries();
+    testSlowMotionAccumulates();
+    testReportCount();
+    testRandomSequences();
+    testReset();
+    return checkResult("MouseMotion");
+}
@@ -0,0 +1,289 @@
+// Feeds encoded DataPackets through decodeDataPacketView() and the in-place payload walk the
+// packet task runs after decryptInPlace(), next to the pb_decode() path it replaced, and
+// reports the bytes each copies per packet. There is no cipher on the host: AES-GCM keeps the
+// length, so the serialized EncryptedData stands in for its own ciphertext.
+#include "PacketView.h"
+#include "check.h"
+
+#include "pb_encode.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static constexpr size_t WIRE_MAX = 256;
+
+static size_t encodeEncrypted(const toothpaste_EncryptedData& data, uint8_t* buf, size_t cap)
+{
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, cap);
+    CHECK(pb_encode(&stream, toothpaste_EncryptedData_fields, &data));
+    return stream.bytes_written;
+}
+
+static size_t encodeDataPacket(const uint8_t* plain, size_t plainLen, bool bulk, uint8_t* buf, size_t cap)
+{
+    toothpaste_DataPacket packet = toothpaste_DataPacket_init_zero;
+    packet.packetID = toothpaste_DataPacket_PacketID_DATA_PACKET;
+    packet.packetNumber = 1;
+    packet.totalPackets = 1;
+    packet.iv.size = sizeof(packet.iv.bytes);
+    memset(packet.iv.bytes, 0x11, sizeof(packet.iv.bytes));
+    packet.dataLen = (uint32_t)plainLen;
+    CHECK(plainLen <= sizeof(packet.encryptedData.bytes));
+    packet.encryptedData.size = (pb_size_t)plainLen;
+    memcpy(packet.encryptedData.bytes, plain, plainLen);
+    packet.tag.size = sizeof(packet.tag.bytes);
+    memset(packet.tag.bytes, 0x22, sizeof(packet.tag.bytes));
+    packet.bulk = bulk;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, cap);
+    CHECK(pb_encode(&stream, toothpaste_DataPacket_fields, &packet));
+    return stream.bytes_written;
+}
+
+// The replaced path: pb_decode() into the static DataPacket, decrypt into a second buffer,
+// pb_decode() the EncryptedData union. Counts the payload bytes each step copied.
+static size_t oldDecode(const uint8_t* wire, size_t len, toothpaste_EncryptedData* out)
+{
+    toothpaste_DataPacket packet = toothpaste_DataPacket_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(wire, len);
+    CHECK(pb_decode(&stream, toothpaste_DataPacket_fields, &packet));
+    size_t copied = packet.iv.size + packet.encryptedData.size + packet.tag.size + packet.resumeTicket.size;
+
+    uint8_t plain[sizeof(packet.encryptedData.bytes)];
+    size_t plainLen = packet.dataLen < packet.encryptedData.size ? packet.dataLen : packet.encryptedData.size;
+    memcpy(plain, packet.encryptedData.bytes, plainLen);
+    copied += plainLen;
+
+    *out = toothpaste_EncryptedData_init_zero;
+    stream = pb_istream_from_buffer(plain, plainLen);
+    CHECK(pb_decode(&stream, toothpaste_EncryptedData_fields, out));
+    switch (out->which_packetData) {
+        case toothpaste_EncryptedData_keyboardPacket_tag: copied += strlen(out->packetData.keyboardPacket.message); break;
+        case toothpaste_EncryptedData_keycodePacket_tag:  copied += out->packetData.keycodePacket.code.size; break;
+        case toothpaste_EncryptedData_mousePacket_tag:    copied += sizeof(out->packetData.mousePacket); break;
+        default: break;
+    }
+    return copied;
+}
+
+// What the in-place path hands to the HID layer
+struct Dispatched {
+    uint32_t       tag;
+    const uint8_t* data;    // Keyboard message / keycodes, still in the receive buffer
+    size_t         len;
+    toothpaste_MousePacket mouse;
+};
+
+// The in-place path, as decryptSendString() and dispatchPayload() walk it: index the
+// DataPacket, then locate each payload inside the (decrypted) encryptedData bytes. Only the
+// small fixed-layout messages are materialized; returns the bytes copied to do so.
+static size_t inPlaceDecode(uint8_t* wire, size_t len, DataPacketView* view, Dispatched* out)
+{
+    memset(out, 0, sizeof(*out));
+    CHECK(decodeDataPacketView(wire, len, view));
+    size_t plainLen = view->dataLen < view->encryptedLen ? view->dataLen : view->encryptedLen;
+
+    size_t copied = 0;
+    PbReader reader(view->encryptedData, plainLen);
+    PbField payload;
+    while (reader.next(&payload)) {
+        if (payload.tag == toothpaste_EncryptedData_packetType_tag || payload.wireType != PB_WT_STRING) continue;
+        out->tag = payload.tag;
+        uint8_t* data;
+        uint32_t declared;
+        switch (payload.tag) {
+            case toothpaste_EncryptedData_keyboardPacket_tag:
+                findStringField(payload.data, payload.len, toothpaste_KeyboardPacket_message_tag,
+                                toothpaste_KeyboardPacket_length_tag, &data, &out->len, &declared);
+                out->data = data;
+                break;
+
+            case toothpaste_EncryptedData_keycodePacket_tag:
+                findStringField(payload.data, payload.len, toothpaste_KeycodePacket_code_tag,
+                                toothpaste_KeycodePacket_length_tag, &data, &out->len, &declared);
+                out->data = data;
+                copied += out->len;   // queueKeycode() takes its own copy of the report
+                break;
+
+            case toothpaste_EncryptedData_mousePacket_tag:
+            {
+                pb_istream_t stream = pb_istream_from_buffer(payload.data, payload.len);
+                CHECK(pb_decode(&stream, toothpaste_MousePacket_fields, &out->mouse));
+                copied += sizeof(out->mouse);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    CHECK(reader.ok());
+    return copied;
+}
+
+static bool inBuffer(const uint8_t* p, size_t n, const uint8_t* buf, size_t len)
+{
+    return p != nullptr && p >= buf && p + n <= buf + len;
+}
+
+static void report(const char* name, size_t wire, size_t oldCopied, size_t newCopied)
+{
+    printf("  %-18s wire %3u B   pb_decode copied %3u B   in place %3u B\n", name, (unsigned)wire,
+           (unsigned)oldCopied, (unsigned)newCopied);
+}
+
+static void testKeyboard(size_t chars)
+{
+    toothpaste_EncryptedData data = toothpaste_EncryptedData_init_zero;
+    data.packetType = toothpaste_EncryptedData_PacketType_KEYBOARD_STRING;
+    data.which_packetData = toothpaste_EncryptedData_keyboardPacket_tag;
+    for (size_t i = 0; i < chars; i++) data.packetData.keyboardPacket.message[i] = (char)('a' + i % 26);
+    data.packetData.keyboardPacket.length = (uint32_t)chars;
+
+    uint8_t plain[WIRE_MAX], wire[WIRE_MAX];
+    size_t plainLen = encodeEncrypted(data, plain, sizeof(plain));
+    size_t len = encodeDataPacket(plain, plainLen, true, wire, sizeof(wire));
+
+    toothpaste_EncryptedData decoded;
+    size_t oldCopied = oldDecode(wire, len, &decoded);
+
+    DataPacketView view;
+    Dispatched out;
+    size_t newCopied = inPlaceDecode(wire, len, &view, &out);
+    CHECK(view.bulk);
+    CHECK_EQ(view.ivLen, 12);
+    CHECK_EQ(view.tagLen, 16);
+    CHECK(inBuffer(view.encryptedData, view.encryptedLen, wire, len));
+    CHECK_EQ(out.tag, toothpaste_EncryptedData_keyboardPacket_tag);
+    CHECK_EQ(out.len, chars);
+    CHECK(inBuffer(out.data, out.len, wire, len));
+    CHECK(memcmp(out.data, decoded.packetData.keyboardPacket.message, chars) == 0);
+    CHECK_EQ(newCopied, 0);
+    CHECK(oldCopied >= 2 * chars);
+
+    char name[32];
+    snprintf(name, sizeof(name), "keyboard %u chars", (unsigned)chars);
+    report(name, len, oldCopied, newCopied);
+}
+
+static void testKeycode()
+{
+    static const uint8_t codes[] = {0x04, 0x05, 0x06, 0xe0, 0xe1, 0x28};
+    toothpaste_EncryptedData data = toothpaste_EncryptedData_init_zero;
+    data.packetType = toothpaste_EncryptedData_PacketType_KEYBOARD_KEYCODE;
+    data.which_packetData = toothpaste_EncryptedData_keycodePacket_tag;
+    data.packetData.keycodePacket.code.size = sizeof(codes);
+    memcpy(data.packetData.keycodePacket.code.bytes, codes, sizeof(codes));
+    data.packetData.keycodePacket.length = sizeof(codes);
+
+    uint8_t plain[WIRE_MAX], wire[WIRE_MAX];
+    size_t plainLen = encodeEncrypted(data, plain, sizeof(plain));
+    size_t len = encodeDataPacket(plain, plainLen, false, wire, sizeof(wire));
+
+    toothpaste_EncryptedData decoded;
+    size_t oldCopied = oldDecode(wire, len, &decoded);
+
+    DataPacketView view;
+    Dispatched out;
+    size_t newCopied = inPlaceDecode(wire, len, &view, &out);
+    CHECK(!view.bulk);
+    CHECK_EQ(out.len, sizeof(codes));
+    CHECK(inBuffer(out.data, out.len, wire, len));
+    CHECK(memcmp(out.data, codes, sizeof(codes)) == 0);
+    CHECK_EQ(newCopied, sizeof(codes));
+    CHECK(newCopied < oldCopied);
+    report("keycode 6 keys", len, oldCopied, newCopied);
+}
+
+static void testMouse()
+{
+    toothpaste_EncryptedData data = toothpaste_EncryptedData_init_zero;
+    data.packetType = toothpaste_EncryptedData_PacketType_MOUSE;
+    data.which_packetData = toothpaste_EncryptedData_mousePacket_tag;
+    toothpaste_MousePacket& mouse = data.packetData.mousePacket;
+    mouse.num_frames = 5;
+    mouse.frames_count = 5;
+    for (int i = 0; i < 5; i++) {
+        mouse.frames[i].x = 3 * i - 4;
+        mouse.frames[i].y = 100 - i;
+    }
+    mouse.l_click = 1;
+
+    uint8_t plain[WIRE_MAX], wire[WIRE_MAX];
+    size_t plainLen = encodeEncrypted(data, plain, sizeof(plain));
+    size_t len = encodeDataPacket(plain, plainLen, false, wire, sizeof(wire));
+
+    toothpaste_EncryptedData decoded;
+    size_t oldCopied = oldDecode(wire, len, &decoded);
+
+    DataPacketView view;
+    Dispatched out;
+    size_t newCopied = inPlaceDecode(wire, len, &view, &out);
+    CHECK_EQ(out.tag, toothpaste_EncryptedData_mousePacket_tag);
+    CHECK_EQ(out.mouse.frames_count, 5);
+    CHECK_EQ(out.mouse.frames[4].x, decoded.packetData.mousePacket.frames[4].x);
+    CHECK_EQ(out.mouse.frames[4].y, decoded.packetData.mousePacket.frames[4].y);
+    CHECK_EQ(out.mouse.l_click, 1);
+    CHECK(newCopied < oldCopied);
+    report("mouse 5 frames", len, oldCopied, newCopied);
+}
+
+// AUTH carries the public key in encryptedData and the ticket ID alongside it
+static void testAuth()
+{
+    toothpaste_DataPacket packet = toothpaste_DataPacket_init_zero;
+    packet.packetID = toothpaste_DataPacket_PacketID_AUTH_PACKET;
+    packet.encryptedData.size = 88;
+    memset(packet.encryptedData.bytes, 'B', packet.encryptedData.size);
+    packet.resume = true;
+    packet.resumeTicket.size = sizeof(packet.resumeTicket.bytes);
+    memset(packet.resumeTicket.bytes, 0x5a, sizeof(packet.resumeTicket.bytes));
+
+    uint8_t wire[WIRE_MAX];
+    pb_ostream_t stream = pb_ostream_from_buffer(wire, sizeof(wire));
+    CHECK(pb_encode(&stream, toothpaste_DataPacket_fields, &packet));
+    size_t len = stream.bytes_written;
+
+    DataPacketView view;
+    CHECK(decodeDataPacketView(wire, len, &view));
+    CHECK_EQ(view.packetID, toothpaste_DataPacket_PacketID_AUTH_PACKET);
+    CHECK(view.resume);
+    CHECK_EQ(view.encryptedLen, 88);
+    CHECK(inBuffer(view.encryptedData, view.encryptedLen, wire, len));
+    CHECK_EQ(view.resumeTicketLen, sizeof(packet.resumeTicket.bytes));
+    CHECK(inBuffer(view.resumeTicket, view.resumeTicketLen, wire, len));
+    CHECK(memcmp(view.resumeTicket, packet.resumeTicket.bytes, view.resumeTicketLen) == 0);
+}
+
+// Truncated writes are rejected rather than indexed past the end of the buffer
+static void testTruncated()
+{
+    toothpaste_EncryptedData data = toothpaste_EncryptedData_init_zero;
+    data.which_packetData = toothpaste_EncryptedData_keyboardPacket_tag;
+    strcpy(data.packetData.keyboardPacket.message, "hello");
+    data.packetData.keyboardPacket.length = 5;
+
+    uint8_t plain[WIRE_MAX], wire[WIRE_MAX];
+    size_t plainLen = encodeEncrypted(data, plain, sizeof(plain));
+    size_t len = encodeDataPacket(plain, plainLen, false, wire, sizeof(wire));
+
+    DataPacketView view;
+    for (size_t cut = 1; cut < len; cut++) {
+        if (decodeDataPacketView(wire, len - cut, &view) && view.encryptedData != nullptr) {
+            CHECK(inBuffer(view.encryptedData, view.encryptedLen, wire, len - cut));
+        }
+    }
+}
+
+int main()
+{
+    printf("Bytes copied per DataPacket after ingest:\n");
+    testKeyboard(1);
+    testKeyboard(40);
+    testKeyboard(180);
+    testKeycode();
+    testMouse();
+    testAuth();
+    testTruncated();
+    return checkResult("PacketView");
+}
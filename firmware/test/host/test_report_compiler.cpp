@@ -0,0 +1,224 @@
+// Diffs ReportCompiler's report traces against the naive per-character sequence: a press
+// report and an all-up report for every character. Both traces are played into a model
+// host that records each key going down with the modifiers of that report; coalescing
+// may only remove reports, never change what the host types.
+#include "ReportCompiler.h"
+#include "KeyboardKeymap.h"
+#include "check.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+extern const uint8_t KeyboardLayout_en_US[];
+extern const uint8_t KeyboardLayout_de_DE[];
+extern const uint8_t KeyboardLayout_fr_FR[];
+
+struct KeyDown {
+    uint8_t modifiers;
+    uint8_t key;
+    bool operator==(const KeyDown& o) const { return modifiers == o.modifiers && key == o.key; }
+};
+
+static std::vector<KeyFrame> compile(const uint8_t* layout, const KeymapEntry* keymap, const std::string& text,
+                                     bool coalesce, UnicodeInput input = UNICODE_INPUT_NONE)
+{
+    ReportCompiler compiler(layout, keymap, input);
+    compiler.begin(text.data(), text.size(), coalesce);
+    std::vector<KeyFrame> trace;
+    KeyFrame frame;
+    while (compiler.next(&frame)) trace.push_back(frame);
+    return trace;
+}
+
+// The same text fed in pieces of at most chunk bytes, split only on whole UTF-8 sequences
+static std::vector<KeyFrame> compileChunked(const uint8_t* layout, const KeymapEntry* keymap, const std::string& text,
+                                            size_t chunk, bool coalesce)
+{
+    ReportCompiler compiler(layout, keymap);
+    compiler.begin(coalesce);
+    std::vector<KeyFrame> trace;
+    size_t pos = 0;
+    do {
+        size_t avail = std::min(chunk, text.size() - pos);
+        bool last = pos + avail == text.size();
+        size_t whole = last ? avail : ReportCompiler::completeUtf8(text.data() + pos, avail);
+        compiler.feed(text.data() + pos, whole, last);
+        KeyFrame frame;
+        while (compiler.next(&frame)) trace.push_back(frame);
+        pos += whole;
+    } while (pos < text.size());
+    return trace;
+}
+
+// Naive ASCII trace: press, then all-up, for every character the keymap has
+static std::vector<KeyFrame> naive(const KeymapEntry* keymap, const std::string& text)
+{
+    std::vector<KeyFrame> trace;
+    for (unsigned char ch : text) {
+        if (ch >= KEYMAP_SIZE || ch == '\r' || keymap[ch].usage == 0) continue;
+        trace.push_back({keymap[ch].modifiers, keymap[ch].usage});
+        trace.push_back({0, 0});
+    }
+    return trace;
+}
+
+// What a host types from a trace: every report whose key was not down in the one before
+static std::vector<KeyDown> hostKeyDowns(const std::vector<KeyFrame>& trace)
+{
+    std::vector<KeyDown> downs;
+    KeyFrame prev = {0, 0};
+    for (const KeyFrame& f : trace) {
+        if (f.key != 0 && f.key != prev.key) downs.push_back({f.modifiers, f.key});
+        prev = f;
+    }
+    return downs;
+}
+
+static bool endsAllUp(const std::vector<KeyFrame>& trace)
+{
+    return trace.empty() || (trace.back().key == 0 && trace.back().modifiers == 0);
+}
+
+// A key never changes modifiers while it is held, so the host never sees a shifted repeat
+static bool modifiersStableWhileHeld(const std::vector<KeyFrame>& trace)
+{
+    KeyFrame prev = {0, 0};
+    for (const KeyFrame& f : trace) {
+        if (f.key != 0 && f.key == prev.key && f.modifiers != prev.modifiers) return false;
+        prev = f;
+    }
+    return true;
+}
+
+// ASCII the layout has no key for (de_DE ^ and `) goes through dead keys instead, so it is
+// left out of the naive comparison and covered by testComposedCharacters()
+static void checkAgainstNaive(const uint8_t* layout, const KeymapEntry* keymap, const std::string& input)
+{
+    std::string text;
+    for (unsigned char ch : input) {
+        if (ch < KEYMAP_SIZE && keymap[ch].usage != 0) text.push_back((char)ch);
+    }
+
+    std::vector<KeyFrame> reference = naive(keymap, text);
+    std::vector<KeyFrame> coalesced = compile(layout, keymap, text, true);
+    std::vector<KeyFrame> pairs = compile(layout, keymap, text, false);
+
+    CHECK(hostKeyDowns(coalesced) == hostKeyDowns(reference));
+    CHECK(hostKeyDowns(pairs) == hostKeyDowns(reference));
+    CHECK(endsAllUp(coalesced));
+    CHECK(modifiersStableWhileHeld(coalesced));
+    CHECK(coalesced.size() <= reference.size());
+
+    // Uncoalesced output is exactly the naive press/release sequence
+    CHECK_EQ(pairs.size(), reference.size());
+    bool same = pairs.size() == reference.size();
+    for (size_t i = 0; same && i < pairs.size(); i++) {
+        same = pairs[i].modifiers == reference[i].modifiers && pairs[i].key == reference[i].key;
+    }
+    CHECK(same);
+
+    for (size_t chunk : {1, 3, 7, 64}) {
+        std::vector<KeyFrame> chunked = compileChunked(layout, keymap, text, chunk, true);
+        CHECK(hostKeyDowns(chunked) == hostKeyDowns(reference));
+        CHECK(endsAllUp(chunked));
+    }
+}
+
+// The counts in ReportCompiler.h: "ab" is three reports coalesced, four as press/release pairs
+static void testDocumentedCounts(const KeymapEntry* keymap)
+{
+    std::vector<KeyFrame> coalesced = compile(KeyboardLayout_en_US, keymap, "ab", true);
+    CHECK_EQ(coalesced.size(), 3);
+    std::vector<KeyFrame> pairs = compile(KeyboardLayout_en_US, keymap, "ab", false);
+    CHECK_EQ(pairs.size(), 4);
+
+    // Repeats and modifier changes still need a release in between
+    CHECK_EQ(compile(KeyboardLayout_en_US, keymap, "aa", true).size(), 4);
+    CHECK_EQ(compile(KeyboardLayout_en_US, keymap, "aA", true).size(), 4);
+}
+
+static void testAsciiStrings(const uint8_t* layout, const KeymapEntry* keymap)
+{
+    const char* samples[] = {
+        "",
+        "a",
+        "hello world",
+        "aaabbbccc",
+        "Hello, World! 1234567890",
+        "MiXeD CaSe ShIfT",
+        "tabs\tand\nnewlines\r\n",
+        "!@#$%^&*()_+-=[]{};':\",./<>?`~\\|",
+        "int main() { return 0; }\n",
+    };
+    for (const char* s : samples) checkAgainstNaive(layout, keymap, s);
+}
+
+static void testRandomAscii(const uint8_t* layout, const KeymapEntry* keymap)
+{
+    srand(1234);
+    for (int run = 0; run < 500; run++) {
+        std::string text;
+        size_t len = rand() % 80;
+        for (size_t i = 0; i < len; i++) {
+            int r = rand() % 100;
+            if (r < 5) text.push_back('\n');
+            else if (r < 8) text.push_back(text.empty() ? 'x' : text.back()); // Force repeats
+            else text.push_back((char)(0x20 + rand() % 95));
+        }
+        checkAgainstNaive(layout, keymap, text);
+    }
+}
+
+// Non-ASCII through layout extras (direct keys and dead keys): both modes type the same
+// keys, and the coalesced trace is never longer than press/release pairs
+static void testComposedCharacters(const uint8_t* layout, const KeymapEntry* keymap)
+{
+    const char* samples[] = {
+        "\xc3\xa4\xc3\xb6\xc3\xbc\xc3\x9f",     // äöüß
+        "caf\xc3\xa9 cr\xc3\xa8" "me br\xc3\xbbl\xc3\xa9" "e",  // café crème brûlée
+        "\xc3\xa9\xc3\xa9\xc3\xa9",            // ééé: the dead key repeats
+        "^`",                                  // ASCII through dead key + space on de_DE
+    };
+    for (const char* s : samples) {
+        std::vector<KeyFrame> coalesced = compile(layout, keymap, s, true);
+        std::vector<KeyFrame> pairs = compile(layout, keymap, s, false);
+        CHECK(!pairs.empty());
+        CHECK(hostKeyDowns(coalesced) == hostKeyDowns(pairs));
+        CHECK(endsAllUp(coalesced));
+        CHECK(modifiersStableWhileHeld(coalesced));
+        CHECK(coalesced.size() <= pairs.size());
+    }
+}
+
+// Unicode entry keeps the same keys in both modes and ends every character all-up
+static void testUnicodeEntry(const KeymapEntry* keymap)
+{
+    const char* text = "a\xe2\x82\xac" "b";  // a€b
+    for (UnicodeInput input : {UNICODE_INPUT_LINUX, UNICODE_INPUT_WINDOWS, UNICODE_INPUT_MACOS}) {
+        std::vector<KeyFrame> coalesced = compile(KeyboardLayout_en_US, keymap, text, true, input);
+        std::vector<KeyFrame> pairs = compile(KeyboardLayout_en_US, keymap, text, false, input);
+        CHECK(hostKeyDowns(coalesced) == hostKeyDowns(pairs));
+        CHECK(endsAllUp(coalesced));
+        CHECK(coalesced.size() <= pairs.size());
+    }
+}
+
+int main()
+{
+    KeymapEntry us[KEYMAP_SIZE], de[KEYMAP_SIZE], fr[KEYMAP_SIZE];
+    expandKeyboardLayout(KeyboardLayout_en_US, us);
+    expandKeyboardLayout(KeyboardLayout_de_DE, de);
+    expandKeyboardLayout(KeyboardLayout_fr_FR, fr);
+
+    testDocumentedCounts(us);
+    testAsciiStrings(KeyboardLayout_en_US, us);
+    testAsciiStrings(KeyboardLayout_de_DE, de);
+    testRandomAscii(KeyboardLayout_en_US, us);
+    testRandomAscii(KeyboardLayout_fr_FR, fr);
+    testComposedCharacters(KeyboardLayout_de_DE, de);
+    testComposedCharacters(KeyboardLayout_fr_FR, fr);
+    testUnicodeEntry(us);
+    return checkResult("ReportCompiler");
+}
@@ -7,6 +7,7 @@ import {
     CursorArrowRippleIcon,
     ArrowDownOnSquareStackIcon,
     EllipsisVerticalIcon,
+    ViewfinderCircleIcon,
 } from "@heroicons/react/24/outline";
 
 const STATUS_MESSAGES = {
@@ -22,6 +23,10 @@ const STATUS_MESSAGES = {
         text: "Keyboard shortcuts will be used by this device",
         icon: <ArrowDownOnSquareStackIcon className="w-5 h-5 text-white" />
     },
+    TABLET_MODE: {
+        text: "Tablet mode: the cursor goes to the same spot on the remote screen",
+        icon: <ViewfinderCircleIcon className="w-5 h-5 text-white" />
+    },
     MOUSE_JIGGLE: {
         text: "Mouse is jiggling to prevent sleep",
         icon: <CursorArrowRippleIcon className="w-5 h-5 text-white" />
@@ -43,6 +48,8 @@ export default function KeyboardMouse({
     setCommandPassthrough,
     jiggling,
     setJiggling,
+    tabletMode,
+    setTabletMode,
     isFocused,
     setIsFocused,
     status,
@@ -60,7 +67,7 @@ export default function KeyboardMouse({
         const messages = [];
         
         if (captureMouse) {
-            messages.push(STATUS_MESSAGES.MOUSE_CAPTURE);
+            messages.push(tabletMode ? STATUS_MESSAGES.TABLET_MODE : STATUS_MESSAGES.MOUSE_CAPTURE);
         }
         
         if (commandPassthrough) {
@@ -108,6 +115,8 @@ export default function KeyboardMouse({
                     setCommandPassthrough={setCommandPassthrough}
                     jiggling={jiggling}
                     setJiggling={setJiggling}
+                    tabletMode={tabletMode}
+                    setTabletMode={setTabletMode}
                     status={status}
                     sendEncrypted={sendEncrypted}
                     sendKeyboardShortcut={sendKeyboardShortcut}
@@ -12,6 +12,7 @@ import {
     EllipsisVerticalIcon,
     ChevronLeftIcon,
     ChevronRightIcon,
+    ViewfinderCircleIcon,
 } from "@heroicons/react/24/outline";
 import { MediaToggleButton, IconToggleButton } from "../shared/buttons";
 import { keyboardHandler } from "../../services/inputHandlers/keyboardHandler";
@@ -346,6 +347,8 @@ export function RightButtonColumn({
     setCommandPassthrough,
     jiggling,
     setJiggling,
+    tabletMode,
+    setTabletMode,
     status,
     sendEncrypted,
     sendKeyboardShortcut,
@@ -367,6 +370,20 @@ export function RightButtonColumn({
         );
     }
 
+    function TabletModeButton() {
+        const handleToggle = () => setTabletMode((prev) => !prev);
+        return (
+            <IconToggleButton
+                title="Tablet mode"
+                toggled={tabletMode}
+                onClick={handleToggle}
+                Icon={ViewfinderCircleIcon}
+                hoverText="Tablet mode: place the cursor at the same spot on the remote screen"
+                connectionStatus={status}
+            />
+        );
+    }
+
     function CommandPassthroughButton() {
         const handleToggle = () => setCommandPassthrough((prev) => !prev);
         return (
@@ -441,6 +458,9 @@ export function RightButtonColumn({
             <div>
                 <CaptureMouseButton />
             </div>
+            <div>
+                <TabletModeButton />
+            </div>
             <div>
                 <CommandPassthroughButton />
             </div>
@@ -6,6 +6,7 @@ import { ArrowUpOnSquareStackIcon, CursorArrowRaysIcon } from "@heroicons/react/
 
 export default function Touchpad({
     captureMouse,
+    tabletMode,
     commandPassthrough,
     onTouchStart,
     onTouchMove,
@@ -126,7 +127,8 @@ export default function Touchpad({
                     className="font-light"
                     aria-hidden="true"
                 >
-                    {captureMouse ? "Drag to move cursor" : "Enable Mouse Capture To Use Touchpad"}
+                    {!captureMouse ? "Enable Mouse Capture To Use Touchpad"
+                        : tabletMode ? "Touch where the cursor should go" : "Drag to move cursor"}
                 </Typography>
             </div>
 
@@ -7,7 +7,7 @@ import React, {
 } from "react";
 import { keyExists, loadBase64 } from "../services/localSecurity/EncryptedStorage.js";
 import { ECDHContext } from "./ECDHContext.jsx";
-import { createUnencryptedPacket, unpackResponsePacket } from "../services/packetService/packetFunctions.js";
+import { createUnencryptedPacket, createCancelPacket, unpackResponsePacket, setMaxPayload } from "../services/packetService/packetFunctions.js";
 import { PacketQueue } from "../services/packetService/PacketQueue.js";
 import { create, toBinary, fromBinary } from "@bufbuild/protobuf";
 
@@ -41,39 +41,105 @@ export function BLEProvider({ children }) {
     const [pktCharacteristic, setpktCharacteristic] = useState(null);
     const pktCharRef = useRef(null);
 
+    // Receiver has the absolute pointer interface (ResponsePacket.absolutePointer); without it
+    // mouseHandler.sendPointerPosition() falls back to relative frames
+    const [absolutePointer, setAbsolutePointer] = useState(false);
+
     
-    const { loadKeys, createEncryptedPackets } = useContext(ECDHContext);
+    const { loadKeys, issueResumeTicket, loadResumeTicket, resumeKeys, createEncryptedPackets } = useContext(ECDHContext);
     const readyToReceive = useRef({ promise: null, resolve: null });
 
-    // Send a text string as a byte array without encryption
-    const sendUnencrypted = async (inputString) => {
+    // Credit-based flow control: the firmware advertises a running limit on input credits
+    // (creditLimit) counted from connect; a write spends one, a composite one per command.
+    // Bulk writes must also stay under bulkCreditLimit, which the firmware keeps lower while
+    // the paste lane is full, so live input and cancelBulk() are never queued behind a paste.
+    // Limits stay null on firmware that never sends them. window is the largest headroom
+    // advertised so far, so a composite wider than the firmware can ever grant still goes out.
+    const credits = useRef({ sent: 0, limit: null, bulkLimit: null, window: 1, waiters: [] });
+
+    // Keystroke pacing stamped on every packet this session; TYPING_DEFAULT defers to slowMode
+    const typingProfile = useRef(ToothPacketPB.TypingProfile.TYPING_STANDARD);
+    const setTypingProfile = (profile) => {
+        typingProfile.current = profile;
+    };
+
+    // Start counting writes from zero for a new link and release anything still waiting
+    const resetCredits = () => {
+        const old = credits.current;
+        credits.current = { sent: 0, limit: null, bulkLimit: null, window: 1, waiters: [] };
+        old.limit = null;
+        old.waiters.splice(0).forEach((resolve) => resolve());
+    };
+
+    // Wait until the firmware allows a write spending n credits, then claim them.
+    // Bulk writes wait on the lower bulk limit as well.
+    const takeCredit = async (n = 1, bulk = false) => {
+        const c = credits.current;
+        const gate = () => (bulk && c.bulkLimit !== null) ? Math.min(c.limit, c.bulkLimit) : c.limit;
+        while (c.limit !== null && gate() - c.sent < Math.min(n, c.window)) {
+            await new Promise((resolve) => c.waiters.push(resolve));
+        }
+        c.sent += n;
+    };
+
+    // Send a text string as a byte array without encryption (AUTH packets)
+    const sendUnencrypted = async (inputString, resumeTicket = null) => {
         try {
-            const packetData = createUnencryptedPacket(inputString);
+            const packetData = createUnencryptedPacket(inputString, resumeTicket);
+            await takeCredit();
             await pktCharRef.current.writeValueWithoutResponse(packetData);
         } catch (error) {
             console.error("Error sending AUTH packet", error);
         }
     };
 
+    // Multi-packet transfers are numbered without an ID, so only one may be on the air at a time
+    const transferChain = useRef(Promise.resolve());
+
+    // Bumped by cancelBulk(); bulk sends stop writing once it changes
+    const bulkGeneration = useRef(0);
+
     // Encrypt and send untyped data stream (string, array, etc.) with a random IV and GCM tag added, chunk data if too large
     // inputPayload can be a single payload or an array of payloads
+    // An array is sent as one numbered transfer that the firmware reassembles and reports as one job
     // Uses a FIFO queue where encryption produces packets and sending consumes them concurrently
     // (encoding into protobuf must be done by the calling function)
-    const sendEncrypted = async (inputPayload, prefix=0) => {
+    // bulk marks paste / script text: the firmware types live input ahead of it and cancelBulk() drops it
+    const sendEncrypted = async (inputPayload, prefix=0, bulk=false) => {
+        if (!pktCharacteristic) return;
+
+        // Determine if input is an array or single payload
+        const payloads = Array.isArray(inputPayload) ? inputPayload : [inputPayload];
+        const generation = bulkGeneration.current;
+
+        if (payloads.length > 1) {
+            const previous = transferChain.current;
+            const transfer = previous.then(() => sendPayloads(payloads, prefix, bulk, generation));
+            transferChain.current = transfer.catch(() => {});
+            return transfer;
+        }
+
+        return sendPayloads(payloads, prefix, bulk, generation);
+    };
+
+    // Stop bulk text: drop its unsent packets here and its queued text on the receiver
+    const cancelBulk = async () => {
+        bulkGeneration.current++;
         if (!pktCharacteristic) return;
+        return sendPayloads([createCancelPacket()], 0, false);
+    };
 
+    const sendPayloads = async (payloads, prefix, bulk = false, generation = bulkGeneration.current) => {
         // Create a packet queue to hold encrypted packets before sending
         const packetQueue = new PacketQueue();
+        const totalPackets = payloads.length;
         
         try {
-            // Determine if input is an array or single payload
-            const payloads = Array.isArray(inputPayload) ? inputPayload : [inputPayload];
-            
             // Producer: Encrypt payloads and enqueue them
             const producerTask = (async () => {
                 try {
-                    for (const payload of payloads) {
-                        for await (const packet of createEncryptedPackets(0, payload, true, prefix)) {
+                    for (const [index, payload] of payloads.entries()) {
+                        for await (const packet of createEncryptedPackets(0, payload, true, prefix, index + 1, totalPackets, typingProfile.current, bulk)) {
                             packetQueue.enqueue(packet);
                         }
                     }
@@ -87,8 +153,10 @@ export function BLEProvider({ children }) {
                 while (true) {
                     const packet = await packetQueue.dequeue();
                     if (packet === null) break;
+                    if (bulk && bulkGeneration.current !== generation) continue; // Cancelled: drain without sending
                     
                     // Each packet is a ToothPaste DataPacket object with encryptedData component
+                    await takeCredit(packet.credits || 1, bulk);
                     await pktCharacteristic.writeValueWithoutResponse(
                         toBinary(ToothPacketPB.DataPacketSchema, packet)
                     );
@@ -110,9 +178,10 @@ export function BLEProvider({ children }) {
         try {
             const selfPublicKey = await loadBase64(device.macAddress, "SelfPublicKey");
 
-            // If the public key is found send it to verify auth
+            // If the public key is found send it to verify auth, with our resumption ticket if we have one
             if (selfPublicKey) {
-                sendUnencrypted(selfPublicKey);
+                const resumeTicket = await loadResumeTicket(device.macAddress);
+                sendUnencrypted(selfPublicKey, resumeTicket);
             }
 
         } catch (error) {
@@ -132,9 +201,21 @@ export function BLEProvider({ children }) {
                 const base64String = btoa(String.fromCharCode.apply(null, bytesArray));
 
                 var responsePacket = unpackResponsePacket(bytesArray);
+
+                // Every response carries the current link limits (0 on older firmware)
+                setMaxPayload(responsePacket.maxPayload);
+                setAbsolutePointer(responsePacket.absolutePointer);
                 
                 if (responsePacket.responseType === ToothPacketPB.ResponsePacket_ResponseType.CHALLENGE) {
+                    // A resumed session is keyed from the ticket, a full handshake from ECDH;
+                    // either way the new session key replaces the ticket, as on the device
+                    if (responsePacket.resumed) {
+                        await resumeKeys(deviceObj.macAddress, responsePacket.challengeData);
+                    }
+                    else {
                         await loadKeys(deviceObj.macAddress, responsePacket.challengeData);
+                    }
+                    await issueResumeTicket(deviceObj.macAddress);
                     setStatus(ConnectionStatus.ready);
                 }
 
@@ -148,6 +229,15 @@ export function BLEProvider({ children }) {
                     setStatus(ConnectionStatus.connected);
                 }
 
+                // Both carry the current limit; waiting senders re-check it
+                else if (responsePacket.responseType === ToothPacketPB.ResponsePacket_ResponseType.RECV_READY ||
+                         responsePacket.responseType === ToothPacketPB.ResponsePacket_ResponseType.RECV_NOT_READY) {
+                    credits.current.limit = responsePacket.creditLimit;
+                    credits.current.bulkLimit = responsePacket.bulkCreditLimit || null; // 0: no separate bulk limit
+                    credits.current.window = Math.max(credits.current.window, responsePacket.creditLimit - credits.current.sent);
+                    credits.current.waiters.splice(0).forEach((resolve) => resolve());
+                }
+
                 console.log("Firmware version:", responsePacket.firmwareVersion);
                 if (!isVersionCompatible(responsePacket.firmwareVersion, supportedFirmwareVersions)) {
                     console.error("Incompatible firmware version:", responsePacket.firmwareVersion);
@@ -182,6 +272,9 @@ export function BLEProvider({ children }) {
             // Set an on disconnect listener
             device.addEventListener("gattserverdisconnected", () => {  
                 setStatus(ConnectionStatus.disconnected); // Set status to disconnected
+                resetCredits();
+                setMaxPayload(0);
+                setAbsolutePointer(false);
                 setDevice(null); // Clear the device object, not doing this causes inconsistent connections when trying to reconnect
 
                 console.log("Clipboard Disconnected");
@@ -193,6 +286,7 @@ export function BLEProvider({ children }) {
             }
 
             const server = device.gatt;
+            resetCredits(); // The firmware counts writes from connect
             await new Promise(r => setTimeout(r, 200)); // Wait a bit before getting any GATT information
 
             // Get device info, retry on fail for each
@@ -271,7 +365,10 @@ export function BLEProvider({ children }) {
         readyToReceive,
         sendEncrypted,
         sendUnencrypted,
-    }), [device, server, pktCharacteristic, status, connectToDevice, readyToReceive, sendEncrypted, sendUnencrypted]);
+        setTypingProfile,
+        cancelBulk,
+        absolutePointer,
+    }), [device, server, pktCharacteristic, status, connectToDevice, readyToReceive, sendEncrypted, sendUnencrypted, setTypingProfile, cancelBulk, absolutePointer]);
 
     return (
         <BLEContext.Provider value={contextValue}>
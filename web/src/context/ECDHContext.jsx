@@ -247,7 +247,7 @@ export const ECDHProvider = ({ children }) => {
                 name: "AES-GCM",
                 length: 256,
             },
-            true, // not extractable
+            true, // extractable: issueResumeTicket derives the next ticket from the raw key
             ["encrypt", "decrypt"]
         );
 
@@ -262,6 +262,64 @@ export const ECDHProvider = ({ children }) => {
 
     };
 
+    /**
+     * HKDF-SHA256 with the all-zero salt used for resumption tickets
+     * @param {ArrayBuffer|Uint8Array} ikm - Input key material
+     * @param {string} info - Context string, must match the firmware
+     * @param {number} bits - Output length in bits
+     * @returns {Promise<ArrayBuffer>} Derived bytes
+     */
+    const deriveTicketBits = async (ikm, info, bits) => {
+        const keyMaterial = await crypto.subtle.importKey("raw", ikm, "HKDF", false, ["deriveBits"]);
+        return await crypto.subtle.deriveBits(
+            {
+                name: "HKDF",
+                hash: "SHA-256",
+                salt: new Uint8Array(32),
+                info: new TextEncoder().encode(info),
+            },
+            keyMaterial,
+            bits
+        );
+    };
+
+    /**
+     * Store the resumption ticket for the current session, replacing the last one
+     * The firmware derives the same ticket from its copy of the session key after every
+     * handshake, so the next reconnect can be keyed from it without ECDH
+     * @param {string} clientID - Device MAC address or client identifier to store under
+     * @returns {Promise<void>}
+     */
+    const issueResumeTicket = async (clientID) => {
+        const sessionKey = await crypto.subtle.exportKey("raw", aesKey.current);
+        const ticketSecret = await deriveTicketBits(sessionKey, "toothpaste-resume", 256);
+        const ticketId = await deriveTicketBits(ticketSecret, "toothpaste-ticket-id", 64);
+
+        await saveBase64(clientID, "resumeSecret", arrayBufferToBase64(ticketSecret));
+        await saveBase64(clientID, "resumeTicket", arrayBufferToBase64(ticketId));
+    };
+
+    /**
+     * Load the ID of the resumption ticket held for a device
+     * @param {string} clientID - Device MAC address or client identifier
+     * @returns {Promise<Uint8Array|null>} Ticket ID (8 bytes), or null if none is stored
+     */
+    const loadResumeTicket = async (clientID) => {
+        const ticketIdB64 = await loadBase64(clientID, "resumeTicket");
+        return ticketIdB64 ? new Uint8Array(base64ToArrayBuffer(ticketIdB64)) : null;
+    };
+
+    /**
+     * Derive the session key from the stored resumption ticket instead of the shared secret
+     * @param {string} clientID - Device MAC address or client identifier to load from
+     * @param {Uint8Array} salt - HKDF salt from the CHALLENGE response
+     * @returns {Promise<void>} Updates internal aesKey.current state
+     */
+    const resumeKeys = async (clientID, salt) => {
+        const ticketSecretB64 = await loadBase64(clientID, "resumeSecret");
+        await deriveAESKey(base64ToArrayBuffer(ticketSecretB64), salt);
+    };
+
     /**
      * Encrypt data using AES-GCM with the derived shared secret key
      * Generates random 12-byte IV and returns authentication tag separately
@@ -329,9 +387,13 @@ export const ECDHProvider = ({ children }) => {
      * @param {Object} payload - Protobuf EncryptedData object to encrypt
      * @param {boolean} [slowMode=true] - Whether to use slow transmission mode
      * @param {number} [packetPrefix=0] - Prefix byte for packet identification
+     * @param {number} [packetNumber=1] - Position of this packet in a multi-packet transfer (1-based)
+     * @param {number} [totalPackets=1] - Packets in the transfer; 1 for a standalone command
+     * @param {number} [typingProfile=TYPING_DEFAULT] - Keystroke pacing; overrides slowMode when set
+     * @param {boolean} [bulk=false] - Paste / script text that live input may overtake and CANCEL drops
      * @yields {Object} DataPacket with encryptedData, IV, tag, and metadata
      */
-    const createEncryptedPackets = async function* (packetId, payload, slowMode = true, packetPrefix=0) {
+    const createEncryptedPackets = async function* (packetId, payload, slowMode = true, packetPrefix=0, packetNumber = 1, totalPackets = 1, typingProfile = ToothPacketPB.TypingProfile.TYPING_DEFAULT, bulk = false) {
         
         // Convert the protobuf payload to a byte array for encryption
         const toothPacketBinary = toBinary(ToothPacketPB.EncryptedDataSchema, payload);
@@ -342,10 +404,17 @@ export const ECDHProvider = ({ children }) => {
         // Set packet metadata
         encryptedPacket.packetID = packetId;
         encryptedPacket.slowMode = slowMode;
+        encryptedPacket.typingProfile = typingProfile;
+        encryptedPacket.bulk = bulk;
+
+        // A composite queues one HID item per command, so it spends one flow-control credit per command
+        if (payload.packetData?.case === "compositePacket") {
+            encryptedPacket.credits = Math.max(1, payload.packetData.value.commands.length);
+        }
 
-        // Not used for now
-        encryptedPacket.packetNumber = 1;
-        encryptedPacket.totalPackets = 1;
+        // The firmware reassembles numbered packets into one transfer and skips duplicates / gaps
+        encryptedPacket.packetNumber = packetNumber;
+        encryptedPacket.totalPackets = totalPackets;
 
         yield encryptedPacket;
     };
@@ -437,6 +506,9 @@ export const ECDHProvider = ({ children }) => {
         decryptText,
         createEncryptedPackets,
         loadKeys,
+        issueResumeTicket,
+        loadResumeTicket,
+        resumeKeys,
         processPeerKeyAndGenerateSharedSecret,
     }), []);
 
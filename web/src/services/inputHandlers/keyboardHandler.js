@@ -9,13 +9,13 @@ import { createConsumerControlPacket } from '../packetService/packetFunctions';
  */
 export const keyboardHandler = {
     /**
-     * Send keyboard string input
+     * Send keyboard string input as bulk text: live input is typed ahead of it and it can be cancelled
      * @param {string} input - Text to send
      * @param {Function} sendEncrypted - Function to send encrypted packets
      */
     sendKeyboardString(input, sendEncrypted) {
         const packets = createKeyboardStream(input);
-        sendEncrypted(packets);
+        sendEncrypted(packets, 0, true);
     },
 
     /**
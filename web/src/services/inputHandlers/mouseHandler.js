@@ -1,4 +1,11 @@
-import { createMouseStream } from '../packetService/packetFunctions';
+import { createMouseStream, createPointerPacket } from '../packetService/packetFunctions';
+
+// Relative stand-in for the absolute pointer on receivers built without it: the cursor is
+// pushed into the top-left corner once, then moved by the distance to each new position on a
+// host screen of the assumed size. Host pointer acceleration makes it approximate.
+const FALLBACK_SCREEN = { width: 1920, height: 1080 };
+const HOME_DISTANCE = 8192; // Far enough past any screen edge to pin the cursor in the corner
+let fallbackPosition = null; // Host pixels the cursor was last moved to, null until homed
 
 /**
  * Mouse input handler service
@@ -36,5 +43,42 @@ export const mouseHandler = {
      */
     sendMouseScroll(scrollDelta = 0, sendEncrypted) {
         this.sendMouseReport([], 0, 0, scrollDelta, sendEncrypted);
+    },
+
+    /**
+     * Place the cursor at a screen position: in one report on receivers with the absolute
+     * pointer, otherwise with relative frames from the last position placed
+     * @param {number} x - Horizontal position, 0 (left edge) to 1 (right edge)
+     * @param {number} y - Vertical position, 0 (top edge) to 1 (bottom edge)
+     * @param {number} leftClick - Left click state (0, 1, or 2 for release)
+     * @param {number} rightClick - Right click state (0, 1, or 2 for release)
+     * @param {Function} sendEncrypted - Function to send encrypted packets
+     * @param {boolean} absolutePointer - Receiver reported ResponsePacket.absolutePointer
+     */
+    sendPointerPosition(x, y, leftClick = 0, rightClick = 0, sendEncrypted, absolutePointer = false) {
+        if (absolutePointer) {
+            const pointerPacket = createPointerPacket(x, y, leftClick, rightClick);
+            sendEncrypted(pointerPacket);
+            return;
+        }
+
+        const toPixels = (v, size) => Math.round(Math.min(Math.max(v, 0), 1) * size);
+        const frames = [];
+        if (fallbackPosition === null) {
+            frames.push({ x: -HOME_DISTANCE, y: -HOME_DISTANCE });
+            fallbackPosition = { x: 0, y: 0 };
+        }
+        const target = { x: toPixels(x, FALLBACK_SCREEN.width), y: toPixels(y, FALLBACK_SCREEN.height) };
+        frames.push({ x: target.x - fallbackPosition.x, y: target.y - fallbackPosition.y });
+        fallbackPosition = target;
+        this.sendMouseReport(frames, leftClick, rightClick, 0, sendEncrypted);
+    },
+
+    /**
+     * Forget where the relative fallback left the cursor, so the next position homes it first
+     * (the host cursor may have been moved by other means since)
+     */
+    resetPointerPosition() {
+        fallbackPosition = null;
     }
 };
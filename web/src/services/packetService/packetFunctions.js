@@ -2,7 +2,8 @@ import { create, toBinary, fromBinary } from "@bufbuild/protobuf";
 import * as ToothPacketPB from './toothpacket/toothpacket_pb.js';
 
 // Create an unencrypted DataPacket from an input string
-export function createUnencryptedPacket(inputString) {
+// resumeTicket is the ID of the resumption ticket held for this receiver, if any
+export function createUnencryptedPacket(inputString, resumeTicket = null) {
     const encoder = new TextEncoder();
     const textData = encoder.encode(inputString); // Encode the input string into a byte array
 
@@ -16,6 +17,12 @@ export function createUnencryptedPacket(inputString) {
     unencryptedPacket.tag = new Uint8Array(16); // Empty tag for unencrypted packet
     unencryptedPacket.iv = new Uint8Array(12); // Empty IV for unencrypted packet
 
+    // Ask for a resumption ticket and offer the one we hold, so a reconnect can skip ECDH
+    unencryptedPacket.resume = true;
+    if (resumeTicket) {
+        unencryptedPacket.resumeTicket = resumeTicket;
+    }
+
     return toBinary(ToothPacketPB.DataPacketSchema, unencryptedPacket);
 }
 
@@ -70,6 +77,32 @@ export function createMouseStream(frames, leftClick = false, rightClick = false,
     return encryptedPacket
 }
 
+// Largest coordinate of the receiver's absolute pointer; 0 and POINTER_MAX are opposite screen edges
+export const POINTER_MAX = 32767;
+
+// Return an EncryptedData packet containing a PointerPacket. x and y are fractions of the
+// host screen (0 = left / top, 1 = right / bottom) and are clamped to it.
+export function createPointerPacket(x, y, leftClick = 0, rightClick = 0, scrollDelta = 0) {
+    const toAxis = (v) => Math.round(Math.min(Math.max(v, 0), 1) * POINTER_MAX);
+
+    const pointerPacket = create(ToothPacketPB.PointerPacketSchema, {});
+    pointerPacket.x = toAxis(x);
+    pointerPacket.y = toAxis(y);
+    pointerPacket.lClick = Number(leftClick);
+    pointerPacket.rClick = Number(rightClick);
+    pointerPacket.wheel = scrollDelta;
+
+    const encryptedPacket = create(ToothPacketPB.EncryptedDataSchema, {
+        packetType: ToothPacketPB.EncryptedData_PacketType.POINTER,
+        packetData: {
+        case: "pointerPacket",
+        value: pointerPacket,
+        },
+    });
+
+    return encryptedPacket;
+}
+
 // Return an EncryptedData packet containing a KeyboardPacket
 export function createKeyboardPacket(keyString) {
 
@@ -89,16 +122,49 @@ export function createKeyboardPacket(keyString) {
     return encryptedPacket
 }
 
+// EncryptedData bytes around a KeyboardPacket message: packetType, oneof header, message header, length
+const KEYBOARD_PACKET_OVERHEAD = 11;
+const DEFAULT_KEYBOARD_CHUNK_BYTES = 180;
+let keyboardChunkBytes = DEFAULT_KEYBOARD_CHUNK_BYTES;
+
+// Size keyboard chunks to the encrypted payload limit the receiver reports for this link
+// (ResponsePacket.maxPayload); 0 restores the default for firmware that doesn't report one
+export function setMaxPayload(maxPayload) {
+    keyboardChunkBytes = maxPayload > KEYBOARD_PACKET_OVERHEAD
+        ? maxPayload - KEYBOARD_PACKET_OVERHEAD
+        : DEFAULT_KEYBOARD_CHUNK_BYTES;
+}
+
+// Split a string into pieces of at most maxBytes UTF-8 bytes without breaking a character
+function splitUtf8(fullString, maxBytes) {
+    const chunks = [];
+    let chunk = '';
+    let chunkBytes = 0;
+
+    for (const ch of fullString) {
+        const cp = ch.codePointAt(0);
+        const bytes = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+        if (chunkBytes + bytes > maxBytes) {
+            chunks.push(chunk);
+            chunk = '';
+            chunkBytes = 0;
+        }
+        chunk += ch;
+        chunkBytes += bytes;
+    }
+    if (chunk.length > 0) chunks.push(chunk);
+
+    return chunks;
+}
+
 export function createKeyboardStream(keyStrings) {
     // Handle both single string and array of strings
     let fullString = Array.isArray(keyStrings) ? keyStrings.join('') : keyStrings;
     
     const packets = [];
-    const chunkSize = 100; // Max characters per packet
     
-    // Split string into chunks and create a packet for each
-    for (let i = 0; i < fullString.length; i += chunkSize) {
-        const chunk = fullString.substring(i, i + chunkSize);
+    // Split string into chunks that fit the link and create a packet for each
+    for (const chunk of splitUtf8(fullString, keyboardChunkBytes)) {
         
         const keyboardPacket = create(ToothPacketPB.KeyboardPacketSchema, {});
         keyboardPacket.message = chunk;
@@ -185,6 +251,60 @@ export function createMouseJigglePacket(enable) {
     return encryptedPacket;
 }
 
+// Return an EncryptedData packet selecting the receiver's keyboard layout. customTable
+// (128 bytes, firmware layout encoding) is only sent with KeyboardLayoutPacket_LayoutID.CUSTOM.
+export function createKeyboardLayoutPacket(layout, customTable = null) {
+    const layoutPacket = create(ToothPacketPB.KeyboardLayoutPacketSchema, {});
+    layoutPacket.layout = layout;
+    if (layout === ToothPacketPB.KeyboardLayoutPacket_LayoutID.CUSTOM && customTable) {
+        layoutPacket.customTable = customTable;
+    }
+
+    const encryptedPacket = create(ToothPacketPB.EncryptedDataSchema, {
+        packetType: ToothPacketPB.EncryptedData_PacketType.KEYBOARD_LAYOUT,
+        packetData: {
+        case: "keyboardLayoutPacket",
+        value: layoutPacket,
+        },
+    });
+
+    return encryptedPacket;
+}
+
+// Return an EncryptedData packet that drops queued bulk text (pastes, scripts) on the
+// receiver; mouse also drops queued mouse movement
+export function createCancelPacket(mouse = false) {
+    const cancelPacket = create(ToothPacketPB.CancelPacketSchema, {});
+    cancelPacket.mouse = mouse;
+
+    const encryptedPacket = create(ToothPacketPB.EncryptedDataSchema, {
+        packetType: ToothPacketPB.EncryptedData_PacketType.CANCEL,
+        packetData: {
+        case: "cancelPacket",
+        value: cancelPacket,
+        },
+    });
+
+    return encryptedPacket;
+}
+
+// Return an EncryptedData packet wrapping several EncryptedData commands that the
+// device executes in order after a single decrypt
+export function createCompositePacket(commands) {
+    const compositePacket = create(ToothPacketPB.CompositePacketSchema, {});
+    compositePacket.commands.push(...commands);
+
+    const encryptedPacket = create(ToothPacketPB.EncryptedDataSchema, {
+        packetType: ToothPacketPB.EncryptedData_PacketType.COMPOSITE,
+        packetData: {
+        case: "compositePacket",
+        value: compositePacket,
+        },
+    });
+
+    return encryptedPacket;
+}
+
 export function unpackResponsePacket(responsePacketBytes) {
     
     // Deserialize the ResponsePacket from binary data
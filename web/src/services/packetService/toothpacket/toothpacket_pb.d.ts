@@ -73,6 +73,41 @@ export declare type DataPacket = Message<"toothpaste.DataPacket"> & {
    * @generated from field: bytes tag = 8;
    */
   tag: Uint8Array;
+
+  /**
+   * 1 - 2 bytes, overrides slowMode when set
+   *
+   * @generated from field: toothpaste.TypingProfile typingProfile = 9;
+   */
+  typingProfile: TypingProfile;
+
+  /**
+   * 1 byte, paste / script text that live input may overtake
+   *
+   * @generated from field: bool bulk = 10;
+   */
+  bulk: boolean;
+
+  /**
+   * 1 byte, AUTH only: client keeps a resumption ticket for this receiver
+   *
+   * @generated from field: bool resume = 11;
+   */
+  resume: boolean;
+
+  /**
+   * 8 bytes, AUTH only: ID of the ticket held, empty for none
+   *
+   * @generated from field: bytes resumeTicket = 12;
+   */
+  resumeTicket: Uint8Array;
+
+  /**
+   * 1 - 2 bytes, input credits this write spent: one per CompositePacket command, 0 means 1
+   *
+   * @generated from field: uint32 credits = 13;
+   */
+  credits: number;
 };
 
 /**
@@ -151,6 +186,30 @@ export declare type EncryptedData = Message<"toothpaste.EncryptedData"> & {
      */
     value: MouseJigglePacket;
     case: "mouseJigglePacket";
+  } | {
+    /**
+     * @generated from field: toothpaste.CompositePacket compositePacket = 8;
+     */
+    value: CompositePacket;
+    case: "compositePacket";
+  } | {
+    /**
+     * @generated from field: toothpaste.KeyboardLayoutPacket keyboardLayoutPacket = 9;
+     */
+    value: KeyboardLayoutPacket;
+    case: "keyboardLayoutPacket";
+  } | {
+    /**
+     * @generated from field: toothpaste.CancelPacket cancelPacket = 10;
+     */
+    value: CancelPacket;
+    case: "cancelPacket";
+  } | {
+    /**
+     * @generated from field: toothpaste.PointerPacket pointerPacket = 11;
+     */
+    value: PointerPacket;
+    case: "pointerPacket";
   } | { case: undefined; value?: undefined };
 };
 
@@ -195,6 +254,21 @@ export enum EncryptedData_PacketType {
    * @generated from enum value: COMPOSITE = 5;
    */
   COMPOSITE = 5,
+
+  /**
+   * @generated from enum value: KEYBOARD_LAYOUT = 6;
+   */
+  KEYBOARD_LAYOUT = 6,
+
+  /**
+   * @generated from enum value: CANCEL = 7;
+   */
+  CANCEL = 7,
+
+  /**
+   * @generated from enum value: POINTER = 8;
+   */
+  POINTER = 8,
 }
 
 /**
@@ -226,6 +300,62 @@ export declare type ResponsePacket = Message<"toothpaste.ResponsePacket"> & {
    * @generated from field: string firmwareVersion = 3;
    */
   firmwareVersion: string;
+
+  /**
+   * total input credits the client may have sent since connecting
+   *
+   * @generated from field: uint32 creditLimit = 4;
+   */
+  creditLimit: number;
+
+  /**
+   * negotiated ATT MTU
+   *
+   * @generated from field: uint32 attMtu = 5;
+   */
+  attMtu: number;
+
+  /**
+   * largest DataPacket.encryptedData the receiver accepts on this link
+   *
+   * @generated from field: uint32 maxPayload = 6;
+   */
+  maxPayload: number;
+
+  /**
+   * 1 = LE 1M, 2 = LE 2M, 3 = LE Coded, 0 = unknown
+   *
+   * @generated from field: uint32 phy = 7;
+   */
+  phy: number;
+
+  /**
+   * current connection interval in 1.25 ms units
+   *
+   * @generated from field: uint32 connInterval = 8;
+   */
+  connInterval: number;
+
+  /**
+   * CHALLENGE only: session key derived from the resumption ticket, not ECDH
+   *
+   * @generated from field: bool resumed = 9;
+   */
+  resumed: boolean;
+
+  /**
+   * lower limit for bulk writes, so a paste leaves room for live input; 0 = creditLimit
+   *
+   * @generated from field: uint32 bulkCreditLimit = 10;
+   */
+  bulkCreditLimit: number;
+
+  /**
+   * receiver has the absolute pointer interface; false: PointerPacket is ignored, move with MousePacket frames
+   *
+   * @generated from field: bool absolutePointer = 11;
+   */
+  absolutePointer: boolean;
 };
 
 /**
@@ -259,6 +389,20 @@ export enum ResponsePacket_ResponseType {
    * @generated from enum value: CHALLENGE = 3;
    */
   CHALLENGE = 3,
+
+  /**
+   * creditLimit raised, client may send up to it
+   *
+   * @generated from enum value: RECV_READY = 4;
+   */
+  RECV_READY = 4,
+
+  /**
+   * receiver full, hold writes until the next RECV_READY
+   *
+   * @generated from enum value: RECV_NOT_READY = 5;
+   */
+  RECV_NOT_READY = 5,
 }
 
 /**
@@ -461,3 +605,223 @@ export declare type MouseJigglePacket = Message<"toothpaste.MouseJigglePacket">
  */
 export declare const MouseJigglePacketSchema: GenMessage<MouseJigglePacket>;
 
+/**
+ * Ordered batch of commands executed from a single encrypted DataPacket
+ *
+ * @generated from message toothpaste.CompositePacket
+ */
+export declare type CompositePacket = Message<"toothpaste.CompositePacket"> & {
+  /**
+   * run in order, nested batches are rejected
+   *
+   * @generated from field: repeated toothpaste.EncryptedData commands = 1;
+   */
+  commands: EncryptedData[];
+};
+
+/**
+ * Describes the message toothpaste.CompositePacket.
+ * Use `create(CompositePacketSchema)` to create a new message.
+ */
+export declare const CompositePacketSchema: GenMessage<CompositePacket>;
+
+/**
+ * Select the layout the receiver types with; kept across reboots
+ *
+ * @generated from message toothpaste.KeyboardLayoutPacket
+ */
+export declare type KeyboardLayoutPacket = Message<"toothpaste.KeyboardLayoutPacket"> & {
+  /**
+   * @generated from field: toothpaste.KeyboardLayoutPacket.LayoutID layout = 1;
+   */
+  layout: KeyboardLayoutPacket_LayoutID;
+
+  /**
+   * 128 bytes, one entry per ASCII character (firmware KeyboardLayout.h encoding)
+   *
+   * @generated from field: bytes customTable = 2;
+   */
+  customTable: Uint8Array;
+};
+
+/**
+ * Describes the message toothpaste.KeyboardLayoutPacket.
+ * Use `create(KeyboardLayoutPacketSchema)` to create a new message.
+ */
+export declare const KeyboardLayoutPacketSchema: GenMessage<KeyboardLayoutPacket>;
+
+/**
+ * @generated from enum toothpaste.KeyboardLayoutPacket.LayoutID
+ */
+export enum KeyboardLayoutPacket_LayoutID {
+  /**
+   * @generated from enum value: EN_US = 0;
+   */
+  EN_US = 0,
+
+  /**
+   * @generated from enum value: DE_DE = 1;
+   */
+  DE_DE = 1,
+
+  /**
+   * @generated from enum value: ES_ES = 2;
+   */
+  ES_ES = 2,
+
+  /**
+   * @generated from enum value: FR_FR = 3;
+   */
+  FR_FR = 3,
+
+  /**
+   * @generated from enum value: IT_IT = 4;
+   */
+  IT_IT = 4,
+
+  /**
+   * @generated from enum value: PT_PT = 5;
+   */
+  PT_PT = 5,
+
+  /**
+   * @generated from enum value: SV_SE = 6;
+   */
+  SV_SE = 6,
+
+  /**
+   * @generated from enum value: DA_DK = 7;
+   */
+  DA_DK = 7,
+
+  /**
+   * @generated from enum value: HU_HU = 8;
+   */
+  HU_HU = 8,
+
+  /**
+   * @generated from enum value: PT_BR = 9;
+   */
+  PT_BR = 9,
+
+  /**
+   * customTable, uploaded by the client
+   *
+   * @generated from enum value: CUSTOM = 10;
+   */
+  CUSTOM = 10,
+}
+
+/**
+ * Describes the enum toothpaste.KeyboardLayoutPacket.LayoutID.
+ */
+export declare const KeyboardLayoutPacket_LayoutIDSchema: GenEnum<KeyboardLayoutPacket_LayoutID>;
+
+/**
+ * Drop queued bulk keyboard text and lift any keys it holds; live input is kept
+ *
+ * @generated from message toothpaste.CancelPacket
+ */
+export declare type CancelPacket = Message<"toothpaste.CancelPacket"> & {
+  /**
+   * also drop queued mouse movement
+   *
+   * @generated from field: bool mouse = 1;
+   */
+  mouse: boolean;
+};
+
+/**
+ * Describes the message toothpaste.CancelPacket.
+ * Use `create(CancelPacketSchema)` to create a new message.
+ */
+export declare const CancelPacketSchema: GenMessage<CancelPacket>;
+
+/**
+ * Absolute cursor position on the host screen, sent in a single report
+ *
+ * @generated from message toothpaste.PointerPacket
+ */
+export declare type PointerPacket = Message<"toothpaste.PointerPacket"> & {
+  /**
+   * 0 (left edge) - 32767 (right edge)
+   *
+   * @generated from field: uint32 x = 1;
+   */
+  x: number;
+
+  /**
+   * 0 (top edge) - 32767 (bottom edge)
+   *
+   * @generated from field: uint32 y = 2;
+   */
+  y: number;
+
+  /**
+   * left click state, as in MousePacket
+   *
+   * @generated from field: int32 l_click = 3;
+   */
+  lClick: number;
+
+  /**
+   * right click state
+   *
+   * @generated from field: int32 r_click = 4;
+   */
+  rClick: number;
+
+  /**
+   * wheel movement
+   *
+   * @generated from field: int32 wheel = 5;
+   */
+  wheel: number;
+};
+
+/**
+ * Describes the message toothpaste.PointerPacket.
+ * Use `create(PointerPacketSchema)` to create a new message.
+ */
+export declare const PointerPacketSchema: GenMessage<PointerPacket>;
+
+/**
+ * Keystroke pacing for typed text and keycodes
+ *
+ * @generated from enum toothpaste.TypingProfile
+ */
+export enum TypingProfile {
+  /**
+   * slowMode picks CONSERVATIVE, otherwise the receiver's default
+   *
+   * @generated from enum value: TYPING_DEFAULT = 0;
+   */
+  TYPING_DEFAULT = 0,
+
+  /**
+   * one report per USB frame
+   *
+   * @generated from enum value: TYPING_FULL_SPEED = 1;
+   */
+  TYPING_FULL_SPEED = 1,
+
+  /**
+   * short hold and gap, safe for desktop OSes
+   *
+   * @generated from enum value: TYPING_STANDARD = 2;
+   */
+  TYPING_STANDARD = 2,
+
+  /**
+   * long hold and gap for BIOS / KVM targets
+   *
+   * @generated from enum value: TYPING_CONSERVATIVE = 3;
+   */
+  TYPING_CONSERVATIVE = 3,
+}
+
+/**
+ * Describes the enum toothpaste.TypingProfile.
+ */
+export declare const TypingProfileSchema: GenEnum<TypingProfile>;
+
@@ -8,7 +8,7 @@ import { enumDesc, fileDesc, messageDesc, tsEnum } from "@bufbuild/protobuf/code
  * Describes the file toothpacket.proto.
  */
 export const file_toothpacket = /*@__PURE__*/
-  fileDesc("ChF0b290aHBhY2tldC5wcm90bxIKdG9vdGhwYXN0ZSLsAQoKRGF0YVBhY2tldBIxCghwYWNrZXRJRBgBIAEoDjIfLnRvb3RocGFzdGUuRGF0YVBhY2tldC5QYWNrZXRJRBIUCgxwYWNrZXROdW1iZXIYAiABKA0SFAoMdG90YWxQYWNrZXRzGAMgASgNEhAKCHNsb3dNb2RlGAQgASgIEgoKAml2GAUgASgMEg8KB2RhdGFMZW4YBiABKA0SFQoNZW5jcnlwdGVkRGF0YRgHIAEoDBILCgN0YWcYCCABKAwiLAoIUGFja2V0SUQSDwoLREFUQV9QQUNLRVQQABIPCgtBVVRIX1BBQ0tFVBABIpgECg1FbmNyeXB0ZWREYXRhEjgKCnBhY2tldFR5cGUYASABKA4yJC50b290aHBhc3RlLkVuY3J5cHRlZERhdGEuUGFja2V0VHlwZRI0Cg5rZXlib2FyZFBhY2tldBgCIAEoCzIaLnRvb3RocGFzdGUuS2V5Ym9hcmRQYWNrZXRIABIyCg1rZXljb2RlUGFja2V0GAMgASgLMhkudG9vdGhwYXN0ZS5LZXljb2RlUGFja2V0SAASLgoLbW91c2VQYWNrZXQYBCABKAsyFy50b290aHBhc3RlLk1vdXNlUGFja2V0SAASMAoMcmVuYW1lUGFja2V0GAUgASgLMhgudG9vdGhwYXN0ZS5SZW5hbWVQYWNrZXRIABJCChVjb25zdW1lckNvbnRyb2xQYWNrZXQYBiABKAsyIS50b290aHBhc3RlLkNvbnN1bWVyQ29udHJvbFBhY2tldEgAEjoKEW1vdXNlSmlnZ2xlUGFja2V0GAcgASgLMh0udG9vdGhwYXN0ZS5Nb3VzZUppZ2dsZVBhY2tldEgAInMKClBhY2tldFR5cGUSEwoPS0VZQk9BUkRfU1RSSU5HEAASFAoQS0VZQk9BUkRfS0VZQ09ERRABEgkKBU1PVVNFEAISCgoGUkVOQU1FEAMSFAoQQ09OU1VNRVJfQ09OVFJPTBAEEg0KCUNPTVBPU0lURRAFQgwKCnBhY2tldERhdGEizwEKDlJlc3BvbnNlUGFja2V0Ej0KDHJlc3BvbnNlVHlwZRgBIAEoDjInLnRvb3RocGFzdGUuUmVzcG9uc2VQYWNrZXQuUmVzcG9uc2VUeXBlEhUKDWNoYWxsZW5nZURhdGEYAiABKAwSFwoPZmlybXdhcmVWZXJzaW9uGAMgASgJIk4KDFJlc3BvbnNlVHlwZRINCglLRUVQQUxJVkUQABIQCgxQRUVSX1VOS05PV04QARIOCgpQRUVSX0tOT1dOEAISDQoJQ0hBTExFTkdFEAMiMQoOS2V5Ym9hcmRQYWNrZXQSDwoHbWVzc2FnZRgBIAEoCRIOCgZsZW5ndGgYAiABKA0iLwoMUmVuYW1lUGFja2V0Eg8KB21lc3NhZ2UYASABKAkSDgoGbGVuZ3RoGAIgASgNIi0KDUtleWNvZGVQYWNrZXQSDAoEY29kZRgBIAEoDBIOCgZsZW5ndGgYAiABKA0iHQoFRnJhbWUSCQoBeBgBIAEoBRIJCgF5GAIgASgFInUKC01vdXNlUGFja2V0EhIKCm51bV9mcmFtZXMYASABKA0SIQoGZnJhbWVzGAIgAygLMhEudG9vdGhwYXN0ZS5GcmFtZRIPCgdsX2NsaWNrGAMgASgFEg8KB3JfY2xpY2sYBCABKAUSDQoFd2hlZWwYBSABKAUiNQoVQ29uc3VtZXJDb250cm9sUGFja2V0EgwKBGNvZGUYASADKA0SDgoGbGVuZ3RoGAIgASgNIiMKEU1vdXNlSmlnZ2xlUGFja2V0Eg4KBmVuYWJsZRgBIAEoCGIGcHJvdG8z");
+  fileDesc("ChF0b290aHBhY2tldC5wcm90bxIKdG9vdGhwYXN0ZSLjAgoKRGF0YVBhY2tldBIxCghwYWNrZXRJRBgBIAEoDjIfLnRvb3RocGFzdGUuRGF0YVBhY2tldC5QYWNrZXRJRBIUCgxwYWNrZXROdW1iZXIYAiABKA0SFAoMdG90YWxQYWNrZXRzGAMgASgNEhAKCHNsb3dNb2RlGAQgASgIEgoKAml2GAUgASgMEg8KB2RhdGFMZW4YBiABKA0SFQoNZW5jcnlwdGVkRGF0YRgHIAEoDBILCgN0YWcYCCABKAwSMAoNdHlwaW5nUHJvZmlsZRgJIAEoDjIZLnRvb3RocGFzdGUuVHlwaW5nUHJvZmlsZRIMCgRidWxrGAogASgIEg4KBnJlc3VtZRgLIAEoCBIUCgxyZXN1bWVUaWNrZXQYDCABKAwSDwoHY3JlZGl0cxgNIAEoDSIsCghQYWNrZXRJRBIPCgtEQVRBX1BBQ0tFVBAAEg8KC0FVVEhfUEFDS0VUEAEipwYKDUVuY3J5cHRlZERhdGESOAoKcGFja2V0VHlwZRgBIAEoDjIkLnRvb3RocGFzdGUuRW5jcnlwdGVkRGF0YS5QYWNrZXRUeXBlEjQKDmtleWJvYXJkUGFja2V0GAIgASgLMhoudG9vdGhwYXN0ZS5LZXlib2FyZFBhY2tldEgAEjIKDWtleWNvZGVQYWNrZXQYAyABKAsyGS50b290aHBhc3RlLktleWNvZGVQYWNrZXRIABIuCgttb3VzZVBhY2tldBgEIAEoCzIXLnRvb3RocGFzdGUuTW91c2VQYWNrZXRIABIwCgxyZW5hbWVQYWNrZXQYBSABKAsyGC50b290aHBhc3RlLlJlbmFtZVBhY2tldEgAEkIKFWNvbnN1bWVyQ29udHJvbFBhY2tldBgGIAEoCzIhLnRvb3RocGFzdGUuQ29uc3VtZXJDb250cm9sUGFja2V0SAASOgoRbW91c2VKaWdnbGVQYWNrZXQYByABKAsyHS50b290aHBhc3RlLk1vdXNlSmlnZ2xlUGFja2V0SAASNgoPY29tcG9zaXRlUGFja2V0GAggASgLMhsudG9vdGhwYXN0ZS5Db21wb3NpdGVQYWNrZXRIABJAChRrZXlib2FyZExheW91dFBhY2tldBgJIAEoCzIgLnRvb3RocGFzdGUuS2V5Ym9hcmRMYXlvdXRQYWNrZXRIABIwCgxjYW5jZWxQYWNrZXQYCiABKAsyGC50b290aHBhc3RlLkNhbmNlbFBhY2tldEgAEjIKDXBvaW50ZXJQYWNrZXQYCyABKAsyGS50b290aHBhc3RlLlBvaW50ZXJQYWNrZXRIACKhAQoKUGFja2V0VHlwZRITCg9LRVlCT0FSRF9TVFJJTkcQABIUChBLRVlCT0FSRF9LRVlDT0RFEAESCQoFTU9VU0UQAhIKCgZSRU5BTUUQAxIUChBDT05TVU1FUl9DT05UUk9MEAQSDQoJQ09NUE9TSVRFEAUSEwoPS0VZQk9BUkRfTEFZT1VUEAYSCgoGQ0FOQ0VMEAcSCwoHUE9JTlRFUhAIQgwKCnBhY2tldERhdGEikgMKDlJlc3BvbnNlUGFja2V0Ej0KDHJlc3BvbnNlVHlwZRgBIAEoDjInLnRvb3RocGFzdGUuUmVzcG9uc2VQYWNrZXQuUmVzcG9uc2VUeXBlEhUKDWNoYWxsZW5nZURhdGEYAiABKAwSFwoPZmlybXdhcmVWZXJzaW9uGAMgASgJEhMKC2NyZWRpdExpbWl0GAQgASgNEg4KBmF0dE10dRgFIAEoDRISCgptYXhQYXlsb2FkGAYgASgNEgsKA3BoeRgHIAEoDRIUCgxjb25uSW50ZXJ2YWwYCCABKA0SDwoHcmVzdW1lZBgJIAEoCBIXCg9idWxrQ3JlZGl0TGltaXQYCiABKA0SFwoPYWJzb2x1dGVQb2ludGVyGAsgASgIInIKDFJlc3BvbnNlVHlwZRINCglLRUVQQUxJVkUQABIQCgxQRUVSX1VOS05PV04QARIOCgpQRUVSX0tOT1dOEAISDQoJQ0hBTExFTkdFEAMSDgoKUkVDVl9SRUFEWRAEEhIKDlJFQ1ZfTk9UX1JFQURZEAUiMQoOS2V5Ym9hcmRQYWNrZXQSDwoHbWVzc2FnZRgBIAEoCRIOCgZsZW5ndGgYAiABKA0iLwoMUmVuYW1lUGFja2V0Eg8KB21lc3NhZ2UYASABKAkSDgoGbGVuZ3RoGAIgASgNIi0KDUtleWNvZGVQYWNrZXQSDAoEY29kZRgBIAEoDBIOCgZsZW5ndGgYAiABKA0iHQoFRnJhbWUSCQoBeBgBIAEoBRIJCgF5GAIgASgFInUKC01vdXNlUGFja2V0EhIKCm51bV9mcmFtZXMYASABKA0SIQoGZnJhbWVzGAIgAygLMhEudG9vdGhwYXN0ZS5GcmFtZRIPCgdsX2NsaWNrGAMgASgFEg8KB3JfY2xpY2sYBCABKAUSDQoFd2hlZWwYBSABKAUiNQoVQ29uc3VtZXJDb250cm9sUGFja2V0EgwKBGNvZGUYASADKA0SDgoGbGVuZ3RoGAIgASgNIiMKEU1vdXNlSmlnZ2xlUGFja2V0Eg4KBmVuYWJsZRgBIAEoCCI+Cg9Db21wb3NpdGVQYWNrZXQSKwoIY29tbWFuZHMYASADKAsyGS50b290aHBhc3RlLkVuY3J5cHRlZERhdGEi7QEKFEtleWJvYXJkTGF5b3V0UGFja2V0EjkKBmxheW91dBgBIAEoDjIpLnRvb3RocGFzdGUuS2V5Ym9hcmRMYXlvdXRQYWNrZXQuTGF5b3V0SUQSEwoLY3VzdG9tVGFibGUYAiABKAwihAEKCExheW91dElEEgkKBUVOX1VTEAASCQoFREVfREUQARIJCgVFU19FUxACEgkKBUZSX0ZSEAMSCQoFSVRfSVQQBBIJCgVQVF9QVBAFEgkKBVNWX1NFEAYSCQoFREFfREsQBxIJCgVIVV9IVRAIEgkKBVBUX0JSEAkSCgoGQ1VTVE9NEAoiHQoMQ2FuY2VsUGFja2V0Eg0KBW1vdXNlGAEgASgIIlYKDVBvaW50ZXJQYWNrZXQSCQoBeBgBIAEoDRIJCgF5GAIgASgNEg8KB2xfY2xpY2sYAyABKAUSDwoHcl9jbGljaxgEIAEoBRINCgV3aGVlbBgFIAEoBSpoCg1UeXBpbmdQcm9maWxlEhIKDlRZUElOR19ERUZBVUxUEAASFQoRVFlQSU5HX0ZVTExfU1BFRUQQARITCg9UWVBJTkdfU1RBTkRBUkQQAhIXChNUWVBJTkdfQ09OU0VSVkFUSVZFEANiBnByb3RvMw==");
 
 /**
  * Describes the message toothpaste.DataPacket.
@@ -122,3 +122,57 @@ export const ConsumerControlPacketSchema = /*@__PURE__*/
 export const MouseJigglePacketSchema = /*@__PURE__*/
   messageDesc(file_toothpacket, 9);
 
+/**
+ * Describes the message toothpaste.CompositePacket.
+ * Use `create(CompositePacketSchema)` to create a new message.
+ */
+export const CompositePacketSchema = /*@__PURE__*/
+  messageDesc(file_toothpacket, 10);
+
+/**
+ * Describes the message toothpaste.KeyboardLayoutPacket.
+ * Use `create(KeyboardLayoutPacketSchema)` to create a new message.
+ */
+export const KeyboardLayoutPacketSchema = /*@__PURE__*/
+  messageDesc(file_toothpacket, 11);
+
+/**
+ * Describes the enum toothpaste.KeyboardLayoutPacket.LayoutID.
+ */
+export const KeyboardLayoutPacket_LayoutIDSchema = /*@__PURE__*/
+  enumDesc(file_toothpacket, 11, 0);
+
+/**
+ * @generated from enum toothpaste.KeyboardLayoutPacket.LayoutID
+ */
+export const KeyboardLayoutPacket_LayoutID = /*@__PURE__*/
+  tsEnum(KeyboardLayoutPacket_LayoutIDSchema);
+
+/**
+ * Describes the message toothpaste.CancelPacket.
+ * Use `create(CancelPacketSchema)` to create a new message.
+ */
+export const CancelPacketSchema = /*@__PURE__*/
+  messageDesc(file_toothpacket, 12);
+
+/**
+ * Describes the message toothpaste.PointerPacket.
+ * Use `create(PointerPacketSchema)` to create a new message.
+ */
+export const PointerPacketSchema = /*@__PURE__*/
+  messageDesc(file_toothpacket, 13);
+
+/**
+ * Describes the enum toothpaste.TypingProfile.
+ */
+export const TypingProfileSchema = /*@__PURE__*/
+  enumDesc(file_toothpacket, 0);
+
+/**
+ * Keystroke pacing for typed text and keycodes
+ *
+ * @generated from enum toothpaste.TypingProfile
+ */
+export const TypingProfile = /*@__PURE__*/
+  tsEnum(TypingProfileSchema);
+
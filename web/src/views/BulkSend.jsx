@@ -2,7 +2,7 @@ import React, { useState, useContext, useRef, useEffect, useCallback } from 'rea
 import { Button, Typography, Tabs } from "@material-tailwind/react";
 import { Textarea } from "@material-tailwind/react";
 import { BLEContext } from '../context/BLEContext';
-import { HomeIcon, PaperAirplaneIcon, ClipboardIcon, InformationCircleIcon, SparklesIcon, LockClosedIcon } from "@heroicons/react/24/outline";
+import { HomeIcon, PaperAirplaneIcon, ClipboardIcon, InformationCircleIcon, SparklesIcon, LockClosedIcon, StopIcon } from "@heroicons/react/24/outline";
 import { keyboardHandler } from '../services/inputHandlers/keyboardHandler';
 import DuckyscriptEditor from '../components/duckyscript/DuckyscriptEditor';
 import { parseDuckyscript, executeDuckyscript } from '../services/duckyscript/DuckyscriptParser';
@@ -13,7 +13,7 @@ import { DuckyscriptContext } from '../context/DuckyscriptContext';
 export default function BulkSend() {
     const [input, setInput] = useState('');
     const [selectedScript, setSelectedScript] = useState(null);
-    const { status, sendEncrypted } = useContext(BLEContext);
+    const { status, sendEncrypted, cancelBulk } = useContext(BLEContext);
     const { isUnlocked, scripts } = useContext(DuckyscriptContext);
     const editorRef = useRef(null);
 
@@ -146,6 +146,13 @@ export default function BulkSend() {
                             <ClipboardIcon className="h-7 w-7 mr-4" />
                             <Typography type="h5" className="text-text font-header normal-case font-semibold">Paste to Device</Typography>
                         </Button>
+                        <Button
+                            onClick={cancelBulk}
+                            disabled={status !== 1}
+                            className='bg-ash border-secondary disabled:bg-ash disabled:border-secondary text-text flex items-center justify-center size-lg '>
+                            <StopIcon className="h-7 w-7 mr-4" />
+                            <Typography type="h5" className="text-text font-header normal-case font-semibold">Stop Typing</Typography>
+                        </Button>
                     </Tabs.Panel>
 
                     <Tabs.Panel value="duckyscript" className="flex flex-col flex-1 gap-4 relative">
@@ -31,12 +31,13 @@ export default function LiveCapture() {
 
     const [macMode, setMacMode] = useState(false); // Does WIN key send WIN or COMMAND key
     const [jiggling, setJiggling] = useState(false);
+    const [tabletMode, setTabletMode] = useState(false); // Surface position places the remote cursor at the same spot
     const [isFocused, setIsFocused] = useState(false); // Track if input is focused
     const [isAutofillFocused, setIsAutofillFocused] = useState(false); // Track if autofill input is focused
     const mobileInputRef = useRef(null); // Ref for mobile input
 
     // Contexts
-    const { status, sendEncrypted } = useContext(BLEContext);
+    const { status, sendEncrypted, absolutePointer } = useContext(BLEContext);
 
     // Mouse Vars
     const mouseStartPos = useRef(null);
@@ -55,6 +56,12 @@ export default function LiveCapture() {
 
 
     const displacementList = useRef([]);
+    const pendingPointer = useRef(null); // Tablet mode: latest {x, y} surface fraction not sent yet
+
+    // Re-home the relative fallback each time tablet mode starts: the cursor has moved since
+    useEffect(() => {
+        if (tabletMode) mouseHandler.resetPointerPosition();
+    }, [tabletMode]);
 
     // Mouse polling logic - wrapped in useEffect to prevent memory leaks in React 19
     useEffect(() => {
@@ -64,10 +71,13 @@ export default function LiveCapture() {
                 //sendMouseReport(tDisplacement.current.x, tDisplacement.current.y, false, false);
                 sendMouseReport(false, false);
             }
+            if (pendingPointer.current) {
+                sendPointer();
+            }
         }, REPORT_INTERVAL_MS);
 
         return () => clearInterval(intervalId);
-    }, [captureMouse, sendMouseReport]);
+    }, [captureMouse, sendMouseReport, sendPointer]);
 
     // On click logic
     function onMouseDown(e) {
@@ -76,6 +86,7 @@ export default function LiveCapture() {
         isMouseTracking.current = true;
 
         if (captureMouse) {
+            if (pendingPointer.current) sendPointer(); // Click where the pointer is now, not where it was
             if (e.button == 0) mouseHandler.sendMouseClick(1, 0, sendEncrypted); // Send left click
             if (e.button == 2) {
                 e.preventDefault();
@@ -111,6 +122,12 @@ export default function LiveCapture() {
             return;
         }
 
+        if (tabletMode) {
+            pendingPointer.current = surfaceFraction(rect, e.clientX, e.clientY);
+            isMouseTracking.current = false; // Relative tracking restarts cleanly when tablet mode ends
+            return;
+        }
+
         // If not tracking yet, start tracking
         if (!isMouseTracking.current) {
             mouseStartPos.current = { x: e.clientX, y: e.clientY };
@@ -180,6 +197,11 @@ export default function LiveCapture() {
         e.preventDefault();
 
         const touch = e.touches[0];
+        if (tabletMode) {
+            pendingPointer.current = surfaceFraction(e.currentTarget.getBoundingClientRect(), touch.clientX, touch.clientY);
+            return;
+        }
+
         const displacementX = touch.clientX - touchStartPos.current.x;
         const displacementY = touch.clientY - touchStartPos.current.y;
 
@@ -202,6 +224,18 @@ export default function LiveCapture() {
         displacementList.current = []; // reset list
     }
 
+    // Where a point sits on the capture surface, as fractions of its width and height
+    function surfaceFraction(rect, clientX, clientY) {
+        return { x: (clientX - rect.left) / rect.width, y: (clientY - rect.top) / rect.height };
+    }
+
+    // Tablet mode: place the remote cursor at the latest surface position
+    function sendPointer(LClick = 0, RClick = 0) {
+        const { x, y } = pendingPointer.current;
+        pendingPointer.current = null;
+        mouseHandler.sendPointerPosition(x, y, LClick, RClick, sendEncrypted, absolutePointer);
+    }
+
     // Helper function to send keyboard shortcuts
     function sendKeyboardShortcut(keySequence) {
         keyboardHandler.sendKeyboardShortcut(keySequence, sendEncrypted);
@@ -311,6 +345,8 @@ export default function LiveCapture() {
                 setCommandPassthrough={setCommandPassthrough}
                 jiggling={jiggling}
                 setJiggling={setJiggling}
+                tabletMode={tabletMode}
+                setTabletMode={setTabletMode}
                 isFocused={isFocused}
                 setIsFocused={setIsFocused}
                 status={status}
@@ -328,6 +364,7 @@ export default function LiveCapture() {
             {/* Mobile Touchpad Layout - Visible only on small screens */}
             <Touchpad
                 captureMouse={captureMouse}
+                tabletMode={tabletMode}
                 commandPassthrough={commandPassthrough}
                 onTouchStart={onTouchStart}
                 onTouchMove={onTouchMove}
@@ -343,6 +380,8 @@ export default function LiveCapture() {
                     setCommandPassthrough={setCommandPassthrough}
                     jiggling={jiggling}
                     setJiggling={setJiggling}
+                    tabletMode={tabletMode}
+                    setTabletMode={setTabletMode}
                     status={status}
                     sendEncrypted={sendEncrypted}
                     sendKeyboardShortcut={sendKeyboardShortcut}